@@ -0,0 +1,80 @@
+#pragma once
+
+/*
+ * this file implements command line parsing helpers shared by the benchmark
+ * and regression executables (see 'rt_bench.cpp', 'rt_regress.cpp',
+ * 'rt_scaling.cpp' and 'rt_microbench.cpp').
+ **/
+
+/// c++ includes
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "common/include/logging.h"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// this function is called to split a comma separated list. empty
+        /// items are dropped.
+        inline std::vector<std::string> split_list(char const* list)
+        {
+                std::vector<std::string> items;
+                std::stringstream ss(list);
+
+                for (std::string item; std::getline(ss, item, ',');) {
+                        if (!item.empty()) {
+                                items.push_back(item);
+                        }
+                }
+
+                return items;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to parse a number, no smaller than
+        /// 'min_value'
+        inline std::optional<uint32_t> parse_count(std::string const& str, uint32_t min_value = 1)
+        {
+                char* end_ptr    = nullptr;
+                auto const value = strtoull(str.c_str(), &end_ptr, 10);
+
+                if (str.empty() || (*end_ptr != '\0') || (value < min_value) || (value > UINT32_MAX)) {
+                        return std::nullopt;
+                }
+
+                return value;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to parse a comma separated list of numbers,
+        /// each within [min_value .. max_value]
+        inline std::optional<std::vector<uint32_t>> parse_count_list(char const* list, uint32_t min_value,
+                                                                     uint32_t max_value)
+        {
+                std::vector<uint32_t> counts;
+
+                for (auto const& item : split_list(list)) {
+                        auto const count = parse_count(item, min_value);
+                        if (!count || (count.value() > max_value)) {
+                                LOG_ERROR("invalid count: '%s'", item.c_str());
+                                return std::nullopt;
+                        }
+
+                        counts.push_back(count.value());
+                }
+
+                if (counts.empty()) {
+                        LOG_ERROR("empty list: '%s'", list);
+                        return std::nullopt;
+                }
+
+                return counts;
+        }
+
+} // namespace raytracer
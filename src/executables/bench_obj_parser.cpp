@@ -0,0 +1,127 @@
+/*
+ * this program benchmarks parsing of OBJ files, and reports the throughput
+ * (in MB/s) of the serial and the parallel parser.
+ *
+ * by default, all OBJ files from the assets directory are parsed. specific
+ * files can be benchmarked by passing them on the command line.
+ **/
+
+/// c++ includes
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "common/include/benchmark.hpp"
+#include "common/include/logging.h"
+#include "io/obj_file_loader.hpp"
+#include "io/obj_parse_result.hpp"
+#include "utils/constants.hpp"
+#include "utils/utils.hpp"
+
+/*
+ * select default logging level depending on type of build. this can be changed
+ * later to more appropriate values.
+ **/
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+
+/// convenience mostly
+namespace RT = raytracer;
+namespace fs = std::filesystem;
+
+/// file specific functions
+static std::vector<std::string> obj_files_to_benchmark(int argc, char** argv);
+static void benchmark_obj_file(std::string const& obj_fname);
+
+int main(int argc, char** argv)
+{
+        auto const obj_files = obj_files_to_benchmark(argc, argv);
+
+        if (obj_files.empty()) {
+                LOG_ERROR("no OBJ files to benchmark");
+                return 1;
+        }
+
+        for (auto const& fname : obj_files) {
+                benchmark_obj_file(fname);
+        }
+
+        return 0;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return the list of OBJ files to benchmark,
+/// either from the command line, or all of them from the assets directory.
+static std::vector<std::string> obj_files_to_benchmark(int argc, char** argv)
+{
+        std::vector<std::string> obj_files;
+
+        if (argc > 1) {
+                obj_files.assign(argv + 1, argv + argc);
+                return obj_files;
+        }
+
+        std::error_code ec;
+        for (auto const& entry : fs::directory_iterator(RT::OBJ_ROOT, ec)) {
+                if (entry.is_regular_file() && (entry.path().extension() == ".obj")) {
+                        obj_files.push_back(entry.path().string());
+                }
+        }
+
+        std::sort(obj_files.begin(), obj_files.end());
+
+        return obj_files;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to benchmark parsing of a single OBJ file with the
+/// serial parser, and the parallel parser with one and all cores.
+static void benchmark_obj_file(std::string const& obj_fname)
+{
+        constexpr uint32_t NUM_ITERATIONS = 5;
+        constexpr uint32_t THROW_AWAY     = 1;
+
+        std::error_code ec;
+        auto const file_size = fs::file_size(obj_fname, ec);
+        if (ec) {
+                LOG_ERROR("failed to stat '%s', error: '%s'", obj_fname.c_str(), ec.message().c_str());
+                return;
+        }
+
+        RT::obj_file_parser parser(obj_fname);
+
+        auto report = [&](char const* how, auto const& bm, RT::obj_parse_result const& result) {
+                /// ------------------------------------------------------------
+                /// bytes per usec is the same as MB/s (with 1MB == 10^6 bytes)
+                auto const mean_usec = std::max<double>(1.0, bm.mean());
+                auto const mb_per_s  = static_cast<double>(file_size) / mean_usec;
+
+                LOG_INFO("'%s' (%s): {bytes: %zu, mean (us): %.0f, throughput (MB/s): %.2f, "
+                         "summary: '%s'}",
+                         obj_fname.c_str(), how, static_cast<size_t>(file_size), mean_usec, mb_per_s,
+                         result.summarize().c_str());
+        };
+
+        {
+                benchmark_t<std::chrono::microseconds> bm("serial", NUM_ITERATIONS, THROW_AWAY);
+                auto const result = bm.benchmark([&]() { return parser.parse(); });
+                report("serial", bm, result);
+        }
+
+        {
+                benchmark_t<std::chrono::microseconds> bm("parallel-1", NUM_ITERATIONS, THROW_AWAY);
+                auto const result = bm.benchmark([&]() { return parser.parse_parallel(1); });
+                report("parallel, 1 thread", bm, result);
+        }
+
+        {
+                auto const num_threads = RT::max_cores();
+
+                benchmark_t<std::chrono::microseconds> bm("parallel-N", NUM_ITERATIONS, THROW_AWAY);
+                auto const result = bm.benchmark([&]() { return parser.parse_parallel(num_threads); });
+                report("parallel, all cores", bm, result);
+        }
+}
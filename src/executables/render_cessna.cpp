@@ -13,7 +13,7 @@
 #include "common/include/logging.h"
 #include "io/camera.hpp"
 #include "io/canvas.hpp"
-#include "io/obj_file_loader.hpp"
+#include "io/obj_mesh_cache.hpp"
 #include "io/obj_parse_result.hpp"
 #include "io/world.hpp"
 #include "patterns/gradient_perlin_noise_pattern.hpp"
@@ -24,16 +24,19 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/group.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -43,6 +46,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 static RT::world create_world();
 static RT::camera create_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -61,6 +65,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /// ---------------------------------------------------------------------------
 /// this function is called to create a world which is then rendered using
@@ -121,8 +126,7 @@ static RT::world create_world()
         /// ------------------------------------------------------------
         /// cessna - 1
         {
-                RT::obj_file_parser teapot_parser(RT::OBJ_ROOT + std::string("cessna.obj"));
-                auto parse_result = teapot_parser.parse();
+                auto parse_result = RT::load_obj_file_cached(RT::OBJ_ROOT + std::string("cessna.obj"));
 
                 LOG_INFO("cessna-01 parsed, summary:'%s'", parse_result.summarize().c_str());
 
@@ -173,3 +177,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("cessna", create_world, create_camera, true);
@@ -19,14 +19,17 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cube.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -36,6 +39,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 static RT::world create_world();
 static RT::camera create_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -54,6 +58,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -214,3 +219,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("checkered_cubes", create_world, create_camera, true);
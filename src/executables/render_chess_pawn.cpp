@@ -25,16 +25,19 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/group.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -44,6 +47,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 static RT::world create_world();
 static RT::camera create_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -62,6 +66,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /// ---------------------------------------------------------------------------
 /// this function is called to create a world which is then rendered using
@@ -157,7 +162,7 @@ static RT::world create_world()
         /// chess-pawn
         {
                 RT::obj_file_parser chess_pawn_parser(RT::OBJ_ROOT + std::string("chess-pawn.obj"));
-                auto chess_pawn_parse_result = chess_pawn_parser.parse();
+                auto chess_pawn_parse_result = chess_pawn_parser.parse_parallel();
 
                 LOG_INFO("chess-pawn parsed, summary:'%s'", chess_pawn_parse_result.summarize().c_str());
 
@@ -214,3 +219,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("chess_pawn", create_world, create_camera, true);
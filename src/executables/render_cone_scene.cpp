@@ -20,16 +20,19 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cone.hpp"
 #include "shapes/cylinder.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -39,6 +42,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 RT::world create_cone_world();
 RT::camera create_cone_world_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_cone_world();
@@ -57,6 +61,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -178,3 +183,7 @@ RT::camera create_cone_world_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("cone_scene", create_cone_world, create_cone_world_camera, true);
@@ -28,6 +28,7 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/csg.hpp"
 #include "shapes/cube.hpp"
 #include "shapes/group.hpp"
@@ -36,11 +37,13 @@
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -54,6 +57,7 @@ static std::shared_ptr<RT::shape_interface> create_a_dice(RT::material const& di
 
 static std::vector<std::shared_ptr<RT::shape_interface>> create_dices(uint32_t num_dices);
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -72,6 +76,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /// ----------------------------------------------------------------------------
 /// create dice-body. a dice is a cube whose corners are 'cut' by a slightly
@@ -219,6 +224,10 @@ static std::shared_ptr<RT::shape_interface> create_a_dice(RT::material const& di
         return db;
 }
 
+/// ----------------------------------------------------------------------------
+/// seed of the random placement, orientation etc. of dices
+static constexpr uint32_t DICE_RANDOM_SEED = 42;
+
 /// ----------------------------------------------------------------------------
 /// create a bunch of dices with random colors for body and pip, randomly placed
 /// and oriented etc. etc.
@@ -226,10 +235,11 @@ static std::vector<std::shared_ptr<RT::shape_interface>> create_dices(uint32_t n
 {
         std::vector<std::shared_ptr<RT::shape_interface>> dices;
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        /// --------------------------------------------------------------------
+        /// same dices every time, so that renders are reproducible
+        std::mt19937 gen(DICE_RANDOM_SEED);
 
-        std::uniform_int_distribution<> rnd_color_range(0, RT::color_pallette.size());
+        std::uniform_int_distribution<> rnd_color_range(0, RT::color_pallette.size() - 1);
         std::uniform_real_distribution<> rnd_scale_range(0.01, 0.8);
         std::uniform_real_distribution<> rnd_rotx_range(-RT::PI, RT::PI);
 
@@ -321,3 +331,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("csg_dice", create_world, create_camera, true);
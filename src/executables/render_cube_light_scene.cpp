@@ -17,6 +17,7 @@
 #include "patterns/gradient_perlin_noise_pattern.hpp"
 #include "patterns/material.hpp"
 #include "patterns/texture_2d_pattern.hpp"
+#include "patterns/texture_image.hpp"
 #include "patterns/uv_image_pattern.hpp"
 #include "patterns/uv_mapper.hpp"
 #include "primitives/color.hpp"
@@ -160,12 +161,11 @@ RT::world create_simple_world()
         /// --------------------------------------------------------------------
         /// load the starry texture for wall and floor
         {
-                auto maybe_star_map_canvas =
-                        RT::canvas::load_from_file(RT::TEXTURE_ROOT + std::string("stars-8k.ppm"));
-                ASSERT(maybe_star_map_canvas.has_value());
+                auto star_map_image =
+                        RT::texture_image::load(RT::TEXTURE_ROOT + std::string("stars-8k.ppm"));
+                ASSERT(star_map_image != nullptr);
 
-                auto star_map_canvas  = maybe_star_map_canvas.value();
-                auto star_map_texture = std::make_shared<RT::uv_image>(star_map_canvas);
+                auto star_map_texture = std::make_shared<RT::uv_image>(star_map_image);
 
                 auto star_map_pattern =
                         std::make_shared<RT::texture_2d_pattern>(star_map_texture, RT::planar_map);
@@ -22,6 +22,7 @@
 #include "patterns/solid_pattern.hpp"
 #include "patterns/striped_pattern.hpp"
 #include "patterns/texture_2d_pattern.hpp"
+#include "patterns/texture_image.hpp"
 #include "patterns/uv_image_pattern.hpp"
 #include "patterns/uv_mapper.hpp"
 #include "primitives/color.hpp"
@@ -29,16 +30,19 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cube.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -54,6 +58,7 @@ RT::camera create_earth_world_camera();
 RT::world create_simple_world();
 RT::camera create_simple_world_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_simple_world();
@@ -72,6 +77,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -295,13 +301,11 @@ RT::world create_earth_world()
         {
                 world.add(earth_sphere);
 
-                auto maybe_earth_map_canvas =
-                        RT::canvas::load_from_file(RT::TEXTURE_ROOT + std::string("nasa-blue-marble.ppm"));
+                auto earth_map_image =
+                        RT::texture_image::load(RT::TEXTURE_ROOT + std::string("nasa-blue-marble.ppm"));
+                ASSERT(earth_map_image != nullptr);
 
-                ASSERT(maybe_earth_map_canvas.has_value());
-
-                auto earth_map_canvas = maybe_earth_map_canvas.value();
-                auto earth_texture    = std::make_shared<RT::uv_image>(earth_map_canvas);
+                auto earth_texture = std::make_shared<RT::uv_image>(earth_map_image);
                 auto earth_pattern =
                         std::make_shared<RT::texture_2d_pattern>(earth_texture, RT::spherical_map);
 
@@ -410,12 +414,11 @@ RT::world create_simple_world()
         {
                 world.add(earth_sphere);
 
-                auto maybe_earth_map_canvas =
-                        RT::canvas::load_from_file(RT::TEXTURE_ROOT + std::string("nasa-blue-marble.ppm"));
-                ASSERT(maybe_earth_map_canvas.has_value());
+                auto earth_map_image =
+                        RT::texture_image::load(RT::TEXTURE_ROOT + std::string("nasa-blue-marble.ppm"));
+                ASSERT(earth_map_image != nullptr);
 
-                auto earth_map_canvas = maybe_earth_map_canvas.value();
-                auto earth_texture    = std::make_shared<RT::uv_image>(earth_map_canvas);
+                auto earth_texture = std::make_shared<RT::uv_image>(earth_map_image);
                 auto earth_pattern =
                         std::make_shared<RT::texture_2d_pattern>(earth_texture, RT::spherical_map);
 
@@ -505,12 +508,11 @@ RT::world create_simple_world()
         /// --------------------------------------------------------------------
         /// load the starry texture for wall and floor
         {
-                auto maybe_star_map_canvas =
-                        RT::canvas::load_from_file(RT::TEXTURE_ROOT + std::string("stars-8k.ppm"));
-                ASSERT(maybe_star_map_canvas.has_value());
+                auto star_map_image =
+                        RT::texture_image::load(RT::TEXTURE_ROOT + std::string("stars-8k.ppm"));
+                ASSERT(star_map_image != nullptr);
 
-                auto star_map_canvas  = maybe_star_map_canvas.value();
-                auto star_map_texture = std::make_shared<RT::uv_image>(star_map_canvas);
+                auto star_map_texture = std::make_shared<RT::uv_image>(star_map_image);
 
                 auto star_map_pattern =
                         std::make_shared<RT::texture_2d_pattern>(star_map_texture, RT::planar_map);
@@ -555,3 +557,7 @@ RT::camera create_simple_world_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("cube_scene", create_simple_world, create_simple_world_camera, true);
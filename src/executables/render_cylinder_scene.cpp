@@ -23,17 +23,20 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cube.hpp"
 #include "shapes/cylinder.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -46,6 +49,7 @@ RT::camera create_table_top_world_camera();
 RT::world create_cylinder_world();
 RT::camera create_cylinder_world_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_cylinder_world();
@@ -64,6 +68,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -359,3 +364,7 @@ RT::camera create_cylinder_world_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("cylinder_scene", create_cylinder_world, create_cylinder_world_camera, true);
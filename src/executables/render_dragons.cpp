@@ -17,7 +17,7 @@
 #include "common/include/logging.h"
 #include "io/camera.hpp"
 #include "io/canvas.hpp"
-#include "io/obj_file_loader.hpp"
+#include "io/obj_mesh_cache.hpp"
 #include "io/obj_parse_result.hpp"
 #include "io/render_params.hpp"
 #include "io/world.hpp"
@@ -29,16 +29,19 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/group.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -48,6 +51,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 static RT::world create_world();
 static RT::camera create_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -66,11 +70,14 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 static RT::obj_parse_result parse_dragon_obj_file(void)
 {
-        RT::obj_file_parser dragon_obj_parser(RT::OBJ_ROOT + std::string("dragon.obj"));
-        auto dragon_parse_result = dragon_obj_parser.parse();
+        /// ------------------------------------------------------------
+        /// dragon is divided with a '100' threshold, and the resulting
+        /// hierarchy is cached alongside the obj file.
+        auto dragon_parse_result = RT::load_obj_file_cached(RT::OBJ_ROOT + std::string("dragon.obj"), 100);
 
         LOG_INFO("dragon parsed. summary:'%s'", dragon_parse_result.summarize().c_str());
 
@@ -81,10 +88,6 @@ static RT::obj_parse_result parse_dragon_obj_file(void)
                 dragon->set_cast_shadow(true);
                 dragon->transform(RT_XFORM::create_3d_translation_matrix(0.0, 0.1217, 0.0) *
                                   RT_XFORM::create_3d_scaling_matrix(0.268, 0.268, 0.268));
-
-                /// ----------------------------------------------------
-                /// let's divide the group with a '200' threshold.
-                dragon->divide(100);
         }
 
         LOG_INFO("dragon loaded.");
@@ -436,3 +439,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("dragons", create_world, create_camera, false);
@@ -22,17 +22,20 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cylinder.hpp"
 #include "shapes/group.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -48,6 +51,7 @@ static std::shared_ptr<RT::cylinder> create_hexagon_edge();
 static std::shared_ptr<RT::group> create_hexagon_side();
 static std::shared_ptr<RT::group> create_hexagon();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -66,6 +70,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /// ----------------------------------------------------------------------------
 /// this function is called to create a hexagon corner
@@ -287,3 +292,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("hexagon_scene", create_world, create_camera, true);
@@ -19,6 +19,7 @@
 #include "patterns/material.hpp"
 #include "patterns/perlin_noise_pattern.hpp"
 #include "patterns/texture_2d_pattern.hpp"
+#include "patterns/texture_image.hpp"
 #include "patterns/uv_image_pattern.hpp"
 #include "patterns/uv_mapper.hpp"
 #include "primitives/color.hpp"
@@ -26,15 +27,18 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -44,6 +48,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 static RT::world create_world();
 static RT::camera create_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -62,6 +67,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -96,13 +102,12 @@ static RT::world create_world()
                 auto const texture_fname = RT::TEXTURE_ROOT + std::string("earth-8k-daymap.ppm");
                 LOG_INFO("begin texturizing '%s'", texture_fname.c_str());
 
-                auto maybe_earth_map_canvas = RT::canvas::load_from_file(texture_fname);
-                ASSERT(maybe_earth_map_canvas.has_value());
-                auto earth_map_canvas = maybe_earth_map_canvas.value();
+                auto earth_map_image = RT::texture_image::load(texture_fname);
+                ASSERT(earth_map_image != nullptr);
 
                 LOG_INFO("end texturizing '%s'", texture_fname.c_str());
 
-                auto sp_01_earth_texture = std::make_shared<RT::uv_image>(earth_map_canvas);
+                auto sp_01_earth_texture = std::make_shared<RT::uv_image>(earth_map_image);
                 auto sp_01_earth_pattern =
                         std::make_shared<RT::texture_2d_pattern>(sp_01_earth_texture, RT::spherical_map);
 
@@ -195,3 +200,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("nasa_blue_earth", create_world, create_camera, true);
@@ -16,20 +16,24 @@
 #include "io/world.hpp"
 #include "patterns/cube_map_texture.hpp"
 #include "patterns/material.hpp"
+#include "patterns/texture_image.hpp"
 #include "patterns/uv_image_pattern.hpp"
 #include "primitives/color.hpp"
 #include "primitives/matrix.hpp"
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cube.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -39,6 +43,7 @@ using RT_XFORM = RT::matrix_transformations_t;
 static RT::world create_world();
 static RT::camera create_camera();
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_world();
@@ -57,6 +62,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -82,11 +88,10 @@ static RT::world create_world()
         auto const textureize = [](std::string const& fname) -> std::shared_ptr<RT::uv_image> {
                 LOG_INFO("texturizing '%s'", fname.c_str());
 
-                auto canvas_maybe = RT::canvas::load_from_file(fname);
-                ASSERT(canvas_maybe.has_value());
+                auto texture = RT::texture_image::load(fname);
+                ASSERT(texture != nullptr);
 
-                auto canvas_value   = canvas_maybe.value();
-                auto canvas_texture = std::make_shared<RT::uv_image>(canvas_value);
+                auto canvas_texture = std::make_shared<RT::uv_image>(texture);
 
                 return canvas_texture;
         };
@@ -139,3 +144,7 @@ static RT::camera create_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("skybox", create_world, create_camera, true);
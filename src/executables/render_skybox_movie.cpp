@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 
 /// system includes
 #include <string.h>
@@ -19,11 +20,13 @@
 #include "common/include/logging.h"
 #include "io/camera.hpp"
 #include "io/canvas.hpp"
+#include "io/canvas_writer.hpp"
 #include "io/world.hpp"
 #include "patterns/checkers_pattern.hpp"
 #include "patterns/cube_map_texture.hpp"
 #include "patterns/material.hpp"
 #include "patterns/striped_pattern.hpp"
+#include "patterns/texture_image.hpp"
 #include "patterns/uv_image_pattern.hpp"
 #include "primitives/color.hpp"
 #include "primitives/matrix.hpp"
@@ -114,11 +117,10 @@ int main(int argc, char** argv)
                 auto const textureize = [](std::string const& fname) -> std::shared_ptr<RT::uv_image> {
                         LOG_INFO("texturizing '%s'", fname.c_str());
 
-                        auto canvas_maybe = RT::canvas::load_from_file(fname);
-                        ASSERT(canvas_maybe.has_value());
+                        auto texture = RT::texture_image::load(fname);
+                        ASSERT(texture != nullptr);
 
-                        auto canvas_value   = canvas_maybe.value();
-                        auto canvas_texture = std::make_shared<RT::uv_image>(canvas_value);
+                        auto canvas_texture = std::make_shared<RT::uv_image>(texture);
 
                         return canvas_texture;
                 };
@@ -169,6 +171,11 @@ int main(int argc, char** argv)
         constexpr float rot_xy_step   = (2 * RT::PI) / (1.0f * max_images);
         auto movie_image_fname        = "/tmp/skybox-image-";
 
+        /// --------------------------------------------------------------------
+        /// rendered frames are written out in the background, while the next
+        /// one is being rendered.
+        RT::canvas_writer frame_writer;
+
         /// --------------------------------------------------------------------
         /// step-1: render a bunch of images
         for (uint32_t i = 0; i < max_images; i++) {
@@ -179,9 +186,9 @@ int main(int argc, char** argv)
 
                 /// --------------------------------------------------------------------
                 /// ok camera, render the scene
-                auto render_params         = RT::config_render_params().antialias(true);
-                auto const rendered_canvas = camera.render(world, render_params);
-                rendered_canvas.write(dst_fname);
+                auto render_params   = RT::config_render_params().antialias(true);
+                auto rendered_canvas = camera.render(world, render_params);
+                frame_writer.submit(std::move(rendered_canvas), dst_fname);
 
                 /// --------------------------------------------------------------------
                 /// show what we got
@@ -195,6 +202,10 @@ int main(int argc, char** argv)
                                        RT_XFORM::create_roty_matrix(0.0 - i * rot_xy_step));
         }
 
+        /// --------------------------------------------------------------------
+        /// all frames must be on disk before the movie can be created
+        frame_writer.flush();
+
         /// --------------------------------------------------------------------
         /// step-2: create a movie from the set of images rendered in step-1
         {
@@ -6,7 +6,6 @@
 #include <limits>
 #include <memory>
 #include <random>
-#include <time.h>
 
 #include "common/include/logging.h"
 #include "io/camera.hpp"
@@ -29,16 +28,19 @@
 #include "primitives/matrix_transformations.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
+#include "scene_catalogue.hpp"
 #include "shapes/cylinder.hpp"
 #include "shapes/plane.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
+#if !defined(RT_SCENE_CATALOGUE)
 /*
  * select default logging level depending on type of build. this can be changed
  * later to more appropriate values.
  **/
 log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+#endif
 
 /// convenience mostly
 namespace RT   = raytracer;
@@ -49,11 +51,13 @@ RT::world create_shapes_world();
 RT::camera create_shapes_world_camera();
 
 /// ----------------------------------------------------------------------------
-/// setup global random number generation primitives
-static std::mt19937 rnd_gen(time(nullptr));
+/// setup global random number generation primitives. seeded the same every
+/// time, so that renders are reproducible.
+static std::mt19937 rnd_gen(42);
 static std::uniform_int_distribution<unsigned> distrib(std::numeric_limits<unsigned>::min(),
                                                        std::numeric_limits<unsigned>::max());
 
+#if !defined(RT_SCENE_CATALOGUE)
 int main(int argc, char** argv)
 {
         auto world     = create_shapes_world();
@@ -72,6 +76,7 @@ int main(int argc, char** argv)
 
         return 0;
 }
+#endif
 
 /*
  * only file specific functions from this point onwards
@@ -425,3 +430,7 @@ RT::camera create_shapes_world_camera()
 
         return camera_01;
 }
+
+/// ----------------------------------------------------------------------------
+/// add the scene to the catalogue benchmarked by 'rt_bench'
+RT_CATALOGUE_SCENE("spheres_with_decorations", create_shapes_world, create_shapes_world_camera, true);
@@ -11,11 +11,10 @@
 #include "io/camera.hpp"
 #include "io/canvas.hpp"
 #include "io/world.hpp"
-#include "patterns/blended_pattern.hpp"
 #include "patterns/gradient_perlin_noise_pattern.hpp"
 #include "patterns/gradient_ring_pattern.hpp"
 #include "patterns/material.hpp"
-#include "patterns/striped_pattern.hpp"
+#include "patterns/pattern_expression.hpp"
 #include "patterns/texture_2d_pattern.hpp"
 #include "patterns/uv_checkers.hpp"
 #include "patterns/uv_mapper.hpp"
@@ -72,19 +71,19 @@ int main(int argc, char** argv)
 static RT::world create_world()
 {
         /// --------------------------------------------------------------------
-        /// create the floor with a blended pattern
+        /// create the floor with a blended pattern, composed at compile time
         auto floor = std::make_shared<RT::plane>();
         {
-                auto fp_01 = std::make_shared<RT::striped_pattern>(RT::color(0.9, 0.9, 0.9), /// pattern-1
-                                                                   RT::color(0.8, 0.8, 0.8));
+                auto const fp_01 = RT::create_transformed_expr(
+                        RT::create_striped_expr(RT::color(0.9, 0.9, 0.9), /// pattern-1
+                                                RT::color(0.8, 0.8, 0.8)),
+                        RT_XFORM::create_roty_matrix(RT::PI_BY_2F) *
+                                RT_XFORM::create_3d_scaling_matrix(0.5, 0.5, 5.5));
 
-                fp_01->transform(RT_XFORM::create_roty_matrix(RT::PI_BY_2F) *
-                                 RT_XFORM::create_3d_scaling_matrix(0.5, 0.5, 5.5));
+                auto const fp_02 = RT::create_striped_expr(RT::color(0.8, 0.8, 0.8), /// pattern-2
+                                                           RT::color(0.7, 0.7, 0.7));
 
-                auto fp_02 = std::make_shared<RT::striped_pattern>(RT::color(0.8, 0.8, 0.8), /// pattern-2
-                                                                   RT::color(0.7, 0.7, 0.7));
-
-                auto floor_pattern_01 = std::make_shared<RT::blended_pattern>(fp_01, fp_02);
+                auto floor_pattern_01 = RT::create_pattern(RT::create_blended_expr(fp_01, fp_02));
 
                 floor_pattern_01->transform(RT_XFORM::create_roty_matrix(-RT::PI_BY_2F) *
                                             RT_XFORM::create_3d_scaling_matrix(0.6, 1.0, 1.0));
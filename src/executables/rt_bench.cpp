@@ -0,0 +1,653 @@
+/*
+ * this program benchmarks rendering of a fixed catalogue of scenes (the ones
+ * rendered by the render_* executables, see 'scene_catalogue.hpp'), and
+ * reports the results in a machine-readable format, so that throughput can be
+ * tracked over time, and across builds.
+ *
+ * every selected scene is rendered at each of the requested resolutions, with
+ * each of the requested number of threads. for every such configuration, the
+ * following are reported:
+ *
+ *     - wall time (ms) of a render: mean, min, p50, p90, p99 and max
+ *     - pixels/sec and rays/sec
+ *     - rays cast (by kind), and intersection tests performed per render
+ *     - peak resident set size of the process while rendering
+ *
+ * usage: rt_bench [options]
+ *
+ *     --list                       list the catalogued scenes and exit
+ *     --scenes     <name,...>      scenes to render (default: all)
+ *     --resolution <WxH,...>       resolutions to render at (default: 640x360)
+ *     --threads    <N,...>         rendering threads (default: all cores)
+ *     --iterations <N>             measured renders (default: 3)
+ *     --warmup     <N>             discarded renders (default: 1)
+ *     --antialias  <scene|on|off>  antialiasing (default: as the scene does)
+ *     --format     <json|csv>      output format (default: json)
+ *     --output     <fname>         output file (default: stdout)
+ *     --heatmaps   <dir>           write images, and per-pixel cost heatmaps of
+ *                                  each configuration to 'dir'
+ *     --trace-pixel <X,Y>          write the ray-tree of pixel (X, Y) of each
+ *                                  configuration, to the heatmaps 'dir' when
+ *                                  given, and the current directory otherwise
+ *     --perf-counters              report hardware events of each phase of
+ *                                  rendering (json only)
+ *
+ * heatmaps are made from an extra render, after the measured ones, so that
+ * measuring the cost of each pixel does not skew the results. the ray-tree of
+ * the costliest pixel (see 'io/ray_tree_trace.hpp') is written along with
+ * them. for the same reason, hardware events (see 'io/render_perf_counters.hpp')
+ * are counted in an extra render of their own.
+ **/
+
+/// system includes
+#include <getopt.h>
+
+/// c++ includes
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "bench_cli.hpp"
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/render_params.hpp"
+#include "io/render_perf_counters.hpp"
+#include "io/render_stats.hpp"
+#include "io/world.hpp"
+#include "platform_utils/process_utils.hpp"
+#include "scene_catalogue.hpp"
+#include "utils/utils.hpp"
+
+/*
+ * select default logging level depending on type of build. this can be changed
+ * later to more appropriate values.
+ **/
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+
+/// convenience mostly
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// what is to be benchmarked, and how the results are reported
+struct bench_options final {
+        std::vector<std::string> scenes;
+        std::vector<std::pair<uint32_t, uint32_t>> resolutions = {{640, 360}};
+        std::vector<uint32_t> threads                          = {RT::max_cores()};
+        uint32_t iterations                                    = 3;
+        uint32_t warmup                                        = 1;
+        std::optional<bool> antialias                          = std::nullopt;
+        bool csv                                               = false;
+        std::string output_fname;
+        std::string heatmap_dir;
+        std::optional<std::pair<uint32_t, uint32_t>> trace_pixel = std::nullopt;
+        bool perf_counters                                       = false;
+        bool list_only                                           = false;
+};
+
+/// ----------------------------------------------------------------------------
+/// results of benchmarking a single configuration
+struct bench_result final {
+        std::string scene;
+        uint32_t width    = 0;
+        uint32_t height   = 0;
+        uint32_t threads  = 0;
+        bool antialias    = false;
+        uint64_t pixels   = 0; /// per render
+        uint64_t peak_rss = 0; /// bytes
+        RT::render_counters counters; /// per render
+        std::vector<double> wall_ms;
+        bool has_phase_events = false;
+};
+
+/// file specific functions
+static std::optional<bench_options> parse_options(int argc, char** argv);
+static std::vector<bench_result> benchmark_scene(RT::catalogued_scene const& scene,
+                                                 bench_options const& opts);
+static void write_heatmaps(std::string const& scene_name, RT::camera const& camera,
+                           RT::world const& the_world, RT::config_render_params render_params,
+                           std::string const& dst_dir);
+static std::string config_fname_stem(std::string const& scene_name, RT::camera const& camera,
+                                     RT::config_render_params const& render_params,
+                                     std::string const& dst_dir);
+static void write_pixel_trace(std::string const& fname, RT::camera const& camera, RT::world const& the_world,
+                              RT::config_render_params const& render_params, uint32_t x, uint32_t y);
+static std::string results_as_json(std::vector<bench_result> const& results);
+static std::string results_as_csv(std::vector<bench_result> const& results);
+
+int main(int argc, char** argv)
+{
+        auto const opts = parse_options(argc, argv);
+        if (!opts) {
+                return 1;
+        }
+
+        auto const scenes = RT::scene_catalogue::select(opts->scenes);
+        if (scenes.empty()) {
+                return 1;
+        }
+
+        if (opts->list_only) {
+                for (auto const& s : scenes) {
+                        printf("%s\n", s.name.c_str());
+                }
+
+                return 0;
+        }
+
+        std::vector<bench_result> results;
+        for (auto const& s : scenes) {
+                auto scene_results = benchmark_scene(s, opts.value());
+                results.insert(results.end(), scene_results.begin(), scene_results.end());
+        }
+
+        auto const report = opts->csv ? results_as_csv(results) : results_as_json(results);
+
+        FILE* dst_file = stdout;
+        if (!opts->output_fname.empty()) {
+                dst_file = fopen(opts->output_fname.c_str(), "w");
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", opts->output_fname.c_str(),
+                                strerror(errno));
+                        return 1;
+                }
+        }
+
+        fputs(report.c_str(), dst_file);
+
+        if (dst_file != stdout) {
+                fclose(dst_file);
+        }
+
+        return 0;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to parse the command line
+static std::optional<bench_options> parse_options(int argc, char** argv)
+{
+        static struct option const long_options[] = {
+                {"list", no_argument, nullptr, 'l'},
+                {"scenes", required_argument, nullptr, 's'},
+                {"resolution", required_argument, nullptr, 'r'},
+                {"threads", required_argument, nullptr, 't'},
+                {"iterations", required_argument, nullptr, 'i'},
+                {"warmup", required_argument, nullptr, 'w'},
+                {"antialias", required_argument, nullptr, 'a'},
+                {"format", required_argument, nullptr, 'f'},
+                {"output", required_argument, nullptr, 'o'},
+                {"heatmaps", required_argument, nullptr, 'm'},
+                {"trace-pixel", required_argument, nullptr, 'x'},
+                {"perf-counters", no_argument, nullptr, 'p'},
+                {nullptr, 0, nullptr, 0},
+        };
+
+        bench_options opts;
+
+        char const* const short_options = "ls:r:t:i:w:a:f:o:m:x:p";
+
+        for (int opt; (opt = getopt_long(argc, argv, short_options, long_options, nullptr)) != -1;) {
+                switch (opt) {
+                case 'l':
+                        opts.list_only = true;
+                        break;
+
+                case 's':
+                        opts.scenes = RT::split_list(optarg);
+                        break;
+
+                case 'r':
+                        opts.resolutions.clear();
+                        for (auto const& res : RT::split_list(optarg)) {
+                                auto const x_pos = res.find('x');
+                                if (x_pos == std::string::npos) {
+                                        LOG_ERROR("invalid resolution: '%s', expected <width>x<height>",
+                                                  res.c_str());
+                                        return std::nullopt;
+                                }
+
+                                auto const w = RT::parse_count(res.substr(0, x_pos));
+                                auto const h = RT::parse_count(res.substr(x_pos + 1));
+
+                                if (!w || !h) {
+                                        LOG_ERROR("invalid resolution: '%s', expected <width>x<height>",
+                                                  res.c_str());
+                                        return std::nullopt;
+                                }
+
+                                opts.resolutions.emplace_back(w.value(), h.value());
+                        }
+                        break;
+
+                case 't':
+                        opts.threads.clear();
+                        for (auto const& n : RT::split_list(optarg)) {
+                                auto const num_threads = RT::parse_count(n);
+
+                                if (!num_threads || (num_threads.value() > UINT8_MAX)) {
+                                        LOG_ERROR("invalid number of threads: '%s'", n.c_str());
+                                        return std::nullopt;
+                                }
+
+                                opts.threads.push_back(num_threads.value());
+                        }
+                        break;
+
+                case 'i':
+                case 'w': {
+                        /// no warmup is fine, but at least one render needs to
+                        /// be measured
+                        auto const count = RT::parse_count(optarg, (opt == 'i') ? 1 : 0);
+                        if (!count) {
+                                LOG_ERROR("invalid count: '%s'", optarg);
+                                return std::nullopt;
+                        }
+
+                        (opt == 'i' ? opts.iterations : opts.warmup) = count.value();
+                } break;
+
+                case 'a':
+                        if (strcmp(optarg, "on") == 0) {
+                                opts.antialias = true;
+                        } else if (strcmp(optarg, "off") == 0) {
+                                opts.antialias = false;
+                        } else if (strcmp(optarg, "scene") != 0) {
+                                LOG_ERROR("invalid antialias setting: '%s', expected scene|on|off", optarg);
+                                return std::nullopt;
+                        }
+                        break;
+
+                case 'f':
+                        if ((strcmp(optarg, "json") != 0) && (strcmp(optarg, "csv") != 0)) {
+                                LOG_ERROR("invalid format: '%s', expected json|csv", optarg);
+                                return std::nullopt;
+                        }
+
+                        opts.csv = (strcmp(optarg, "csv") == 0);
+                        break;
+
+                case 'o':
+                        opts.output_fname = optarg;
+                        break;
+
+                case 'm':
+                        opts.heatmap_dir = optarg;
+                        break;
+
+                case 'x': {
+                        auto const xy = RT::split_list(optarg);
+                        auto const x  = (xy.size() == 2) ? RT::parse_count(xy[0], 0) : std::nullopt;
+                        auto const y  = (xy.size() == 2) ? RT::parse_count(xy[1], 0) : std::nullopt;
+
+                        if (!x || !y) {
+                                LOG_ERROR("invalid pixel: '%s', expected <x>,<y>", optarg);
+                                return std::nullopt;
+                        }
+
+                        opts.trace_pixel = std::make_pair(x.value(), y.value());
+                } break;
+
+                case 'p':
+                        opts.perf_counters = true;
+                        break;
+
+                default:
+                        return std::nullopt;
+                }
+        }
+
+        if (opts.resolutions.empty() || opts.threads.empty()) {
+                LOG_ERROR("no resolution || threads to benchmark with");
+                return std::nullopt;
+        }
+
+        return opts;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to benchmark a single scene in all configurations.
+/// the world is created just once, and shared by all of them.
+static std::vector<bench_result> benchmark_scene(RT::catalogued_scene const& scene, bench_options const& opts)
+{
+        LOG_INFO("benchmarking scene: '%s'", scene.name.c_str());
+
+        auto const the_world    = scene.create_world();
+        auto const scene_camera = scene.create_camera();
+        auto const antialias    = opts.antialias.value_or(scene.antialias);
+
+        std::vector<bench_result> results;
+
+        for (auto const& [width, height] : opts.resolutions) {
+                /// ------------------------------------------------------------
+                /// same view as the scene's own camera, at a different
+                /// resolution
+                auto camera = RT::camera(width, height, scene_camera.field_of_view());
+                camera.transform(scene_camera.transform());
+
+                for (auto const num_threads : opts.threads) {
+                        auto const render_params =
+                                RT::config_render_params().hw_threads(num_threads).antialias(antialias);
+
+                        bench_result result;
+
+                        result.scene     = scene.name;
+                        result.width     = width;
+                        result.height    = height;
+                        result.threads   = num_threads;
+                        result.antialias = antialias;
+
+                        platform_utils::process_utils::reset_peak_rss();
+
+                        for (uint32_t i = 0; i < opts.warmup + opts.iterations; i++) {
+                                auto const start_time = std::chrono::steady_clock::now();
+                                camera.render(the_world, render_params);
+                                auto const end_time = std::chrono::steady_clock::now();
+
+                                if (i < opts.warmup) {
+                                        continue;
+                                }
+
+                                using milliseconds = std::chrono::duration<double, std::milli>;
+                                result.wall_ms.push_back(milliseconds(end_time - start_time).count());
+                        }
+
+                        auto const& stats = camera.last_render_stats();
+
+                        result.counters = stats.totals();
+                        result.pixels   = stats.pixels();
+                        result.peak_rss = platform_utils::process_utils::peak_rss_bytes();
+
+                        if (opts.perf_counters) {
+                                auto counted_params = render_params;
+                                counted_params.perf_counters(true);
+
+                                auto const [image, counted_stats] =
+                                        camera.render_with_stats(the_world, counted_params);
+
+                                result.counters.phase_events = counted_stats.totals().phase_events;
+                                result.has_phase_events      = counted_stats.has_phase_events();
+                        }
+
+                        results.push_back(result);
+
+                        if (!opts.heatmap_dir.empty()) {
+                                write_heatmaps(scene.name, camera, the_world, render_params,
+                                               opts.heatmap_dir);
+                        }
+
+                        if (opts.trace_pixel) {
+                                auto const [x, y] = opts.trace_pixel.value();
+                                auto const dir    = opts.heatmap_dir.empty() ? "." : opts.heatmap_dir;
+                                auto const stem   = config_fname_stem(scene.name, camera, render_params, dir);
+                                auto const pixel  = std::to_string(x) + "-" + std::to_string(y);
+
+                                write_pixel_trace(stem + "-pixel-" + pixel + ".json", camera, the_world,
+                                                  render_params, x, y);
+                        }
+                }
+        }
+
+        return results;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to render a configuration once more, recording the
+/// cost of each pixel, and write the image along with its heatmaps to
+/// 'dst_dir' f.e. 'dst_dir/dragons-640x360-8t.ppm', and
+/// 'dst_dir/dragons-640x360-8t-cycles.ppm' etc. the ray-tree of the costliest
+/// pixel goes to 'dst_dir/dragons-640x360-8t-costliest-pixel.json'.
+static void write_heatmaps(std::string const& scene_name, RT::camera const& camera,
+                           RT::world const& the_world, RT::config_render_params render_params,
+                           std::string const& dst_dir)
+{
+        auto const image       = camera.render(the_world, render_params.heatmap(true));
+        auto const fname_stem  = config_fname_stem(scene_name, camera, render_params, dst_dir);
+        auto const image_fname = fname_stem + ".ppm";
+
+        LOG_INFO("writing image: '%s', pixel costs: '%s'", image_fname.c_str(),
+                 camera.last_pixel_costs().stringify().c_str());
+
+        image.write(image_fname);
+        camera.last_pixel_costs().write_heatmaps(image_fname);
+
+        /// --------------------------------------------------------------------
+        /// and why the costliest pixel costs as much as it does
+        auto const& costs = camera.last_pixel_costs();
+
+        uint32_t costliest_x = 0;
+        uint32_t costliest_y = 0;
+
+        for (uint32_t y = 0; y < costs.height(); y++) {
+                for (uint32_t x = 0; x < costs.width(); x++) {
+                        if (costs.at(x, y).cycles > costs.at(costliest_x, costliest_y).cycles) {
+                                costliest_x = x;
+                                costliest_y = y;
+                        }
+                }
+        }
+
+        write_pixel_trace(fname_stem + "-costliest-pixel.json", camera, the_world, render_params, costliest_x,
+                          costliest_y);
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return the file name, sans extension, of what is
+/// written for a configuration f.e. 'dst_dir/dragons-640x360-8t'
+static std::string config_fname_stem(std::string const& scene_name, RT::camera const& camera,
+                                     RT::config_render_params const& render_params,
+                                     std::string const& dst_dir)
+{
+        std::stringstream ss("");
+        ss << dst_dir << "/" << scene_name << "-" << camera.hsize() << "x" << camera.vsize() << "-"
+           << uint32_t{render_params.hw_threads()} << "t";
+
+        return ss.str();
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to trace all the rays that color pixel (x, y) of a
+/// configuration, and write its ray-tree as json to 'fname'. nothing is written
+/// when (x, y) is not on the canvas.
+static void write_pixel_trace(std::string const& fname, RT::camera const& camera, RT::world const& the_world,
+                              RT::config_render_params const& render_params, uint32_t x, uint32_t y)
+{
+        auto const trace = camera.trace_pixel(the_world, x, y, render_params);
+        if (trace) {
+                LOG_INFO("writing ray-tree of pixel (%u, %u): '%s'", x, y, fname.c_str());
+                trace->write_json(fname);
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// summary of the wall times of a configuration
+struct wall_time_summary final {
+        double mean = 0.0;
+        double min  = 0.0;
+        double p50  = 0.0;
+        double p90  = 0.0;
+        double p99  = 0.0;
+        double max  = 0.0;
+};
+
+/// ----------------------------------------------------------------------------
+/// this function is called to summarize the wall times. percentiles use the
+/// nearest-rank method.
+static wall_time_summary summarize(std::vector<double> wall_ms)
+{
+        wall_time_summary summary;
+
+        if (wall_ms.empty()) {
+                return summary;
+        }
+
+        std::sort(wall_ms.begin(), wall_ms.end());
+
+        auto percentile = [&wall_ms](double p) {
+                auto const rank = static_cast<size_t>(std::ceil(p / 100.0 * wall_ms.size()));
+                return wall_ms[std::max<size_t>(rank, 1) - 1];
+        };
+
+        double sum = 0.0;
+        for (auto const t : wall_ms) {
+                sum += t;
+        }
+
+        summary.mean = sum / wall_ms.size();
+        summary.min  = wall_ms.front();
+        summary.p50  = percentile(50.0);
+        summary.p90  = percentile(90.0);
+        summary.p99  = percentile(99.0);
+        summary.max  = wall_ms.back();
+
+        return summary;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to compute a per-second rate, from a per-render
+/// count
+static double per_second(uint64_t count_per_render, double mean_ms)
+{
+        return (mean_ms > 0.0) ? (count_per_render * 1000.0 / mean_ms) : 0.0;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to report the hardware events of each phase of
+/// rendering as a json object
+static std::string phase_events_as_json(RT::render_phase_events const& events)
+{
+        std::stringstream ss("");
+        ss << std::fixed << std::setprecision(3) << "{";
+
+        for (size_t p = 0; p < RT::RENDER_PHASE_MAX; p++) {
+                auto const P = static_cast<RT::render_phase>(p);
+                auto const s = RT::summarize_render_phase(events, P);
+
+                // clang-format off
+                ss << (p == 0 ? "" : ", ")
+                   << "\"" << RT::stringify_render_phase(P) << "\": {"
+                   << "\"cycles_share\": " << s.cycles_share << ", "
+                   << "\"ipc\": "          << s.ipc          << ", "
+                   << "\"l1d_mpki\": "     << s.l1d_mpki     << ", "
+                   << "\"llc_mpki\": "     << s.llc_mpki     << ", "
+                   << "\"branch_mpki\": "  << s.branch_mpki  << "}";
+                // clang-format on
+        }
+
+        ss << "}";
+
+        return ss.str();
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to report the results as json
+static std::string results_as_json(std::vector<bench_result> const& results)
+{
+        std::stringstream ss("");
+        ss << std::fixed << std::setprecision(3);
+
+        ss << "{\n"
+           << "  \"cores\": " << RT::max_cores() << ",\n"
+           << "  \"results\": [";
+
+        for (size_t i = 0; i < results.size(); i++) {
+                auto const& r = results[i];
+                auto const wt = summarize(r.wall_ms);
+
+                // clang-format off
+                ss << (i == 0 ? "\n" : ",\n")
+                   << "    {"
+                   << "\"scene\": \""         << r.scene                                << "\", "
+                   << "\"width\": "           << r.width                                << ", "
+                   << "\"height\": "          << r.height                               << ", "
+                   << "\"threads\": "         << r.threads                              << ", "
+                   << "\"antialias\": "       << (r.antialias ? "true" : "false")       << ", "
+                   << "\"iterations\": "      << r.wall_ms.size()                       << ", "
+                   << "\"wall_ms\": {"
+                   << "\"mean\": "            << wt.mean                                << ", "
+                   << "\"min\": "             << wt.min                                 << ", "
+                   << "\"p50\": "             << wt.p50                                 << ", "
+                   << "\"p90\": "             << wt.p90                                 << ", "
+                   << "\"p99\": "             << wt.p99                                 << ", "
+                   << "\"max\": "             << wt.max                                 << "}, "
+                   << "\"pixels\": "          << r.pixels                               << ", "
+                   << "\"rays\": "            << r.counters.rays()                      << ", "
+                   << "\"primary_rays\": "    << r.counters.primary_rays                << ", "
+                   << "\"shadow_rays\": "     << r.counters.shadow_rays                 << ", "
+                   << "\"reflected_rays\": "  << r.counters.reflected_rays              << ", "
+                   << "\"refracted_rays\": "  << r.counters.refracted_rays              << ", "
+                   << "\"box_tests\": "       << r.counters.box_tests                   << ", "
+                   << "\"primitive_tests\": " << r.counters.primitive_tests             << ", "
+                   << "\"pixels_per_sec\": "  << per_second(r.pixels, wt.mean)          << ", "
+                   << "\"rays_per_sec\": "    << per_second(r.counters.rays(), wt.mean) << ", "
+                   << "\"peak_rss_bytes\": "  << r.peak_rss;
+                // clang-format on
+
+                if (r.has_phase_events) {
+                        ss << ", \"phases\": " << phase_events_as_json(r.counters.phase_events);
+                }
+
+                ss << "}";
+        }
+
+        ss << "\n  ]\n"
+           << "}\n";
+
+        return ss.str();
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to report the results as csv, one configuration per
+/// row
+static std::string results_as_csv(std::vector<bench_result> const& results)
+{
+        std::stringstream ss("");
+        ss << std::fixed << std::setprecision(3);
+
+        ss << "scene,width,height,threads,antialias,iterations,"
+           << "mean_ms,min_ms,p50_ms,p90_ms,p99_ms,max_ms,"
+           << "pixels,rays,primary_rays,shadow_rays,reflected_rays,refracted_rays,box_tests,primitive_tests,"
+           << "pixels_per_sec,rays_per_sec,peak_rss_bytes\n";
+
+        for (auto const& r : results) {
+                auto const wt = summarize(r.wall_ms);
+
+                // clang-format off
+                ss << r.scene                                << ","
+                   << r.width                                << ","
+                   << r.height                               << ","
+                   << r.threads                              << ","
+                   << (r.antialias ? 1 : 0)                  << ","
+                   << r.wall_ms.size()                       << ","
+                   << wt.mean                                << ","
+                   << wt.min                                 << ","
+                   << wt.p50                                 << ","
+                   << wt.p90                                 << ","
+                   << wt.p99                                 << ","
+                   << wt.max                                 << ","
+                   << r.pixels                               << ","
+                   << r.counters.rays()                      << ","
+                   << r.counters.primary_rays                << ","
+                   << r.counters.shadow_rays                 << ","
+                   << r.counters.reflected_rays              << ","
+                   << r.counters.refracted_rays              << ","
+                   << r.counters.box_tests                   << ","
+                   << r.counters.primitive_tests             << ","
+                   << per_second(r.pixels, wt.mean)          << ","
+                   << per_second(r.counters.rays(), wt.mean) << ","
+                   << r.peak_rss
+                   << "\n";
+                // clang-format on
+        }
+
+        return ss.str();
+}
@@ -0,0 +1,594 @@
+/*
+ * this program microbenchmarks the primitives, and shapes that are on the hot
+ * path of rendering, and reports the cost of each operation (in ns/op) in a
+ * machine-readable format, so that optimizations can be tracked at that
+ * granularity.
+ *
+ * inputs of each benchmark f.e. rays, matrices, points etc. are randomly
+ * generated, but with a fixed seed, so that runs are comparable. operations
+ * are performed in batches over all inputs, and a checksum of their results
+ * is reported as well. this keeps the compiler from optimizing the work away,
+ * and catches changes in behavior along with changes in performance.
+ *
+ * usage: rt_microbench [options]
+ *
+ *     --list                       list the benchmarks and exit
+ *     --filter     <substr,...>    benchmarks to run (default: all)
+ *     --seed       <N>             seed of the inputs (default: 42)
+ *     --rounds     <N>             measured rounds (default: 5)
+ *     --min-time   <ms>            minimum duration of a round (default: 100)
+ *     --output     <fname>         output file (default: stdout)
+ **/
+
+/// system includes
+#include <getopt.h>
+
+/// c++ includes
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "bench_cli.hpp"
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+#include "io/phong_illumination.hpp"
+#include "patterns/material.hpp"
+#include "patterns/perlin_noise.hpp"
+#include "patterns/solid_pattern.hpp"
+#include "patterns/texture_image.hpp"
+#include "primitives/color.hpp"
+#include "primitives/matrix.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/point_light.hpp"
+#include "primitives/ray.hpp"
+#include "primitives/tuple.hpp"
+#include "shapes/aabb.hpp"
+#include "shapes/cone.hpp"
+#include "shapes/csg.hpp"
+#include "shapes/cube.hpp"
+#include "shapes/cylinder.hpp"
+#include "shapes/plane.hpp"
+#include "shapes/shape_interface.hpp"
+#include "shapes/sphere.hpp"
+#include "shapes/triangle.hpp"
+#include "utils/constants.hpp"
+
+/*
+ * select default logging level depending on type of build. this can be changed
+ * later to more appropriate values.
+ **/
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+
+/// convenience mostly
+namespace RT   = raytracer;
+using RT_XFORM = RT::matrix_transformations_t;
+
+/// ----------------------------------------------------------------------------
+/// inputs of all benchmarks come from this
+using input_rng = std::mt19937_64;
+
+/// ----------------------------------------------------------------------------
+/// a batch performs an operation on each of the 'NUM_INPUTS' inputs of a
+/// benchmark, and returns a checksum of the results.
+static constexpr size_t NUM_INPUTS = 1024;
+using microbench_batch             = std::function<double()>;
+
+/// ----------------------------------------------------------------------------
+/// a single benchmark. 'create' generates the inputs, and returns the batch
+/// operating on them.
+struct microbench final {
+        std::string name;
+        std::function<microbench_batch(input_rng&)> create;
+};
+
+/// ----------------------------------------------------------------------------
+/// what is to be benchmarked, and how
+struct microbench_options final {
+        std::vector<std::string> filters;
+        uint64_t seed        = 42;
+        uint32_t rounds      = 5;
+        uint32_t min_time_ms = 100;
+        std::string output_fname;
+        bool list_only = false;
+};
+
+/// ----------------------------------------------------------------------------
+/// results of a single benchmark
+struct microbench_result final {
+        std::string name;
+        uint64_t ops_per_round = 0; /// of the last round
+        std::vector<double> ns_per_op;
+        double checksum = 0.0;
+};
+
+/// file specific functions
+static std::optional<microbench_options> parse_options(int argc, char** argv);
+static std::vector<microbench> all_microbenches();
+static microbench_result run_microbench(microbench const& mb, microbench_options const& opts);
+static std::string results_as_json(std::vector<microbench_result> const& results,
+                                   microbench_options const& opts);
+
+int main(int argc, char** argv)
+{
+        auto const opts = parse_options(argc, argv);
+        if (!opts) {
+                return 1;
+        }
+
+        std::vector<microbench> selected;
+        for (auto const& mb : all_microbenches()) {
+                auto const matches =
+                        std::any_of(opts->filters.begin(), opts->filters.end(),
+                                    [&mb](auto const& f) { return mb.name.find(f) != std::string::npos; });
+
+                if (opts->filters.empty() || matches) {
+                        selected.push_back(mb);
+                }
+        }
+
+        if (selected.empty()) {
+                LOG_ERROR("no benchmarks match the filter, see --list for available benchmarks");
+                return 1;
+        }
+
+        if (opts->list_only) {
+                for (auto const& mb : selected) {
+                        printf("%s\n", mb.name.c_str());
+                }
+
+                return 0;
+        }
+
+        std::vector<microbench_result> results;
+        for (auto const& mb : selected) {
+                results.push_back(run_microbench(mb, opts.value()));
+        }
+
+        auto const report = results_as_json(results, opts.value());
+
+        FILE* dst_file = stdout;
+        if (!opts->output_fname.empty()) {
+                dst_file = fopen(opts->output_fname.c_str(), "w");
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", opts->output_fname.c_str(),
+                                strerror(errno));
+                        return 1;
+                }
+        }
+
+        fputs(report.c_str(), dst_file);
+
+        if (dst_file != stdout) {
+                fclose(dst_file);
+        }
+
+        return 0;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to parse the command line
+static std::optional<microbench_options> parse_options(int argc, char** argv)
+{
+        static struct option const long_options[] = {
+                {"list", no_argument, nullptr, 'l'},
+                {"filter", required_argument, nullptr, 'f'},
+                {"seed", required_argument, nullptr, 's'},
+                {"rounds", required_argument, nullptr, 'r'},
+                {"min-time", required_argument, nullptr, 'm'},
+                {"output", required_argument, nullptr, 'o'},
+                {nullptr, 0, nullptr, 0},
+        };
+
+        microbench_options opts;
+
+        for (int opt; (opt = getopt_long(argc, argv, "lf:s:r:m:o:", long_options, nullptr)) != -1;) {
+                switch (opt) {
+                case 'l':
+                        opts.list_only = true;
+                        break;
+
+                case 'f':
+                        opts.filters = RT::split_list(optarg);
+                        break;
+
+                case 's':
+                case 'r':
+                case 'm': {
+                        auto const count = RT::parse_count(optarg);
+                        if (!count) {
+                                LOG_ERROR("invalid count: '%s'", optarg);
+                                return std::nullopt;
+                        }
+
+                        if (opt == 's') {
+                                opts.seed = count.value();
+                        } else {
+                                (opt == 'r' ? opts.rounds : opts.min_time_ms) = count.value();
+                        }
+                } break;
+
+                case 'o':
+                        opts.output_fname = optarg;
+                        break;
+
+                default:
+                        return std::nullopt;
+                }
+        }
+
+        return opts;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return a random number in [lo, hi)
+static double random_in(input_rng& rng, double lo, double hi)
+{
+        return std::uniform_real_distribution<double>(lo, hi)(rng);
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return a random point in a cube of side '2 *
+/// extent' centered at the origin
+static RT::tuple random_point(input_rng& rng, double extent)
+{
+        return RT::create_point(random_in(rng, -extent, extent), random_in(rng, -extent, extent),
+                                random_in(rng, -extent, extent));
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return a random unit vector
+static RT::tuple random_direction(input_rng& rng)
+{
+        return RT::normalize(random_point(rng, 1.0) - RT::create_point(0.0, 0.0, 0.0));
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return random rays, that originate outside the
+/// unit cube, and are aimed at points near it. about half of them hit the
+/// unit shapes.
+static std::vector<RT::ray_t> random_rays(input_rng& rng)
+{
+        std::vector<RT::ray_t> rays;
+        rays.reserve(NUM_INPUTS);
+
+        for (size_t i = 0; i < NUM_INPUTS; i++) {
+                auto const from   = random_direction(rng) * 5.0;
+                auto const origin = RT::create_point(from.x(), from.y(), from.z());
+                auto const to     = random_point(rng, 1.5);
+
+                rays.emplace_back(origin, RT::normalize(to - origin));
+        }
+
+        return rays;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return a random, invertible transform
+static RT::fsize_dense2d_matrix_t random_transform(input_rng& rng)
+{
+        return RT_XFORM::create_3d_translation_matrix(random_in(rng, -5.0, 5.0), random_in(rng, -5.0, 5.0),
+                                                      random_in(rng, -5.0, 5.0)) *
+               RT_XFORM::create_rotx_matrix(random_in(rng, 0.0, RT::PI)) *
+               RT_XFORM::create_roty_matrix(random_in(rng, 0.0, RT::PI)) *
+               RT_XFORM::create_3d_scaling_matrix(random_in(rng, 0.5, 2.0), random_in(rng, 0.5, 2.0),
+                                                  random_in(rng, 0.5, 2.0));
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to create a benchmark of intersecting random rays
+/// with a shape
+static microbench intersect_microbench(std::string name,
+                                       std::function<std::shared_ptr<RT::shape_interface>()> create_shape)
+{
+        return {std::move(name), [create_shape](input_rng& rng) -> microbench_batch {
+                        auto const shape = create_shape();
+                        auto const rays  = random_rays(rng);
+
+                        return [shape, rays]() {
+                                double checksum = 0.0;
+
+                                for (auto const& r : rays) {
+                                        auto const xs = r.intersect(shape);
+                                        if (xs && !xs->empty()) {
+                                                checksum += xs->size() + xs->front().where();
+                                        }
+                                }
+
+                                return checksum;
+                        };
+                }};
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return all the benchmarks
+static std::vector<microbench> all_microbenches()
+{
+        std::vector<microbench> all;
+
+        /// --------------------------------------------------------------------
+        /// primitives
+        all.push_back({"ray_t::transform", [](input_rng& rng) -> microbench_batch {
+                               auto const rays  = random_rays(rng);
+                               auto const xform = random_transform(rng);
+
+                               return [rays, xform]() {
+                                       double checksum = 0.0;
+                                       for (auto const& r : rays) {
+                                               checksum += r.transform(xform).origin().x();
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        all.push_back({"matrix::inverse", [](input_rng& rng) -> microbench_batch {
+                               std::vector<RT::fsize_dense2d_matrix_t> matrices;
+                               for (size_t i = 0; i < NUM_INPUTS; i++) {
+                                       matrices.push_back(random_transform(rng));
+                               }
+
+                               return [matrices]() {
+                                       double checksum = 0.0;
+                                       for (auto const& m : matrices) {
+                                               checksum += RT::inverse(m)(0, 3);
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        all.push_back({"matrix::multiply", [](input_rng& rng) -> microbench_batch {
+                               std::vector<RT::fsize_dense2d_matrix_t> matrices;
+                               for (size_t i = 0; i <= NUM_INPUTS; i++) {
+                                       matrices.push_back(random_transform(rng));
+                               }
+
+                               return [matrices]() {
+                                       double checksum = 0.0;
+                                       for (size_t i = 0; i < NUM_INPUTS; i++) {
+                                               checksum += (matrices[i] * matrices[i + 1])(0, 3);
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        all.push_back({"aabb::intersects", [](input_rng& rng) -> microbench_batch {
+                               auto const box  = RT::aabb(RT::create_point(-1.0, -1.0, -1.0),
+                                                         RT::create_point(1.0, 1.0, 1.0));
+                               auto const rays = random_rays(rng);
+
+                               return [box, rays]() {
+                                       double checksum = 0.0;
+                                       for (auto const& r : rays) {
+                                               checksum += box.intersects(r) ? 1.0 : 0.0;
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        /// --------------------------------------------------------------------
+        /// shapes
+        all.push_back(intersect_microbench("sphere::intersect", []() {
+                return std::make_shared<RT::sphere>();
+        }));
+
+        all.push_back(intersect_microbench("plane::intersect", []() {
+                return std::make_shared<RT::plane>();
+        }));
+
+        all.push_back(intersect_microbench("cube::intersect", []() {
+                return std::make_shared<RT::cube>();
+        }));
+
+        all.push_back(intersect_microbench("cylinder::intersect", []() {
+                return std::make_shared<RT::cylinder>(true, -1.0, 1.0, true);
+        }));
+
+        all.push_back(intersect_microbench("cone::intersect", []() {
+                return std::make_shared<RT::cone>(true, -1.0, 1.0, true);
+        }));
+
+        all.push_back(intersect_microbench("triangle::intersect", []() {
+                return std::make_shared<RT::triangle>(RT::create_point(0.0, 1.0, 0.0),
+                                                      RT::create_point(-1.0, -1.0, 0.0),
+                                                      RT::create_point(1.0, -1.0, 0.0));
+        }));
+
+        all.push_back(intersect_microbench("csg::intersect", []() {
+                auto cut_sphere = std::make_shared<RT::sphere>();
+                cut_sphere->transform(RT_XFORM::create_3d_scaling_matrix(1.4, 1.4, 1.4));
+
+                return RT::csg_shape::create_csg(std::make_shared<RT::cube>(),
+                                                 std::make_shared<RT::csg_intersection>(), cut_sphere);
+        }));
+
+        /// --------------------------------------------------------------------
+        /// shading
+        all.push_back({"phong_illumination", [](input_rng& rng) -> microbench_batch {
+                               auto shape = std::make_shared<RT::sphere>();
+                               shape->set_material(RT::material().set_pattern(
+                                       std::make_shared<RT::solid_pattern>(RT::color(1.0, 0.2, 1.0))));
+
+                               auto const light = RT::point_light(RT::create_point(-10.0, 10.0, -10.0),
+                                                                  RT::color(1.0, 1.0, 1.0));
+
+                               /// points on the sphere, seen from random eyes
+                               std::vector<std::pair<RT::tuple, RT::tuple>> points_and_eyes;
+                               for (size_t i = 0; i < NUM_INPUTS; i++) {
+                                       auto const n  = random_direction(rng);
+                                       auto const pt = RT::create_point(n.x(), n.y(), n.z());
+
+                                       points_and_eyes.emplace_back(pt, random_direction(rng));
+                               }
+
+                               return [shape, light, points_and_eyes]() {
+                                       double checksum = 0.0;
+                                       for (auto const& [pt, eye] : points_and_eyes) {
+                                               auto const normal = pt - RT::create_point(0.0, 0.0, 0.0);
+                                               auto const c =
+                                                       RT::phong_illumination(shape, pt, light, eye, normal);
+
+                                               checksum += c.R();
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        all.push_back({"perlin_noise::octave_noise_3d", [](input_rng& rng) -> microbench_batch {
+                               auto const noise = RT::perlin_noise(rng());
+
+                               std::vector<RT::tuple> points;
+                               for (size_t i = 0; i < NUM_INPUTS; i++) {
+                                       points.push_back(random_point(rng, 100.0));
+                               }
+
+                               return [noise, points]() {
+                                       double checksum = 0.0;
+                                       for (auto const& p : points) {
+                                               checksum += noise.octave_noise_3d(p.x(), p.y(), p.z(), 4);
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        all.push_back({"texture_image::sample", [](input_rng& rng) -> microbench_batch {
+                               /// a 1k x 1k texture of random texels
+                               auto img = RT::canvas::create_binary(1024, 1024);
+                               for (uint32_t y = 0; y < img.height(); y++) {
+                                       for (uint32_t x = 0; x < img.width(); x++) {
+                                               img.write_pixel(x, y,
+                                                               RT::color(random_in(rng, 0.0, 1.0),
+                                                                         random_in(rng, 0.0, 1.0),
+                                                                         random_in(rng, 0.0, 1.0)));
+                                       }
+                               }
+
+                               auto const texture =
+                                       std::make_shared<RT::texture_image const>(img, RT::TEXEL_FORMAT_RGB8);
+
+                               /// (s, t, footprint), with footprints from a
+                               /// texel to a sixteenth of the texture
+                               std::vector<RT::tuple> samples;
+                               for (size_t i = 0; i < NUM_INPUTS; i++) {
+                                       auto const s         = random_in(rng, 0.0, 1.0);
+                                       auto const t         = random_in(rng, 0.0, 1.0);
+                                       auto const footprint = std::exp2(random_in(rng, -10.0, -4.0));
+
+                                       samples.push_back(RT::create_point(s, t, footprint));
+                               }
+
+                               return [texture, samples]() {
+                                       double checksum = 0.0;
+                                       for (auto const& s : samples) {
+                                               checksum += texture->sample(s.x(), s.y(), s.z()).G();
+                                       }
+
+                                       return checksum;
+                               };
+                       }});
+
+        return all;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to run a single benchmark. each round runs as many
+/// batches as fit in 'min_time_ms'.
+static microbench_result run_microbench(microbench const& mb, microbench_options const& opts)
+{
+        LOG_INFO("benchmarking: '%s'", mb.name.c_str());
+
+        input_rng rng(opts.seed);
+        auto const batch = mb.create(rng);
+
+        microbench_result result;
+        result.name = mb.name;
+
+        /// --------------------------------------------------------------------
+        /// warm up caches, and make sure that lazily initialized state is
+        /// not measured. the checksum is of a single batch.
+        result.checksum = batch();
+
+        using nanoseconds = std::chrono::duration<double, std::nano>;
+        auto const min_time = std::chrono::milliseconds(opts.min_time_ms);
+
+        for (uint32_t i = 0; i < opts.rounds; i++) {
+                uint64_t num_batches  = 0;
+                auto const start_time = std::chrono::steady_clock::now();
+                auto end_time         = start_time;
+
+                do {
+                        batch();
+                        num_batches += 1;
+                        end_time = std::chrono::steady_clock::now();
+                } while (end_time - start_time < min_time);
+
+                result.ops_per_round = num_batches * NUM_INPUTS;
+                result.ns_per_op.push_back(nanoseconds(end_time - start_time).count() / result.ops_per_round);
+        }
+
+        return result;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to report the results as json
+static std::string results_as_json(std::vector<microbench_result> const& results,
+                                   microbench_options const& opts)
+{
+        std::stringstream ss("");
+        ss << std::fixed << std::setprecision(3);
+
+        ss << "{\n"
+           << "  \"seed\": " << opts.seed << ",\n"
+           << "  \"rounds\": " << opts.rounds << ",\n"
+           << "  \"min_time_ms\": " << opts.min_time_ms << ",\n"
+           << "  \"results\": [";
+
+        for (size_t i = 0; i < results.size(); i++) {
+                auto const& r = results[i];
+
+                auto ns_per_op = r.ns_per_op;
+                std::sort(ns_per_op.begin(), ns_per_op.end());
+
+                double sum = 0.0;
+                for (auto const t : ns_per_op) {
+                        sum += t;
+                }
+
+                // clang-format off
+                ss << (i == 0 ? "\n" : ",\n")
+                   << "    {"
+                   << "\"name\": \""        << r.name                              << "\", "
+                   << "\"ops_per_round\": " << r.ops_per_round                     << ", "
+                   << "\"ns_per_op\": {"
+                   << "\"mean\": "          << sum / ns_per_op.size()              << ", "
+                   << "\"min\": "           << ns_per_op.front()                   << ", "
+                   << "\"median\": "        << ns_per_op[ns_per_op.size() / 2]     << ", "
+                   << "\"max\": "           << ns_per_op.back()                    << "}, "
+                   << "\"checksum\": "      << std::setprecision(6) << r.checksum  << std::setprecision(3)
+                   << "}";
+                // clang-format on
+        }
+
+        ss << "\n  ]\n"
+           << "}\n";
+
+        return ss.str();
+}
@@ -0,0 +1,501 @@
+/*
+ * this program is a regression gate for rendering. it renders the scenes of
+ * the catalogue (see 'scene_catalogue.hpp') at a reduced resolution, and
+ * compares each of them with a stored reference:
+ *
+ *     - image: the render must not differ from the reference image by more
+ *       than an RMSE threshold, and must not have more than a small fraction
+ *       of visibly different pixels.
+ *
+ *     - performance: throughput (pixels/sec) of the render must not drop below
+ *       the stored baseline by more than a tolerance.
+ *
+ * so that optimizations (float math, changes to bounding volumes, simd etc.)
+ * neither silently change images, nor slow things down.
+ *
+ * usage: rt_regress --references <dir> [options]
+ *
+ *     --list                       list the catalogued scenes and exit
+ *     --references <dir>           reference images, and throughput baseline
+ *     --update                     (re)generate references instead of
+ *                                  comparing with them
+ *     --scenes     <name,...>      scenes to render (default: all)
+ *     --width      <N>             width of renders, the height follows the
+ *                                  aspect ratio of the scene (default: 96)
+ *     --threads    <N>             rendering threads (default: all cores)
+ *     --iterations <N>             timed renders, fastest counts (default: 3)
+ *     --max-rmse   <f>             image rmse threshold (default: 0.01)
+ *     --max-bad-pixels <f>         fraction of visibly different pixels
+ *                                  allowed (default: 0.005)
+ *     --tolerance  <f>             allowed drop in throughput (default: 0.15)
+ *     --no-perf                    do not gate on throughput
+ *     --diff-dir   <dir>           write render, and difference image of
+ *                                  failing scenes to 'dir'
+ *
+ * reference directory contains '<scene>.ppm' for each scene, and throughput of
+ * each scene in 'throughput-baseline.csv'. throughput of a scene is only gated
+ * when its baseline was measured with the same width and number of threads.
+ *
+ * the program exits with 0 when all scenes pass, and 1 otherwise.
+ **/
+
+/// system includes
+#include <getopt.h>
+
+/// c++ includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// our includes
+#include "bench_cli.hpp"
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/canvas.hpp"
+#include "io/render_params.hpp"
+#include "io/world.hpp"
+#include "primitives/color.hpp"
+#include "scene_catalogue.hpp"
+#include "utils/utils.hpp"
+
+/*
+ * select default logging level depending on type of build. this can be changed
+ * later to more appropriate values.
+ **/
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+
+/// convenience mostly
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// a channel differing by more than this is visible
+static constexpr double VISIBLE_CHANNEL_DIFF = 0.1;
+
+/// ----------------------------------------------------------------------------
+/// name of the throughput baseline in the reference directory
+static constexpr char THROUGHPUT_BASELINE_FNAME[] = "throughput-baseline.csv";
+
+/// ----------------------------------------------------------------------------
+/// what is to be rendered, and how it is gated
+struct regress_options final {
+        std::string reference_dir;
+        std::vector<std::string> scenes;
+        uint32_t width          = 96;
+        uint32_t threads        = RT::max_cores();
+        uint32_t iterations     = 3;
+        double max_rmse         = 0.01;
+        double max_bad_pixels   = 0.005;
+        double tolerance        = 0.15;
+        bool gate_perf          = true;
+        bool update             = false;
+        bool list_only          = false;
+        std::string diff_dir;
+};
+
+/// ----------------------------------------------------------------------------
+/// throughput of a scene, as stored in the baseline
+struct throughput_baseline final {
+        uint32_t width        = 0;
+        uint32_t height       = 0;
+        uint32_t threads      = 0;
+        double pixels_per_sec = 0.0;
+};
+
+/// ----------------------------------------------------------------------------
+/// throughput of each scene
+using throughput_baselines = std::map<std::string, throughput_baseline>;
+
+/// ----------------------------------------------------------------------------
+/// difference of a render from its reference image
+struct image_diff final {
+        double rmse       = 0.0;
+        double bad_pixels = 0.0; /// fraction
+};
+
+/// file specific functions
+static std::optional<regress_options> parse_options(int argc, char** argv);
+static throughput_baselines read_baseline(std::string const& fname);
+static bool write_baseline(std::string const& fname, throughput_baselines const& baseline);
+static std::optional<image_diff> compare_images(RT::canvas const& actual, RT::canvas const& expected);
+static RT::canvas difference_image(RT::canvas const& actual, RT::canvas const& expected);
+
+int main(int argc, char** argv)
+{
+        auto const opts = parse_options(argc, argv);
+        if (!opts) {
+                return 1;
+        }
+
+        auto const scenes = RT::scene_catalogue::select(opts->scenes);
+        if (scenes.empty()) {
+                return 1;
+        }
+
+        if (opts->list_only) {
+                for (auto const& s : scenes) {
+                        printf("%s\n", s.name.c_str());
+                }
+
+                return 0;
+        }
+
+        auto const baseline_fname = opts->reference_dir + "/" + THROUGHPUT_BASELINE_FNAME;
+        auto baseline             = read_baseline(baseline_fname);
+
+        uint32_t failures = 0;
+
+        printf("%-28s %9s %9s %6s %14s %14s %8s %6s\n", "scene", "rmse", "bad-pix", "image", "pixels/sec",
+               "baseline", "change", "perf");
+
+        for (auto const& scene : scenes) {
+                LOG_INFO("rendering scene: '%s'", scene.name.c_str());
+
+                /// ------------------------------------------------------------
+                /// same view as the scene's own camera, at a reduced resolution
+                auto const scene_camera = scene.create_camera();
+                auto const the_world    = scene.create_world();
+
+                auto const width  = opts->width;
+                auto const height = std::max(1u, (width * scene_camera.vsize()) / scene_camera.hsize());
+
+                auto camera = RT::camera(width, height, scene_camera.field_of_view());
+                camera.transform(scene_camera.transform());
+
+                auto const render_params =
+                        RT::config_render_params().hw_threads(opts->threads).antialias(scene.antialias);
+
+                /// ------------------------------------------------------------
+                /// fastest of the renders is the least disturbed one. renders
+                /// are deterministic, so any of them is the image.
+                auto render_sec = [&]() {
+                        auto const start_time = std::chrono::steady_clock::now();
+                        auto rendered         = camera.render(the_world, render_params);
+                        auto const end_time   = std::chrono::steady_clock::now();
+
+                        return std::make_pair(std::move(rendered),
+                                              std::chrono::duration<double>(end_time - start_time).count());
+                };
+
+                auto [image, best_sec] = render_sec();
+
+                for (uint32_t i = 1; i < opts->iterations; i++) {
+                        best_sec = std::min(best_sec, render_sec().second);
+                }
+
+                auto const pixels_per_sec = (uint64_t{width} * height) / std::max(best_sec, 1e-9);
+                auto const reference_fname = opts->reference_dir + "/" + scene.name + ".ppm";
+
+                if (opts->update) {
+                        image.write(reference_fname);
+                        baseline[scene.name] = {width, height, opts->threads, pixels_per_sec};
+
+                        printf("%-28s %9s %9s %6s %14.0f %14s %8s %6s\n", scene.name.c_str(), "-", "-", "new",
+                               pixels_per_sec, "-", "-", "new");
+                        continue;
+                }
+
+                /// ------------------------------------------------------------
+                /// image gate
+                bool image_ok = false;
+                image_diff diff;
+
+                auto const reference = RT::canvas::load_from_file(reference_fname);
+                if (!reference) {
+                        LOG_ERROR("no reference image: '%s', see --update", reference_fname.c_str());
+                } else if (auto const d = compare_images(image, reference.value()); d) {
+                        diff     = d.value();
+                        image_ok = (diff.rmse <= opts->max_rmse) && (diff.bad_pixels <= opts->max_bad_pixels);
+                } else {
+                        LOG_ERROR("reference image: '%s' is %zux%zu, expected %ux%u", reference_fname.c_str(),
+                                  reference->width(), reference->height(), width, height);
+                }
+
+                if (!image_ok && !opts->diff_dir.empty()) {
+                        image.write(opts->diff_dir + "/" + scene.name + ".ppm");
+
+                        if (reference && (reference->width() == width) && (reference->height() == height)) {
+                                difference_image(image, reference.value())
+                                        .write(opts->diff_dir + "/" + scene.name + "-diff.ppm");
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// performance gate, only against a comparable baseline
+                char const* perf_verdict = "skip";
+                double baseline_pps      = 0.0;
+                double change            = 0.0;
+                bool perf_ok             = true;
+
+                auto const it = baseline.find(scene.name);
+                if ((it != baseline.end()) && (it->second.width == width) && (it->second.height == height) &&
+                    (it->second.threads == opts->threads) && (it->second.pixels_per_sec > 0.0)) {
+                        baseline_pps = it->second.pixels_per_sec;
+                        change       = (pixels_per_sec - baseline_pps) / baseline_pps;
+
+                        if (opts->gate_perf) {
+                                perf_ok      = (change >= -opts->tolerance);
+                                perf_verdict = perf_ok ? "ok" : "FAIL";
+                        }
+                } else {
+                        LOG_INFO("no comparable throughput baseline for scene: '%s'", scene.name.c_str());
+                }
+
+                if (!image_ok || !perf_ok) {
+                        failures += 1;
+                }
+
+                printf("%-28s %9.5f %9.5f %6s %14.0f %14.0f %+7.1f%% %6s\n", scene.name.c_str(), diff.rmse,
+                       diff.bad_pixels, image_ok ? "ok" : "FAIL", pixels_per_sec, baseline_pps,
+                       change * 100.0, perf_verdict);
+        }
+
+        if (opts->update) {
+                return write_baseline(baseline_fname, baseline) ? 0 : 1;
+        }
+
+        printf("%zu scenes, %u failed\n", scenes.size(), failures);
+
+        return (failures == 0) ? 0 : 1;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to parse a non-negative fraction || threshold
+static std::optional<double> parse_fraction(std::string const& str)
+{
+        char* end_ptr    = nullptr;
+        auto const value = strtod(str.c_str(), &end_ptr);
+
+        if (str.empty() || (*end_ptr != '\0') || !(value >= 0.0)) {
+                return std::nullopt;
+        }
+
+        return value;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to parse the command line
+static std::optional<regress_options> parse_options(int argc, char** argv)
+{
+        enum {
+                OPT_MAX_BAD_PIXELS = 256,
+                OPT_NO_PERF,
+                OPT_DIFF_DIR,
+        };
+
+        static struct option const long_options[] = {
+                {"list", no_argument, nullptr, 'l'},
+                {"references", required_argument, nullptr, 'r'},
+                {"update", no_argument, nullptr, 'u'},
+                {"scenes", required_argument, nullptr, 's'},
+                {"width", required_argument, nullptr, 'w'},
+                {"threads", required_argument, nullptr, 't'},
+                {"iterations", required_argument, nullptr, 'i'},
+                {"max-rmse", required_argument, nullptr, 'e'},
+                {"max-bad-pixels", required_argument, nullptr, OPT_MAX_BAD_PIXELS},
+                {"tolerance", required_argument, nullptr, 'p'},
+                {"no-perf", no_argument, nullptr, OPT_NO_PERF},
+                {"diff-dir", required_argument, nullptr, OPT_DIFF_DIR},
+                {nullptr, 0, nullptr, 0},
+        };
+
+        regress_options opts;
+
+        for (int opt; (opt = getopt_long(argc, argv, "lr:us:w:t:i:e:p:", long_options, nullptr)) != -1;) {
+                switch (opt) {
+                case 'l':
+                        opts.list_only = true;
+                        break;
+
+                case 'r':
+                        opts.reference_dir = optarg;
+                        break;
+
+                case 'u':
+                        opts.update = true;
+                        break;
+
+                case 's':
+                        opts.scenes = RT::split_list(optarg);
+                        break;
+
+                case 'w':
+                case 't':
+                case 'i': {
+                        auto const count = RT::parse_count(optarg);
+                        if (!count || ((opt == 't') && (count.value() > UINT8_MAX))) {
+                                LOG_ERROR("invalid count: '%s'", optarg);
+                                return std::nullopt;
+                        }
+
+                        auto& dst = (opt == 'w') ? opts.width
+                                                 : ((opt == 't') ? opts.threads : opts.iterations);
+                        dst       = count.value();
+                } break;
+
+                case 'e':
+                case 'p':
+                case OPT_MAX_BAD_PIXELS: {
+                        auto const value = parse_fraction(optarg);
+                        if (!value) {
+                                LOG_ERROR("invalid threshold: '%s'", optarg);
+                                return std::nullopt;
+                        }
+
+                        auto& dst = (opt == 'e') ? opts.max_rmse
+                                                 : ((opt == 'p') ? opts.tolerance : opts.max_bad_pixels);
+                        dst       = value.value();
+                } break;
+
+                case OPT_NO_PERF:
+                        opts.gate_perf = false;
+                        break;
+
+                case OPT_DIFF_DIR:
+                        opts.diff_dir = optarg;
+                        break;
+
+                default:
+                        return std::nullopt;
+                }
+        }
+
+        if (opts.reference_dir.empty() && !opts.list_only) {
+                LOG_ERROR("no reference directory, see --references");
+                return std::nullopt;
+        }
+
+        return opts;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to read the throughput baseline. each line is
+/// 'scene,width,height,threads,pixels-per-sec', and lines starting with '#'
+/// are comments. a missing baseline is an empty one.
+static throughput_baselines read_baseline(std::string const& fname)
+{
+        throughput_baselines baseline;
+        std::ifstream src(fname);
+
+        for (std::string line; std::getline(src, line);) {
+                if (line.empty() || (line[0] == '#')) {
+                        continue;
+                }
+
+                std::stringstream ss(line);
+                std::string name;
+                throughput_baseline b;
+                char sep[3] = {};
+
+                std::getline(ss, name, ',');
+                ss >> b.width >> sep[0] >> b.height >> sep[1] >> b.threads >> sep[2] >> b.pixels_per_sec;
+
+                if (name.empty() || ss.fail() || (sep[0] != ',') || (sep[1] != ',') || (sep[2] != ',')) {
+                        LOG_ERROR("ignoring malformed baseline: '%s' in '%s'", line.c_str(), fname.c_str());
+                        continue;
+                }
+
+                baseline[name] = b;
+        }
+
+        return baseline;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to write the throughput baseline
+static bool write_baseline(std::string const& fname, throughput_baselines const& baseline)
+{
+        std::ofstream dst(fname);
+
+        dst << "# scene,width,height,threads,pixels-per-sec\n";
+
+        for (auto const& [name, b] : baseline) {
+                dst << name << "," << b.width << "," << b.height << "," << b.threads << "," << std::fixed
+                    << std::setprecision(0) << b.pixels_per_sec << "\n";
+        }
+
+        if (!dst.good()) {
+                LOG_ERROR("failed writing throughput baseline: '%s'", fname.c_str());
+                return false;
+        }
+
+        return true;
+}
+
+/// ----------------------------------------------------------------------------
+/// color channels as they end up in an image
+static double image_channel(float v)
+{
+        return std::clamp(static_cast<double>(v), 0.0, 1.0);
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to compare a render with its reference. images of
+/// different sizes cannot be compared.
+static std::optional<image_diff> compare_images(RT::canvas const& actual, RT::canvas const& expected)
+{
+        if ((actual.width() != expected.width()) || (actual.height() != expected.height())) {
+                return std::nullopt;
+        }
+
+        double sum_sq_diff  = 0.0;
+        uint64_t bad_pixels = 0;
+
+        for (uint32_t y = 0; y < actual.height(); y++) {
+                for (uint32_t x = 0; x < actual.width(); x++) {
+                        auto const a = actual.read_pixel(x, y);
+                        auto const e = expected.read_pixel(x, y);
+
+                        double const d_r = image_channel(a.R()) - image_channel(e.R());
+                        double const d_g = image_channel(a.G()) - image_channel(e.G());
+                        double const d_b = image_channel(a.B()) - image_channel(e.B());
+
+                        sum_sq_diff += (d_r * d_r) + (d_g * d_g) + (d_b * d_b);
+
+                        auto const max_diff = std::max({std::fabs(d_r), std::fabs(d_g), std::fabs(d_b)});
+                        if (max_diff > VISIBLE_CHANNEL_DIFF) {
+                                bad_pixels += 1;
+                        }
+                }
+        }
+
+        auto const num_pixels = static_cast<double>(actual.width()) * actual.height();
+
+        return image_diff{std::sqrt(sum_sq_diff / (3.0 * num_pixels)), bad_pixels / num_pixels};
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to create an image of the difference of a render
+/// from its reference, amplified so that small differences are visible too.
+static RT::canvas difference_image(RT::canvas const& actual, RT::canvas const& expected)
+{
+        constexpr float AMPLIFY = 8.0f;
+
+        auto diff = RT::canvas::create_binary(actual.width(), actual.height());
+
+        for (uint32_t y = 0; y < actual.height(); y++) {
+                for (uint32_t x = 0; x < actual.width(); x++) {
+                        auto const a = actual.read_pixel(x, y);
+                        auto const e = expected.read_pixel(x, y);
+
+                        auto const d_r = std::fabs(image_channel(a.R()) - image_channel(e.R()));
+                        auto const d_g = std::fabs(image_channel(a.G()) - image_channel(e.G()));
+                        auto const d_b = std::fabs(image_channel(a.B()) - image_channel(e.B()));
+
+                        diff.write_pixel(x, y, RT::color(d_r * AMPLIFY, d_g * AMPLIFY, d_b * AMPLIFY));
+                }
+        }
+
+        return diff;
+}
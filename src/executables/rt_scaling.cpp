@@ -0,0 +1,560 @@
+/*
+ * this program is a scaling study of rendering. it renders scenes of the
+ * catalogue (see 'scene_catalogue.hpp') with every combination of rendering
+ * threads, rendering style and work item size, so that the best one for a
+ * scene (and a machine) is found by measurement, rather than guesswork.
+ *
+ * for every combination, the following are reported:
+ *
+ *     - wall time (ms) of the fastest render, and pixels/sec
+ *     - speedup over a single thread, with the same style and work items
+ *     - parallel efficiency i.e. speedup / threads
+ *     - utilization i.e. fraction of the time of all threads spent rendering
+ *     - idle time of each thread, and the part of it after the thread ran out
+ *       of work (tail)
+ *
+ * usage: rt_scaling [options]
+ *
+ *     --list                       list the catalogued scenes and exit
+ *     --scenes     <name,...>      scenes to render (default: all)
+ *     --width      <N>             width of renders, the height follows the
+ *                                  aspect ratio of the scene (default: 320)
+ *     --threads    <N,...>         rendering threads (default: powers of 2,
+ *                                  and all cores). a single thread is always
+ *                                  rendered, as the baseline of speedups.
+ *     --styles     <name,...>      rendering styles, of scanline, hilbert and
+ *                                  tile (default: all)
+ *     --work-items <N,...>         pixels per work item, 0 being the default
+ *                                  of the style (default: 0,16,64,256,1024)
+ *     --iterations <N>             renders of each combination, fastest
+ *                                  counts (default: 3)
+ *     --format     <table|csv>     output format (default: table)
+ *     --output     <fname>         output file (default: stdout)
+ *
+ * the table lists the best combination of each scene after its rows. the csv
+ * has a row per combination, with idle times of individual threads as a ';'
+ * separated list.
+ **/
+
+/// system includes
+#include <getopt.h>
+
+/// c++ includes
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// our includes
+#include "bench_cli.hpp"
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/render_params.hpp"
+#include "io/render_stats.hpp"
+#include "io/world.hpp"
+#include "scene_catalogue.hpp"
+#include "utils/utils.hpp"
+
+/*
+ * select default logging level depending on type of build. this can be changed
+ * later to more appropriate values.
+ **/
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+
+/// convenience mostly
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// what is to be swept, and how the results are reported
+struct scaling_options final {
+        std::vector<std::string> scenes;
+        uint32_t width                          = 320;
+        std::vector<uint32_t> threads           = {};
+        std::vector<RT::rendering_style> styles = {RT::rendering_style::RENDERING_STYLE_SCANLINE,
+                                                   RT::rendering_style::RENDERING_STYLE_HILBERT,
+                                                   RT::rendering_style::RENDERING_STYLE_TILE};
+        std::vector<uint32_t> work_items        = {0, 16, 64, 256, 1024};
+        uint32_t iterations                     = 3;
+        bool csv                                = false;
+        std::string output_fname;
+        bool list_only = false;
+};
+
+/// ----------------------------------------------------------------------------
+/// results of rendering a single combination
+struct scaling_result final {
+        std::string scene;
+        uint32_t width            = 0;
+        uint32_t height           = 0;
+        RT::rendering_style style = RT::rendering_style::RENDERING_STYLE_INVALID;
+        uint32_t work_items       = 0;
+        uint32_t threads          = 0;
+        double wall_ms            = 0.0; /// fastest render
+        double speedup            = 0.0;
+        double utilization        = 0.0;
+        std::vector<double> idle_ms;
+        std::vector<double> tail_idle_ms;
+
+        double pixels_per_sec() const
+        {
+                return (wall_ms > 0.0) ? (uint64_t{width} * height * 1000.0 / wall_ms) : 0.0;
+        }
+
+        double efficiency() const
+        {
+                return (threads > 0) ? (speedup / threads) : 0.0;
+        }
+};
+
+/// file specific functions
+static std::optional<scaling_options> parse_options(int argc, char** argv);
+static std::vector<scaling_result> sweep_scene(RT::catalogued_scene const& scene,
+                                               scaling_options const& opts);
+static std::string results_as_table(std::vector<scaling_result> const& results);
+static std::string results_as_csv(std::vector<scaling_result> const& results);
+
+int main(int argc, char** argv)
+{
+        auto const opts = parse_options(argc, argv);
+        if (!opts) {
+                return 1;
+        }
+
+        auto const scenes = RT::scene_catalogue::select(opts->scenes);
+        if (scenes.empty()) {
+                return 1;
+        }
+
+        if (opts->list_only) {
+                for (auto const& s : scenes) {
+                        printf("%s\n", s.name.c_str());
+                }
+
+                return 0;
+        }
+
+        std::vector<scaling_result> results;
+        for (auto const& s : scenes) {
+                auto scene_results = sweep_scene(s, opts.value());
+                results.insert(results.end(), scene_results.begin(), scene_results.end());
+        }
+
+        auto const report = opts->csv ? results_as_csv(results) : results_as_table(results);
+
+        FILE* dst_file = stdout;
+        if (!opts->output_fname.empty()) {
+                dst_file = fopen(opts->output_fname.c_str(), "w");
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", opts->output_fname.c_str(),
+                                strerror(errno));
+                        return 1;
+                }
+        }
+
+        fputs(report.c_str(), dst_file);
+
+        if (dst_file != stdout) {
+                fclose(dst_file);
+        }
+
+        return 0;
+}
+
+/// ----------------------------------------------------------------------------
+/// short name of a rendering style
+static char const* style_name(RT::rendering_style style)
+{
+        switch (style) {
+        case RT::rendering_style::RENDERING_STYLE_SCANLINE:
+                return "scanline";
+
+        case RT::rendering_style::RENDERING_STYLE_HILBERT:
+                return "hilbert";
+
+        case RT::rendering_style::RENDERING_STYLE_TILE:
+                return "tile";
+
+        case RT::rendering_style::RENDERING_STYLE_INVALID:
+                break;
+        }
+
+        return "invalid";
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to parse a comma separated list of rendering styles
+static std::optional<std::vector<RT::rendering_style>> parse_styles(char const* list)
+{
+        static constexpr RT::rendering_style all_styles[] = {
+                RT::rendering_style::RENDERING_STYLE_SCANLINE,
+                RT::rendering_style::RENDERING_STYLE_HILBERT,
+                RT::rendering_style::RENDERING_STYLE_TILE,
+        };
+
+        std::vector<RT::rendering_style> styles;
+
+        for (auto const& name : RT::split_list(list)) {
+                auto const it = std::find_if(std::begin(all_styles), std::end(all_styles),
+                                             [&name](auto const s) { return name == style_name(s); });
+
+                if (it == std::end(all_styles)) {
+                        LOG_ERROR("unknown rendering style: '%s'", name.c_str());
+                        return std::nullopt;
+                }
+
+                styles.push_back(*it);
+        }
+
+        if (styles.empty()) {
+                LOG_ERROR("empty list: '%s'", list);
+                return std::nullopt;
+        }
+
+        return styles;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to return the default thread counts: powers of 2,
+/// and all cores
+static std::vector<uint32_t> default_threads()
+{
+        auto const max_threads = std::min<uint32_t>(RT::max_cores(), UINT8_MAX);
+        std::vector<uint32_t> threads;
+
+        for (uint32_t t = 1; t < max_threads; t *= 2) {
+                threads.push_back(t);
+        }
+
+        threads.push_back(max_threads);
+
+        return threads;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to parse the command line
+static std::optional<scaling_options> parse_options(int argc, char** argv)
+{
+        enum {
+                OPT_STYLES = 256,
+                OPT_WORK_ITEMS,
+        };
+
+        static struct option const long_options[] = {
+                {"list", no_argument, nullptr, 'l'},
+                {"scenes", required_argument, nullptr, 's'},
+                {"width", required_argument, nullptr, 'w'},
+                {"threads", required_argument, nullptr, 't'},
+                {"styles", required_argument, nullptr, OPT_STYLES},
+                {"work-items", required_argument, nullptr, OPT_WORK_ITEMS},
+                {"iterations", required_argument, nullptr, 'i'},
+                {"format", required_argument, nullptr, 'f'},
+                {"output", required_argument, nullptr, 'o'},
+                {nullptr, 0, nullptr, 0},
+        };
+
+        scaling_options opts;
+        opts.threads = default_threads();
+
+        for (int opt; (opt = getopt_long(argc, argv, "ls:w:t:i:f:o:", long_options, nullptr)) != -1;) {
+                switch (opt) {
+                case 'l':
+                        opts.list_only = true;
+                        break;
+
+                case 's':
+                        opts.scenes = RT::split_list(optarg);
+                        break;
+
+                case 'w':
+                case 'i': {
+                        auto const count = RT::parse_count(optarg);
+                        if (!count) {
+                                LOG_ERROR("invalid count: '%s'", optarg);
+                                return std::nullopt;
+                        }
+
+                        auto& dst = (opt == 'w') ? opts.width : opts.iterations;
+                        dst       = count.value();
+                } break;
+
+                case 't': {
+                        auto threads = RT::parse_count_list(optarg, 1, UINT8_MAX);
+                        if (!threads) {
+                                return std::nullopt;
+                        }
+
+                        opts.threads = std::move(threads.value());
+                } break;
+
+                case OPT_STYLES: {
+                        auto styles = parse_styles(optarg);
+                        if (!styles) {
+                                return std::nullopt;
+                        }
+
+                        opts.styles = std::move(styles.value());
+                } break;
+
+                case OPT_WORK_ITEMS: {
+                        auto work_items = RT::parse_count_list(optarg, 0, UINT32_MAX);
+                        if (!work_items) {
+                                return std::nullopt;
+                        }
+
+                        opts.work_items = std::move(work_items.value());
+                } break;
+
+                case 'f':
+                        if (strcmp(optarg, "table") == 0) {
+                                opts.csv = false;
+                        } else if (strcmp(optarg, "csv") == 0) {
+                                opts.csv = true;
+                        } else {
+                                LOG_ERROR("unknown format: '%s', expected 'table' || 'csv'", optarg);
+                                return std::nullopt;
+                        }
+                        break;
+
+                case 'o':
+                        opts.output_fname = optarg;
+                        break;
+
+                default:
+                        return std::nullopt;
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// a single thread is the baseline of speedups, and is rendered first
+        opts.threads.push_back(1);
+
+        std::sort(opts.threads.begin(), opts.threads.end());
+        opts.threads.erase(std::unique(opts.threads.begin(), opts.threads.end()), opts.threads.end());
+
+        return opts;
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to render a scene with every combination of
+/// rendering style, work item size and threads. the world is created just
+/// once, and shared by all of them.
+static std::vector<scaling_result> sweep_scene(RT::catalogued_scene const& scene, scaling_options const& opts)
+{
+        LOG_INFO("sweeping scene: '%s'", scene.name.c_str());
+
+        auto const the_world    = scene.create_world();
+        auto const scene_camera = scene.create_camera();
+
+        /// --------------------------------------------------------------------
+        /// same view as the scene's own camera, at a reduced resolution
+        auto const width  = opts.width;
+        auto const height = std::max(1u, (width * scene_camera.vsize()) / scene_camera.hsize());
+
+        auto camera = RT::camera(width, height, scene_camera.field_of_view());
+        camera.transform(scene_camera.transform());
+
+        std::vector<scaling_result> results;
+
+        for (auto const style : opts.styles) {
+                for (auto const work_items : opts.work_items) {
+                        double single_thread_ms = 0.0;
+
+                        for (auto const num_threads : opts.threads) {
+                                auto const render_params = RT::config_render_params()
+                                                                   .hw_threads(num_threads)
+                                                                   .antialias(scene.antialias)
+                                                                   .render_style(style)
+                                                                   .work_item_pixels(work_items);
+
+                                /// --------------------------------------------
+                                /// fastest of the renders is the least
+                                /// disturbed one, and its threads are the ones
+                                /// reported
+                                RT::render_stats best_stats;
+
+                                for (uint32_t i = 0; i < opts.iterations; i++) {
+                                        camera.render(the_world, render_params);
+
+                                        auto const& stats = camera.last_render_stats();
+                                        if ((i == 0) || (stats.wall_ns() < best_stats.wall_ns())) {
+                                                best_stats = stats;
+                                        }
+                                }
+
+                                scaling_result result;
+
+                                result.scene       = scene.name;
+                                result.width       = width;
+                                result.height      = height;
+                                result.style       = style;
+                                result.work_items  = work_items;
+                                result.threads     = num_threads;
+                                result.wall_ms     = best_stats.wall_ns() / 1.0e6;
+                                result.utilization = best_stats.utilization();
+
+                                for (uint32_t t = 0; t < best_stats.threads(); t++) {
+                                        result.idle_ms.push_back(best_stats.idle_ns(t) / 1.0e6);
+                                        result.tail_idle_ms.push_back(best_stats.tail_idle_ns(t) / 1.0e6);
+                                }
+
+                                if (num_threads == 1) {
+                                        single_thread_ms = result.wall_ms;
+                                }
+
+                                result.speedup = (result.wall_ms > 0.0) ? (single_thread_ms / result.wall_ms)
+                                                                        : 0.0;
+
+                                LOG_INFO("scene: '%s', style: '%s', work-items: %u, threads: %u, "
+                                         "wall-ms: %.3f, speedup: %.2f, utilization: %.3f",
+                                         scene.name.c_str(), style_name(style), work_items, num_threads,
+                                         result.wall_ms, result.speedup, result.utilization);
+
+                                results.push_back(std::move(result));
+                        }
+                }
+        }
+
+        return results;
+}
+
+/// ----------------------------------------------------------------------------
+/// work items of a result, as reported
+static std::string work_items_name(uint32_t work_items)
+{
+        return (work_items == 0) ? "default" : std::to_string(work_items);
+}
+
+/// ----------------------------------------------------------------------------
+/// largest of the values, 0 when there are none
+static double max_of(std::vector<double> const& values)
+{
+        return values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to report the results as a table, with the best
+/// combination of each scene after its rows
+static std::string results_as_table(std::vector<scaling_result> const& results)
+{
+        std::stringstream ss("");
+        ss << std::fixed;
+
+        auto const header = [&ss]() {
+                // clang-format off
+                ss << std::left
+                   << std::setw(28) << "scene"      << " "
+                   << std::setw(9)  << "style"      << " "
+                   << std::setw(10) << "work-items" << " "
+                   << std::right
+                   << std::setw(7)  << "threads"    << " "
+                   << std::setw(10) << "wall-ms"    << " "
+                   << std::setw(12) << "pixels/sec" << " "
+                   << std::setw(8)  << "speedup"    << " "
+                   << std::setw(10) << "efficiency" << " "
+                   << std::setw(11) << "utilization" << " "
+                   << std::setw(12) << "max-idle-ms" << " "
+                   << std::setw(12) << "max-tail-ms" << "\n";
+                // clang-format on
+        };
+
+        header();
+
+        for (size_t i = 0; i < results.size(); i++) {
+                auto const& r = results[i];
+
+                auto const max_idle = max_of(r.idle_ms);
+                auto const max_tail = max_of(r.tail_idle_ms);
+
+                // clang-format off
+                ss << std::left
+                   << std::setw(28) << r.scene                      << " "
+                   << std::setw(9)  << style_name(r.style)          << " "
+                   << std::setw(10) << work_items_name(r.work_items) << " "
+                   << std::right
+                   << std::setw(7)  << r.threads                    << " "
+                   << std::setw(10) << std::setprecision(3) << r.wall_ms << " "
+                   << std::setw(12) << std::setprecision(0) << r.pixels_per_sec() << " "
+                   << std::setw(8)  << std::setprecision(2) << r.speedup << " "
+                   << std::setw(10) << std::setprecision(3) << r.efficiency() << " "
+                   << std::setw(11) << r.utilization                << " "
+                   << std::setw(12) << max_idle                     << " "
+                   << std::setw(12) << max_tail                     << "\n";
+                // clang-format on
+
+                /// ------------------------------------------------------------
+                /// last row of a scene, and its best combination
+                if ((i + 1 == results.size()) || (results[i + 1].scene != r.scene)) {
+                        auto const faster = [](auto const& a, auto const& b) {
+                                return a.pixels_per_sec() < b.pixels_per_sec();
+                        };
+
+                        auto const first = std::find_if(results.begin(), results.end(),
+                                                        [&r](auto const& x) { return x.scene == r.scene; });
+                        auto const best  = std::max_element(first, results.begin() + i + 1, faster);
+
+                        ss << "best for '" << r.scene << "': style: " << style_name(best->style)
+                           << ", work-items: " << work_items_name(best->work_items)
+                           << ", threads: " << best->threads << ", " << std::setprecision(0)
+                           << best->pixels_per_sec() << " pixels/sec\n\n";
+
+                        if (i + 1 != results.size()) {
+                                header();
+                        }
+                }
+        }
+
+        return ss.str();
+}
+
+/// ----------------------------------------------------------------------------
+/// this function is called to report the results as csv, one combination per
+/// row
+static std::string results_as_csv(std::vector<scaling_result> const& results)
+{
+        std::stringstream ss("");
+        ss << std::fixed << std::setprecision(3);
+
+        ss << "scene,width,height,style,work_item_pixels,threads,wall_ms,pixels_per_sec,"
+           << "speedup,efficiency,utilization,idle_ms,tail_idle_ms\n";
+
+        auto const join = [](std::vector<double> const& values) {
+                std::stringstream js("");
+                js << std::fixed << std::setprecision(3);
+
+                for (size_t i = 0; i < values.size(); i++) {
+                        js << (i == 0 ? "" : ";") << values[i];
+                }
+
+                return js.str();
+        };
+
+        for (auto const& r : results) {
+                // clang-format off
+                ss << r.scene               << ","
+                   << r.width               << ","
+                   << r.height              << ","
+                   << style_name(r.style)   << ","
+                   << r.work_items          << ","
+                   << r.threads             << ","
+                   << r.wall_ms             << ","
+                   << r.pixels_per_sec()    << ","
+                   << r.speedup             << ","
+                   << r.efficiency()        << ","
+                   << r.utilization         << ","
+                   << join(r.idle_ms)       << ","
+                   << join(r.tail_idle_ms)
+                   << "\n";
+                // clang-format on
+        }
+
+        return ss.str();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+/*
+ * this file implements a catalogue of the scenes rendered by the render_*
+ * executables, so that they can be benchmarked by a single program (see
+ * 'rt_bench.cpp').
+ *
+ * a scene adds itself to the catalogue with 'RT_CATALOGUE_SCENE(...)'. this
+ * only has an effect when the scene is compiled with 'RT_SCENE_CATALOGUE'
+ * defined, in which case its 'main' is compiled out as well. otherwise the
+ * scene is just a regular render_* executable.
+ **/
+
+/// c++ includes
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/world.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// a single scene in the catalogue
+        struct catalogued_scene final {
+                std::string name;
+                std::function<world()> create_world;
+                std::function<camera()> create_camera;
+
+                /// ------------------------------------------------------------
+                /// is the scene rendered with antialiasing by its render_*
+                /// executable ?
+                bool antialias = false;
+        };
+
+        class scene_catalogue final
+        {
+            public:
+                /// ------------------------------------------------------------
+                /// all scenes in the catalogue, in no particular order
+                static std::vector<catalogued_scene>& scenes()
+                {
+                        static std::vector<catalogued_scene> all_scenes;
+                        return all_scenes;
+                }
+
+                /// ------------------------------------------------------------
+                /// add a scene to the catalogue. this is called during static
+                /// initialization, hence the (unused) return value.
+                static bool add(catalogued_scene scene)
+                {
+                        scenes().push_back(std::move(scene));
+                        return true;
+                }
+
+                /// ------------------------------------------------------------
+                /// scenes named in 'names', in that order, or all scenes,
+                /// sorted by name, when 'names' is empty. either way, results
+                /// are always reported in the same order.
+                ///
+                /// returns an empty list when any of the names is unknown.
+                static std::vector<catalogued_scene> select(std::vector<std::string> const& names)
+                {
+                        auto all_scenes = scenes();
+
+                        std::sort(all_scenes.begin(), all_scenes.end(),
+                                  [](auto const& a, auto const& b) { return a.name < b.name; });
+
+                        if (names.empty()) {
+                                return all_scenes;
+                        }
+
+                        std::vector<catalogued_scene> selected;
+
+                        for (auto const& name : names) {
+                                auto const has_name = [&name](auto const& s) { return s.name == name; };
+
+                                auto const it = std::find_if(all_scenes.begin(), all_scenes.end(), has_name);
+
+                                if (it == all_scenes.end()) {
+                                        LOG_ERROR("unknown scene: '%s', see --list for available scenes",
+                                                  name.c_str());
+                                        return {};
+                                }
+
+                                selected.push_back(*it);
+                        }
+
+                        return selected;
+                }
+        };
+
+} // namespace raytracer
+
+#if defined(RT_SCENE_CATALOGUE)
+#define RT_CATALOGUE_SCENE(name, world_fn, camera_fn, antialias)                                             \
+        [[maybe_unused]] static bool const rt_scene_catalogued_ =                                            \
+                raytracer::scene_catalogue::add({name, world_fn, camera_fn, antialias})
+#else
+#define RT_CATALOGUE_SCENE(name, world_fn, camera_fn, antialias) static_assert(true, "")
+#endif
@@ -1,17 +1,25 @@
 #pragma once
 
 /// c++ includes
+#include <chrono>
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 /// our includes
 #include "concurrentqueue/concurrentqueue.h"
 #include "io/canvas.hpp"
+#include "io/framebuffer.hpp"
+#include "io/pixel_costs.hpp"
+#include "io/ray_tree_trace.hpp"
 #include "io/render_params.hpp"
+#include "io/render_progress.hpp"
+#include "io/render_stats.hpp"
 #include "primitives/matrix.hpp"
 #include "primitives/ray.hpp"
 
@@ -81,6 +89,15 @@ namespace raytracer
                 /// render parameters for ease-of-use where needed
                 mutable config_render_params render_params_ = {};
 
+                /// ------------------------------------------------------------
+                /// statistics of the most recent render
+                mutable render_stats render_stats_ = {};
+
+                /// ------------------------------------------------------------
+                /// per-pixel costs of the most recent render, when requested
+                /// through 'config_render_params::heatmap(...)'
+                mutable pixel_cost_map pixel_costs_ = {};
+
             public:
                 camera(uint32_t, uint32_t, double);
                 ray_t ray_for_pixel(float, float) const;
@@ -91,6 +108,50 @@ namespace raytracer
                  **/
                 canvas render(world const&, config_render_params const& render_params = {}) const;
 
+                /*
+                 * same as above, except that statistics of the render (rays
+                 * cast, intersection tests etc.) are returned along with the
+                 * canvas.
+                 **/
+                std::pair<canvas, render_stats>
+                render_with_stats(world const&, config_render_params const& render_params = {}) const;
+
+                /*
+                 * render the world into a framebuffer of the same size as the
+                 * camera. the framebuffer's tiles are the unit of work, so the
+                 * rendering style in 'render_params' is not used.
+                 **/
+                void render(world const&, framebuffer& dst,
+                            config_render_params const& render_params = {}) const;
+
+                /*
+                 * trace all rays that color the pixel at (x, y), the way a
+                 * render with 'render_params' would (i.e. antialiased or not)
+                 * and return its ray-tree. std::nullopt when (x, y) is not on
+                 * the canvas.
+                 **/
+                std::optional<ray_tree_trace> trace_pixel(world const&, uint32_t x, uint32_t y,
+                                                          config_render_params const& = {}) const;
+
+                /*
+                 * statistics gathered during the most recent render. when
+                 * the render is benchmarked, these are from its last round.
+                 **/
+                render_stats const& last_render_stats() const
+                {
+                        return render_stats_;
+                }
+
+                /*
+                 * per-pixel costs of the most recent render. these are only
+                 * recorded when rendering to a canvas with heatmaps enabled,
+                 * and are empty otherwise.
+                 **/
+                pixel_cost_map const& last_pixel_costs() const
+                {
+                        return pixel_costs_;
+                }
+
                 std::string stringify() const;
 
             public:
@@ -127,8 +188,29 @@ namespace raytracer
                                    moodycamel::ConcurrentQueue<render_work_items>&, /// queue-of-work
                                    world const&,                                    /// scene-details
                                    canvas&,                                         /// canvas-details
+                                   std::chrono::steady_clock::time_point,           /// render-start
+                                   render_counters&,                                /// thread-stats
+                                   render_thread_times&,                            /// thread-times
+                                   pixel_cost_map&,                                 /// pixel-costs
+                                   render_progress&,                                /// progress
                                    std::unique_ptr<xcb_display>&);                  /// x11-display
 
+                /*
+                 * @brief
+                 *    same as above, except that it renders whole tiles of a
+                 *    framebuffer at a time, and completes each tile once it
+                 *    is done.
+                 **/
+                void tile_painter(int,                                            /// thread-id
+                                  moodycamel::ConcurrentQueue<framebuffer_tile>&, /// queue-of-work
+                                  world const&,                                   /// scene-details
+                                  framebuffer&,                                   /// framebuffer
+                                  std::chrono::steady_clock::time_point,          /// render-start
+                                  render_counters&,                               /// thread-stats
+                                  render_thread_times&,                           /// thread-times
+                                  render_progress&,                               /// progress
+                                  std::unique_ptr<xcb_display>&);                 /// x11-display
+
                 /*
                  * @brief
                  *    when requested, this function performs and adaptive
@@ -13,9 +13,14 @@
 
 /// c++ includes
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -27,14 +32,76 @@
 #include "concurrentqueue/concurrentqueue.h"
 #include "io/camera.hpp"
 #include "io/canvas.hpp"
+#include "io/pixel_costs.hpp"
+#include "io/ray_tree_trace.hpp"
 #include "io/render_params.hpp"
+#include "io/render_perf_counters.hpp"
+#include "io/render_progress.hpp"
+#include "io/render_stats.hpp"
 #include "io/world.hpp"
 #include "io/xcb_display.hpp"
+#include "patterns/texture_footprint.hpp"
 #include "platform_utils/thread_utils.hpp"
 #include "primitives/color.hpp"
+#include "utils/cycle_counter.hpp"
+#include "utils/execution_profiler.hpp"
+#include "utils/render_counters.hpp"
 
 namespace raytracer
 {
+        /// --------------------------------------------------------------------
+        /// convenience mostly
+        static constexpr double AA_PIXEL_DELTA = config_render_params::AA_PIXEL_DELTA;
+
+        /// --------------------------------------------------------------------
+        /// every render is a frame for the profiler
+        [[maybe_unused]] static constexpr char RENDER_FRAME_NAME[] = "camera::render";
+
+        /// --------------------------------------------------------------------
+        /// reporter of the progress of a render, when asked for one
+        static std::unique_ptr<render_progress_reporter> create_progress_reporter(
+                render_progress const& progress, config_render_params const& rendering_params)
+        {
+                if (rendering_params.progress_interval_ms() == 0) {
+                        return nullptr;
+                }
+
+                return std::make_unique<render_progress_reporter>(
+                        progress, std::chrono::milliseconds(rendering_params.progress_interval_ms()),
+                        rendering_params.progress_status_file());
+        }
+
+        /// --------------------------------------------------------------------
+        /// hardware events of the calling thread by phase of rendering, when
+        /// asked for
+        static std::unique_ptr<render_perf_counters> create_perf_counters(
+                render_phase base, config_render_params const& rendering_params)
+        {
+                if (!rendering_params.perf_counters()) {
+                        return nullptr;
+                }
+
+                return std::make_unique<render_perf_counters>(base);
+        }
+
+        /// --------------------------------------------------------------------
+        /// asking for hardware events where they cannot be counted is not
+        /// fatal, the render just has none
+        static void warn_if_perf_counters_unavailable(config_render_params const& rendering_params)
+        {
+                if (rendering_params.perf_counters() && !render_perf_counters::available()) {
+                        LOG_ERROR("hardware events cannot be counted here, see 'perf_event_paranoid'");
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// time since 'start'
+        static uint64_t nanoseconds_since(std::chrono::steady_clock::time_point start)
+        {
+                auto const elapsed = std::chrono::steady_clock::now() - start;
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        }
+
         /// --------------------------------------------------------------------
         /// this is the top-level rendering routine.
         ///
@@ -69,6 +136,144 @@ namespace raytracer
                 return rendered_canvas;
         }
 
+        /// --------------------------------------------------------------------
+        /// render 'the_world', and return the statistics of rendering along
+        /// with the canvas.
+        std::pair<canvas, render_stats>
+        camera::render_with_stats(world const& the_world, config_render_params const& rendering_params) const
+        {
+                auto rendered_canvas = render(the_world, rendering_params);
+                return {std::move(rendered_canvas), render_stats_};
+        }
+
+        /// --------------------------------------------------------------------
+        /// render 'the_world' into 'dst', a tile at a time.
+        void camera::render(world const& the_world, framebuffer& dst,
+                            config_render_params const& rendering_params) const
+        {
+                ASSERT((dst.width() == horiz_size_) && (dst.height() == vert_size_));
+                render_params_ = rendering_params;
+
+                /// ------------------------------------------------------------
+                /// framebuffers are meant for renders too large for a canvas,
+                /// so per-pixel costs are not recorded.
+                pixel_costs_ = {};
+
+                LOG_INFO("rendering parameters: '%s', framebuffer: '%s'", render_params_.stringify().c_str(),
+                         dst.stringify().c_str());
+
+                PROFILE_FRAME_START(RENDER_FRAME_NAME);
+
+                auto x11_display = [&]() -> std::unique_ptr<xcb_display> {
+                        if (render_params_.online()) {
+                                return xcb_display::create_display(horiz_size_, vert_size_);
+                        }
+
+                        return nullptr;
+                }();
+
+                warn_if_perf_counters_unavailable(render_params_);
+
+                /// ------------------------------------------------------------
+                /// tiles are rendered in row-major order
+                moodycamel::ConcurrentQueue<framebuffer_tile> work_q(dst.num_tiles_x() * dst.num_tiles_y());
+                platform_utils::perf_event_counts work_generation_events = {};
+
+                {
+                        PROFILE_SCOPE_NAMED("framebuffer work generation");
+
+                        auto perf = create_perf_counters(RENDER_PHASE_WORK_GENERATION, render_params_);
+
+                        for (uint32_t ty = 0; ty < dst.num_tiles_y(); ty++) {
+                                for (uint32_t tx = 0; tx < dst.num_tiles_x(); tx++) {
+                                        work_q.enqueue(dst.tile(tx, ty));
+                                }
+                        }
+
+                        if (perf != nullptr) {
+                                work_generation_events = perf->stop()[RENDER_PHASE_WORK_GENERATION];
+                        }
+                }
+
+                render_progress progress(uint64_t{dst.width()} * dst.height(), work_q.size_approx());
+                auto progress_reporter = create_progress_reporter(progress, render_params_);
+
+                auto const hw_threads = render_params_.hw_threads();
+                std::vector<std::thread> rendering_threads(hw_threads);
+                std::vector<render_counters> counters(hw_threads);
+                std::vector<render_thread_times> thread_times(hw_threads);
+
+                auto const render_start = std::chrono::steady_clock::now();
+
+                for (uint32_t i = 0; i < hw_threads; i++) {
+                        rendering_threads[i] = std::thread(&camera::tile_painter,     /// rendering-function
+                                                           *this,                     /// instance
+                                                           i,                         /// thread-id
+                                                           std::ref(work_q),          /// work-queue
+                                                           std::cref(the_world),      /// the world
+                                                           std::ref(dst),             /// framebuffer
+                                                           render_start,              /// render-start
+                                                           std::ref(counters[i]),     /// thread-stats
+                                                           std::ref(thread_times[i]), /// thread-times
+                                                           std::ref(progress),        /// progress
+                                                           std::ref(x11_display));    /// x11-display
+
+                        auto retval = platform_utils::thread_utils::set_thread_affinity(
+                                rendering_threads[i].native_handle(), i);
+
+                        if (retval != 0) {
+                                LOG_ERROR("failed to set affinity of thread:%d to core:%d", i, i);
+                        }
+                }
+
+                std::for_each(rendering_threads.begin(), rendering_threads.end(),
+                              std::mem_fn(&std::thread::join));
+
+                auto const wall_ns = nanoseconds_since(render_start);
+
+                progress_reporter.reset();
+
+                render_stats_ = render_stats(dst.width() * dst.height(), std::move(counters),
+                                             std::move(thread_times), wall_ns);
+                render_stats_.add_phase_events(RENDER_PHASE_WORK_GENERATION, work_generation_events);
+
+                PROFILE_FRAME_END(RENDER_FRAME_NAME);
+        }
+
+        /// --------------------------------------------------------------------
+        /// trace the rays that color a single pixel
+        std::optional<ray_tree_trace> camera::trace_pixel(world const& the_world, uint32_t x, uint32_t y,
+                                                          config_render_params const& rendering_params) const
+        {
+                if ((x >= horiz_size_) || (y >= vert_size_)) {
+                        LOG_ERROR("pixel (%u, %u) is not on the %ux%u canvas", x, y, horiz_size_, vert_size_);
+                        return std::nullopt;
+                }
+
+                double const pixel_delta = rendering_params.antialias() ? AA_PIXEL_DELTA : 0.0;
+
+                texture_footprint::pixel_spread(pixel_size_);
+
+                ray_tree_trace trace(x, y);
+
+                auto& this_thread_trace = ray_tree_trace::this_thread();
+                auto* const prev_trace  = this_thread_trace;
+                this_thread_trace       = &trace;
+
+                using nanoseconds = std::chrono::nanoseconds;
+
+                auto const start_time  = std::chrono::steady_clock::now();
+                auto const pixel_color = adaptively_color_a_pixel_at(the_world, x, y, pixel_delta);
+                auto const end_time    = std::chrono::steady_clock::now();
+
+                this_thread_trace = prev_trace;
+
+                auto const total_ns = std::chrono::duration_cast<nanoseconds>(end_time - start_time).count();
+                trace.pixel_done(pixel_color, total_ns);
+
+                return trace;
+        }
+
         /*
          * only private functions from this point onwards
          **/
@@ -79,6 +284,8 @@ namespace raytracer
         /// launches.
         canvas camera::perform_rendering(world const& the_world) const
         {
+                PROFILE_FRAME_START(RENDER_FRAME_NAME);
+
                 /// ------------------------------------------------------------
                 /// for 'show-as-we-go'
                 auto x11_display = [&]() -> std::unique_ptr<xcb_display> {
@@ -89,6 +296,13 @@ namespace raytracer
                         return nullptr;
                 }();
 
+                warn_if_perf_counters_unavailable(render_params_);
+
+                /// ------------------------------------------------------------
+                /// events of generating the work are those of this thread,
+                /// until the work-queue is ready
+                auto perf = create_perf_counters(RENDER_PHASE_WORK_GENERATION, render_params_);
+
                 /// ------------------------------------------------------------
                 /// create work-queue of 'render_work_items' using various
                 /// rendering parameters that are passed.
@@ -115,23 +329,47 @@ namespace raytracer
                         return moodycamel::ConcurrentQueue<render_work_items>{};
                 }(render_params_.render_style());
 
+                platform_utils::perf_event_counts work_generation_events = {};
+                if (perf != nullptr) {
+                        work_generation_events = perf->stop()[RENDER_PHASE_WORK_GENERATION];
+                }
+
                 /// ------------------------------------------------------------
                 /// destination canvas on which the world will be rendered.
                 auto dst_canvas = canvas::create_binary(horiz_size_, vert_size_);
 
+                /// ------------------------------------------------------------
+                /// painters record the cost of each pixel here, when asked to
+                pixel_costs_ = render_params_.heatmap() ? pixel_cost_map(horiz_size_, vert_size_)
+                                                        : pixel_cost_map();
+
+                /// ------------------------------------------------------------
+                /// painters publish their progress here, once per work item
+                render_progress progress(uint64_t{horiz_size_} * vert_size_, work_q.size_approx());
+                auto progress_reporter = create_progress_reporter(progress, render_params_);
+
                 /// ------------------------------------------------------------
                 /// let the painters ... paint !
                 auto const hw_threads = render_params_.hw_threads();
                 std::vector<std::thread> rendering_threads(hw_threads);
+                std::vector<render_counters> counters(hw_threads);
+                std::vector<render_thread_times> thread_times(hw_threads);
+
+                auto const render_start = std::chrono::steady_clock::now();
 
                 for (uint32_t i = 0; i < hw_threads; i++) {
-                        rendering_threads[i] = std::thread(&camera::pixel_painter, /// rendering-function
-                                                           *this,                  /// instance
-                                                           i,                      /// thread-id
-                                                           std::ref(work_q),       /// work-queue
-                                                           the_world,              /// the world
-                                                           std::ref(dst_canvas),   /// canvas
-                                                           std::ref(x11_display)); /// x11-display
+                        rendering_threads[i] = std::thread(&camera::pixel_painter,    /// rendering-function
+                                                           *this,                     /// instance
+                                                           i,                         /// thread-id
+                                                           std::ref(work_q),          /// work-queue
+                                                           the_world,                 /// the world
+                                                           std::ref(dst_canvas),      /// canvas
+                                                           render_start,              /// render-start
+                                                           std::ref(counters[i]),     /// thread-stats
+                                                           std::ref(thread_times[i]), /// thread-times
+                                                           std::ref(pixel_costs_),    /// pixel-costs
+                                                           std::ref(progress),        /// progress
+                                                           std::ref(x11_display));    /// x11-display
 
                         /// ----------------------------------------------------
                         /// try to force || pin threads to cores...
@@ -150,6 +388,18 @@ namespace raytracer
                 std::for_each(rendering_threads.begin(), rendering_threads.end(),
                               std::mem_fn(&std::thread::join));
 
+                auto const wall_ns = nanoseconds_since(render_start);
+
+                /// ------------------------------------------------------------
+                /// reporting the render as done
+                progress_reporter.reset();
+
+                render_stats_ = render_stats(uint64_t{horiz_size_} * vert_size_, std::move(counters),
+                                             std::move(thread_times), wall_ns);
+                render_stats_.add_phase_events(RENDER_PHASE_WORK_GENERATION, work_generation_events);
+
+                PROFILE_FRAME_END(RENDER_FRAME_NAME);
+
                 return dst_canvas;
         }
 
@@ -159,18 +409,55 @@ namespace raytracer
          **/
         void camera::pixel_painter(int thread_id, moodycamel::ConcurrentQueue<render_work_items>& work_queue,
                                    world const& W, canvas& dst_canvas,
+                                   std::chrono::steady_clock::time_point render_start,
+                                   render_counters& thread_stats, render_thread_times& thread_times,
+                                   pixel_cost_map& pixel_costs, render_progress& progress,
                                    std::unique_ptr<xcb_display>& x11_display)
         {
-                bool all_done                   = false;
-                size_t pixels_rendered          = 0;
-                size_t jobs_completed           = 0;
-                static double const pixel_delta = render_params_.antialias() ? 0.5 : 0.0;
+                bool all_done            = false;
+                size_t pixels_rendered   = 0;
+                size_t jobs_completed    = 0;
+                double const pixel_delta = render_params_.antialias() ? AA_PIXEL_DELTA : 0.0;
+                bool const record_costs  = !pixel_costs.empty();
+                uint64_t busy_ns         = 0;
+
+                /// ------------------------------------------------------------
+                /// counters are gathered for this render only
+                auto& counters = render_counters::this_thread();
+                counters       = {};
+
+                /// ------------------------------------------------------------
+                /// primary rays are a pixel wide at unit distance from the
+                /// camera. this is used for picking the mip level of textures.
+                texture_footprint::pixel_spread(pixel_size_);
+
+                /// ------------------------------------------------------------
+                /// hardware events of this thread, outside of any other phase
+                auto perf = create_perf_counters(RENDER_PHASE_OTHER, render_params_);
+
+                PROFILE_THREAD_NAME(("render-worker-" + std::to_string(thread_id)).c_str());
 
                 do {
                         render_work_items rw;
 
                         if (work_queue.try_dequeue(rw)) {
+                                /// ------------------------------------
+                                /// rays are far too many for a zone of
+                                /// their own. a work item is the finest
+                                /// grained zone there is.
+                                PROFILE_SCOPE_NAMED("render work item");
+
+                                auto const item_start_time = std::chrono::steady_clock::now();
+                                auto const item_start_rays = counters.rays();
+
                                 for (auto const& work : rw.work_list) {
+                                        /// ------------------------------------
+                                        /// cost of the pixel is the difference
+                                        /// of counters before and after it
+                                        auto const start_rays  = counters.rays();
+                                        auto const start_tests = counters.primitive_tests;
+                                        auto const start_tsc   = record_costs ? read_cycle_counter() : 0;
+
                                         /// ------------------------------------
                                         /// compute the color at (x, y) and
                                         /// update the canvas with that
@@ -180,6 +467,17 @@ namespace raytracer
                                                                                    work.y,       /// y
                                                                                    pixel_delta); /// delta
 
+                                        if (record_costs) {
+                                                auto& cost = pixel_costs.at(work.x, work.y);
+
+                                                cost.cycles = read_cycle_counter() - start_tsc;
+                                                cost.rays   = counters.rays() - start_rays;
+                                                cost.primitive_tests =
+                                                        counters.primitive_tests - start_tests;
+                                        }
+
+                                        render_perf_counters::phase_scope const output(RENDER_PHASE_OUTPUT);
+
                                         dst_canvas.write_pixel(work.x, work.y, r_color);
 
                                         if (x11_display != nullptr) {
@@ -195,17 +493,29 @@ namespace raytracer
                                         pixels_rendered += 1;
                                 }
 
+                                progress.work_item_done(rw.work_list.size(),
+                                                        counters.rays() - item_start_rays);
+                                busy_ns += nanoseconds_since(item_start_time);
                                 jobs_completed += 1;
                         }
 
                         /// ----------------------------------------------------
                         /// are there more items in work-queue ?
                         auto items_in_q = work_queue.size_approx();
+                        PROFILE_PLOT("render work-queue depth", items_in_q);
+
                         if (items_in_q == 0) {
                                 all_done = true;
                         }
                 } while (!all_done);
 
+                if (perf != nullptr) {
+                        counters.phase_events = perf->stop();
+                }
+
+                thread_stats = counters;
+                thread_times = {busy_ns, nanoseconds_since(render_start)};
+
                 /// ------------------------------------------------------------
                 /// this thread is done. dump some stats...
                 LOG_DEBUG("thread: %d done, pixels rendered: %ld, total jobs: %ld",
@@ -216,10 +526,84 @@ namespace raytracer
                 return;
         }
 
+        /*
+         * this function renders whole tiles of a framebuffer picked from a
+         * concurrent queue
+         **/
+        void camera::tile_painter(int thread_id, moodycamel::ConcurrentQueue<framebuffer_tile>& work_queue,
+                                  world const& W, framebuffer& dst,
+                                  std::chrono::steady_clock::time_point render_start,
+                                  render_counters& thread_stats, render_thread_times& thread_times,
+                                  render_progress& progress, std::unique_ptr<xcb_display>& x11_display)
+        {
+                size_t tiles_rendered    = 0;
+                double const pixel_delta = render_params_.antialias() ? AA_PIXEL_DELTA : 0.0;
+                uint64_t busy_ns         = 0;
+
+                auto& counters = render_counters::this_thread();
+                counters       = {};
+
+                texture_footprint::pixel_spread(pixel_size_);
+
+                auto perf = create_perf_counters(RENDER_PHASE_OTHER, render_params_);
+
+                PROFILE_THREAD_NAME(("render-worker-" + std::to_string(thread_id)).c_str());
+
+                framebuffer_tile t;
+                while (work_queue.try_dequeue(t)) {
+                        PROFILE_SCOPE_NAMED("render tile");
+                        PROFILE_PLOT("render work-queue depth", work_queue.size_approx());
+
+                        auto const tile_start_time = std::chrono::steady_clock::now();
+                        auto const tile_start_rays = counters.rays();
+
+                        for (uint32_t y = t.y_begin; y < t.y_end; y++) {
+                                for (uint32_t x = t.x_begin; x < t.x_end; x++) {
+                                        auto r_color = adaptively_color_a_pixel_at(W, x, y, pixel_delta);
+
+                                        render_perf_counters::phase_scope const output(RENDER_PHASE_OUTPUT);
+
+                                        dst.write_pixel(x, y, r_color);
+
+                                        if (x11_display != nullptr) {
+                                                x11_display->plot_pixel(x, y, r_color.rgb_u32());
+                                        }
+                                }
+                        }
+
+                        dst.tile_complete(t);
+                        tiles_rendered += 1;
+
+                        progress.work_item_done(uint64_t{t.x_end - t.x_begin} * (t.y_end - t.y_begin),
+                                                counters.rays() - tile_start_rays);
+                        busy_ns += nanoseconds_since(tile_start_time);
+
+                        PROFILE_PLOT("framebuffer tiles done", dst.tiles_completed());
+                }
+
+                if (perf != nullptr) {
+                        counters.phase_events = perf->stop();
+                }
+
+                thread_stats = counters;
+                thread_times = {busy_ns, nanoseconds_since(render_start)};
+
+                LOG_DEBUG("thread: %d done, tiles rendered: %zu", thread_id, tiles_rendered);
+        }
+
         /// --------------------------------------------------------------------
         /// adaptively compute pixel color at a specific point (x, y).
         color camera::adaptively_color_a_pixel_at(world const& W, double x, double y, double delta) const
         {
+                /// ------------------------------------------------------------
+                /// account for the sample at its depth of subdivision, 0 being
+                /// the whole pixel. (delta == 0) when antialiasing is disabled.
+                if (delta > 0.0) {
+                        auto const aa_depth = std::min<size_t>(std::ilogb(AA_PIXEL_DELTA / delta),
+                                                               render_counters::MAX_AA_DEPTH - 1);
+                        render_counters::this_thread().aa_samples[aa_depth] += 1;
+                }
+
                 /// ------------------------------------------------------------
                 /// break out of recursion. we have reached the desired
                 /// color-difference.
@@ -227,6 +611,8 @@ namespace raytracer
                         return pixel_color_at(W, x, y);
                 }
 
+                render_perf_counters::phase_scope const aa_phase(RENDER_PHASE_ANTIALIASING);
+
                 /*
                  * 4-corners + 1-center, for a total of 5 points per pixel
                  * (marked by 'x' in the ascii-art below) whose colors we are
@@ -290,7 +676,15 @@ namespace raytracer
         /// simple computation of pixel color at a specific point (x,y)
         color camera::pixel_color_at(world const& W, double x, double y) const
         {
-                return W.color_at(ray_for_pixel(x, y));
+                render_counters::this_thread().primary_rays += 1;
+
+                auto const primary_ray = ray_for_pixel(x, y);
+                ray_tree_trace::scope const trace_ray(traced_ray_kind::TRACED_RAY_PRIMARY, primary_ray);
+
+                auto const pixel_color = W.color_at(primary_ray);
+                ray_tree_trace::note_color(pixel_color);
+
+                return pixel_color;
         }
 
         /// --------------------------------------------------------------------
@@ -298,20 +692,27 @@ namespace raytracer
         /// order.
         moodycamel::ConcurrentQueue<render_work_items> camera::scanline_work_queue() const
         {
+                PROFILE_SCOPE;
+
                 /*
                  * an instance of 'render_work_items' has 'PIXELS_PER_WORK_ITEM'
-                 * worth of pixels that will be rendered at a time.
+                 * worth of pixels that will be rendered at a time, unless the
+                 * rendering parameters ask for some other size.
                  *
                  * each thread picks a new 'work_item' from the work-queue once
                  * it is done with the current one.
                  **/
                 static constexpr uint32_t PIXELS_PER_WORK_ITEM = 256;
 
+                const long pixels_per_work_item = (render_params_.work_item_pixels() != 0)
+                                                          ? render_params_.work_item_pixels()
+                                                          : PIXELS_PER_WORK_ITEM;
+
                 const long total_pixel_count        = horiz_size_ * vert_size_;
-                const auto work_items_and_remainder = std::div(total_pixel_count, PIXELS_PER_WORK_ITEM);
+                const auto work_items_and_remainder = std::div(total_pixel_count, pixels_per_work_item);
 
                 const auto total_work_items =
-                        (work_items_and_remainder.quot + work_items_and_remainder.rem ? 1 : 0);
+                        (work_items_and_remainder.quot + (work_items_and_remainder.rem ? 1 : 0));
 
                 uint32_t x_pixel = 0;
                 uint32_t y_pixel = 0;
@@ -323,19 +724,19 @@ namespace raytracer
                 /// ------------------------------------------------------------
                 /// integer division worth items first
                 render_work_items work_item;
-                const long int_div_pixels = work_items_and_remainder.quot * PIXELS_PER_WORK_ITEM;
+                const long int_div_pixels = work_items_and_remainder.quot * pixels_per_work_item;
                 for (uint32_t pixel_count = 0; pixel_count < int_div_pixels; pixel_count++) {
+                        render_work_item tmp{double(x_pixel), double(y_pixel)};
+                        work_item.work_list.emplace_back(tmp);
+
                         /// ----------------------------------------------------
                         /// we now have pixels for a single work-item, add it to
                         /// the work-queue.
-                        if ((pixel_count % PIXELS_PER_WORK_ITEM) == 0) {
+                        if (long(work_item.work_list.size()) == pixels_per_work_item) {
                                 wq.enqueue(work_item);
                                 work_item.work_list.clear();
                         }
 
-                        render_work_item tmp{double(x_pixel), double(y_pixel)};
-                        work_item.work_list.emplace_back(tmp);
-
                         /// ----------------------------------------------------
                         /// scanline processing of pixels making up this image
                         x_pixel += 1;
@@ -353,12 +754,20 @@ namespace raytracer
                         straggler_work_item.work_list.emplace_back(tmp);
 
                         x_pixel += 1;
+                        if (x_pixel >= horiz_size_) {
+                                x_pixel = 0;
+                                y_pixel += 1;
+                        }
+                }
+
+                if (!straggler_work_item.work_list.empty()) {
+                        wq.enqueue(straggler_work_item);
                 }
-                wq.enqueue(straggler_work_item);
 
                 LOG_INFO("scanline-work-queue info: "
-                         "total-threads: {%d}, pixels-per-thread: {%d}, work-queue length: {%ld} (approx.)",
-                         render_params_.hw_threads(), PIXELS_PER_WORK_ITEM, wq.size_approx());
+                         "total-threads: {%d}, pixels-per-work-item: {%ld}, "
+                         "work-queue length: {%ld} (approx.)",
+                         render_params_.hw_threads(), pixels_per_work_item, wq.size_approx());
 
                 return wq;
         }
@@ -368,6 +777,8 @@ namespace raytracer
         /// order.
         moodycamel::ConcurrentQueue<render_work_items> camera::scanline_work_queue_1() const
         {
+                PROFILE_SCOPE;
+
                 uint32_t const total_pixels_per_thread = horiz_size_ / render_params_.hw_threads();
                 uint32_t const total_work_items = (horiz_size_ / total_pixels_per_thread) * (vert_size_);
 
@@ -405,6 +816,8 @@ namespace raytracer
         /// hilbert-curve order.
         moodycamel::ConcurrentQueue<render_work_items> camera::hilbert_work_queue() const
         {
+                PROFILE_SCOPE;
+
                 auto rot = [](uint32_t n, uint32_t& x, uint32_t& y, uint32_t rx, uint32_t ry) -> void {
                         if (ry == 0) {
                                 if (rx == 1) {
@@ -462,9 +875,13 @@ namespace raytracer
                 const uint32_t max_hilbert_index = (max_n * max_n);
 
                 /// ------------------------------------------------------------
-                /// each thread gets to work with 'pixels_per_thread' number of
-                /// points on the hilbert curve
-                const uint32_t pixels_per_thread = (horiz_size_ * vert_size_) / 256;
+                /// each work item has 'pixels_per_work_item' number of points
+                /// on the hilbert curve. by default, the curve is split into
+                /// 256 work items.
+                const uint32_t pixels_per_work_item =
+                        (render_params_.work_item_pixels() != 0)
+                                ? render_params_.work_item_pixels()
+                                : std::max<uint32_t>((horiz_size_ * vert_size_) / 256, 1);
 
                 moodycamel::ConcurrentQueue<render_work_items> wq(horiz_size_ * vert_size_);
 
@@ -472,12 +889,14 @@ namespace raytracer
                 /// now create work-items from points on this curve
                 for (uint32_t hilbert_index = min_hilbert_index; hilbert_index < max_hilbert_index;) {
                         render_work_items work_item;
+                        work_item.work_list.reserve(pixels_per_work_item);
 
-                        for (uint32_t i = 0; i < pixels_per_thread; i++, hilbert_index++) {
+                        while ((work_item.work_list.size() < pixels_per_work_item) &&
+                               (hilbert_index < max_hilbert_index)) {
                                 uint32_t hilbert_x = 0;
                                 uint32_t hilbert_y = 0;
 
-                                conv_hilbert_index_to_xy(max_n, hilbert_index, hilbert_x, hilbert_y);
+                                conv_hilbert_index_to_xy(max_n, hilbert_index++, hilbert_x, hilbert_y);
 
                                 /// --------------------------------------------
                                 /// ignore points outside the range. '- 1'
@@ -487,19 +906,22 @@ namespace raytracer
                                 }
 
                                 render_work_item tmp{
-                                        double(hilbert_x + i), /// x-pixel
-                                        double(hilbert_y)      /// y-pixel
+                                        double(hilbert_x), /// x-pixel
+                                        double(hilbert_y)  /// y-pixel
                                 };
 
                                 work_item.work_list.emplace_back(tmp);
                         }
 
-                        wq.enqueue(work_item);
+                        if (!work_item.work_list.empty()) {
+                                wq.enqueue(work_item);
+                        }
                 }
 
                 LOG_INFO("hilbert-curve work-queue info: "
-                         "total-threads: {%d}, pixels-per-thread: {%d}, work-queue-length: {%ld} (approx.)",
-                         render_params_.hw_threads(), pixels_per_thread, wq.size_approx());
+                         "total-threads: {%d}, pixels-per-work-item: {%d}, "
+                         "work-queue-length: {%ld} (approx.)",
+                         render_params_.hw_threads(), pixels_per_work_item, wq.size_approx());
 
                 return wq;
         }
@@ -509,26 +931,37 @@ namespace raytracer
         /// order.
         moodycamel::ConcurrentQueue<render_work_items> camera::tile_work_queue() const
         {
+                PROFILE_SCOPE;
+
                 /*
-                 * tile dimensions
+                 * tile dimensions. by default, each side of the canvas is
+                 * split into as many tiles as there are threads. otherwise
+                 * tiles are (about) square, with as many pixels as asked for.
                  **/
-                auto const hw_threads     = render_params_.hw_threads();
-                uint16_t const tile_dim_x = horiz_size_ / hw_threads;
-                uint16_t const tile_dim_y = vert_size_ / hw_threads;
+                auto const hw_threads       = render_params_.hw_threads();
+                auto const work_item_pixels = render_params_.work_item_pixels();
+                uint32_t const tile_side    = std::lround(std::sqrt(double(work_item_pixels)));
+
+                uint32_t const tile_dim_x = std::max<uint32_t>(
+                        (work_item_pixels != 0) ? tile_side : (horiz_size_ / hw_threads), 1);
+                uint32_t const tile_dim_y = std::max<uint32_t>(
+                        (work_item_pixels != 0) ? tile_side : (vert_size_ / hw_threads), 1);
 
                 /// ------------------------------------------------------------
                 /// tiles create a (X, Y) grid over the entire canvas. this
                 /// function is called to generate rendering work for a tile
-                /// located at a specific row (R) and a specific column (C)
+                /// located at a specific row (R) and a specific column (C).
+                /// tiles on the right and bottom edges are clipped to the
+                /// canvas.
                 auto const gen_tile_xy_work = [&](uint32_t R, uint32_t C) -> render_work_items {
                         uint32_t const start_x = C * tile_dim_x;
-                        uint32_t const end_x   = start_x + tile_dim_x;
+                        uint32_t const end_x   = std::min(start_x + tile_dim_x, horiz_size_);
 
                         uint32_t const start_y = R * tile_dim_y;
-                        uint32_t const end_y   = start_y + tile_dim_y;
+                        uint32_t const end_y   = std::min(start_y + tile_dim_y, vert_size_);
 
                         render_work_items work_item;
-                        work_item.work_list.reserve(tile_dim_x * tile_dim_y);
+                        work_item.work_list.reserve((end_x - start_x) * (end_y - start_y));
 
                         for (uint32_t y = start_y; y < end_y; y++) {
                                 for (uint32_t x = start_x; x < end_x; x++) {
@@ -547,8 +980,8 @@ namespace raytracer
                 /// ------------------------------------------------------------
                 /// in the ensuing 'tile-matrix' how many rows + column are
                 /// there.
-                uint32_t const num_rows    = vert_size_ / tile_dim_y;
-                uint32_t const num_cols    = horiz_size_ / tile_dim_x;
+                uint32_t const num_rows    = (vert_size_ + tile_dim_y - 1) / tile_dim_y;
+                uint32_t const num_cols    = (horiz_size_ + tile_dim_x - 1) / tile_dim_x;
                 uint32_t const total_tiles = num_cols * num_rows;
 
                 moodycamel::ConcurrentQueue<render_work_items> wq(total_tiles);
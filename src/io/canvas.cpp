@@ -6,8 +6,6 @@
 
 /// c++ includes
 #include <cstddef>
-#include <math.h>
-#include <memory>
 #include <sstream>
 #include <string>
 
@@ -17,9 +15,6 @@
 
 namespace raytracer
 {
-        /// convenience
-        using ppm_row_data_t = std::unique_ptr<unsigned char[]>;
-
         /// --------------------------------------------------------------------
         /// stringified representation of canvas-type instance
         static inline constexpr const char* stringify_canvas_enum(canvas_type ct)
@@ -98,39 +93,26 @@ namespace raytracer
         }
 
         /// --------------------------------------------------------------------
-        /// convert canvas 'color' to equivalent ppm values
-        void canvas::ppm_color_at(size_t x,               /// x-location
-                                  size_t y,               /// y-location
-                                  unsigned char& r,       /// r (0..255)
-                                  unsigned char& g,       /// g (0..255)
-                                  unsigned char& b) const /// b (0..255)
-        {
-                auto pixel_color = this->read_pixel(x, y);
-
-                r = roundf(clamp_in_range(pixel_color.R(), 0.0f, 1.0f) * 255.0);
-                g = roundf(clamp_in_range(pixel_color.G(), 0.0f, 1.0f) * 255.0);
-                b = roundf(clamp_in_range(pixel_color.B(), 0.0f, 1.0f) * 255.0);
-
-                return;
-        }
-
-        /// --------------------------------------------------------------------
-        /// get ppm encoded row of values
-        ppm_row_data_t canvas::get_ppm_row(size_t y) const
+        /// convert canvas colors to equivalent ppm values. this is a single,
+        /// branch-free pass over the whole framebuffer, which the compiler is
+        /// free to vectorize.
+        void canvas::ppm_encode(unsigned char* dst) const
         {
-                auto ppm_colors     = std::make_unique<unsigned char[]>(ppm_num_values());
-                auto ppm_colors_buf = ppm_colors.get();
-
-                for (size_t i = 0, x = 0; i < ppm_num_values(); x++) {
-                        ppm_color_at(x, y,
-                                     ppm_colors_buf[i + 0],  /// r
-                                     ppm_colors_buf[i + 1],  /// g
-                                     ppm_colors_buf[i + 2]); /// b
-
-                        i += 3;
+                auto const num_pixels = this->buf_.size();
+                auto const* src       = this->buf_.data();
+
+                /// ------------------------------------------------------------
+                /// values are clamped to [0.0 .. 1.0], so adding 0.5 and
+                /// truncating is the same as rounding here.
+                auto to_ppm_value = [](float v) -> unsigned char {
+                        return static_cast<unsigned char>(clamp_in_range(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+                };
+
+                for (size_t i = 0; i < num_pixels; i++) {
+                        dst[3 * i + 0] = to_ppm_value(src[i].R());
+                        dst[3 * i + 1] = to_ppm_value(src[i].G());
+                        dst[3 * i + 2] = to_ppm_value(src[i].B());
                 }
-
-                return ppm_colors;
         }
 
 } // namespace raytracer
@@ -7,6 +7,9 @@
  * canvas generates images in the ppm (portable pixmap) format. specifically
  * both ppm3 (ascii) and ppm6 (binary) encoded images are supported.
  *
+ * png (8-bit rgb) and pfm (32-bit float rgb) images can be generated as well,
+ * and are selected by the extension of the file being written.
+ *
  * x11 based renderer can be brought to bear (beer ?) for 'online'
  * visualization as well.
  **/
@@ -96,7 +99,10 @@ namespace raytracer
                 /// meta information about the canvas
                 std::string stringify() const;
 
-                /// save canvas to a persistent store
+                /// ------------------------------------------------------------
+                /// save canvas to a persistent store. files ending in '.png'
+                /// and '.pfm' are written as png and pfm images respectively,
+                /// everything else as a ppm image of the canvas type.
                 void write(std::string const& fname) const;
 
             private:
@@ -109,6 +115,13 @@ namespace raytracer
                         return width() * 3;
                 }
 
+            private:
+                /// ------------------------------------------------------------
+                /// rasters smaller than these are not worth a thread of their
+                /// own when being read
+                static constexpr size_t PPM_PARALLEL_MIN_PIXELS = 256 * 1024;
+                static constexpr size_t PPM_PARALLEL_MIN_BYTES  = 1024 * 1024;
+
             private:
                 /// ------------------------------------------------------------
                 /// ∵ named-constructor idiom
@@ -119,11 +132,24 @@ namespace raytracer
                 /// save the to a persistent store
                 void write_binary(std::string const&) const;
                 void write_ascii(std::string const&) const;
+                void write_png(std::string const&) const;
+                void write_pfm(std::string const&) const;
 
-                void ppm_color_at(size_t x, size_t y, unsigned char& r, unsigned char& g,
-                                  unsigned char& b) const;
+                /// ------------------------------------------------------------
+                /// convert the whole canvas to 8-bit ppm values (r, g, b per
+                /// pixel, row-major) in a single pass. 'dst' must have room
+                /// for 'height() * ppm_num_values()' bytes.
+                void ppm_encode(unsigned char* dst) const;
 
-                std::unique_ptr<unsigned char[]> get_ppm_row(size_t y) const;
+                /// ------------------------------------------------------------
+                /// decode a ppm raster of 'num_pixels' pixels at 'data' into
+                /// 'dst'. returns 'false' on bogus or insufficient data.
+                static bool ppm_read_binary_raster(char const* data, size_t data_size, uint32_t color_scale,
+                                                   size_t num_pixels, color* dst);
+                static bool ppm_read_ascii_raster(char const* data, size_t data_size, uint32_t color_scale,
+                                                  size_t num_pixels, color* dst);
+                static bool ppm_tokenize_ascii_samples(char const* data, size_t data_size,
+                                                       std::vector<uint32_t>& samples);
         };
 
 } // namespace raytracer
@@ -0,0 +1,75 @@
+/*
+ * implement the raytracer canvas pfm (portable float map) writer
+ **/
+
+/// c++ includes
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "io/canvas.hpp"
+
+namespace raytracer
+{
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// save canvas data as an rgb pfm image. unlike the other formats, the
+        /// colors are written as is i.e. neither clamped nor quantized.
+        void canvas::write_pfm(std::string const& fname) const
+        {
+                FILE* dst_file = fopen(fname.c_str(), "wb");
+
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
+                        return;
+                }
+
+                /// ------------------------------------------------------------
+                /// step-1: add image header. a negative scale implies that the
+                /// floats are little-endian, positive one implies big-endian.
+                uint16_t const endian_probe = 1;
+                bool const is_little_endian = (*reinterpret_cast<uint8_t const*>(&endian_probe) == 1);
+
+                fprintf(dst_file,
+                        "PF\n"
+                        "%zu %zu\n" /// x-y dimensions
+                        "%s\n"      /// scale + endianness
+                        ,           /// --values--
+                        this->width_, this->height_, is_little_endian ? "-1.0" : "1.0");
+
+                /// ------------------------------------------------------------
+                /// step-2: add image data. pfm rows are stored bottom-to-top
+                std::vector<float> pfm_data;
+                pfm_data.reserve(this->width_ * this->height_ * 3);
+
+                for (size_t y = this->height_; y-- > 0;) {
+                        for (size_t x = 0; x < this->width_; x++) {
+                                auto const& c = this->buf_[x + y * this->width_];
+
+                                pfm_data.push_back(c.R());
+                                pfm_data.push_back(c.G());
+                                pfm_data.push_back(c.B());
+                        }
+                }
+
+                if (fwrite(pfm_data.data(), sizeof(float), pfm_data.size(), dst_file) != pfm_data.size()) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
+                }
+
+                /// ok, we are done here
+                fflush(dst_file);
+                fclose(dst_file);
+
+                return;
+        }
+
+} // namespace raytracer
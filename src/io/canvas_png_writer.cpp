@@ -0,0 +1,206 @@
+/*
+ * implement the raytracer canvas png writer
+ **/
+
+/// c++ includes
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "io/canvas.hpp"
+#include "io/deflate.hpp"
+#include "utils/utils.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// png row filter types
+        enum png_filter_type : uint8_t {
+                PNG_FILTER_NONE    = 0,
+                PNG_FILTER_SUB     = 1,
+                PNG_FILTER_UP      = 2,
+                PNG_FILTER_AVERAGE = 3,
+                PNG_FILTER_PAETH   = 4,
+                PNG_FILTER_MAX     = 5,
+        };
+
+        /// --------------------------------------------------------------------
+        /// compressed image data is split into 'IDAT' chunks of atmost this
+        /// size, which keeps memory bounded for readers that buffer a chunk
+        /// at a time
+        constexpr size_t PNG_MAX_IDAT_SIZE = 256 * 1024;
+
+        /// --------------------------------------------------------------------
+        /// paeth predictor (png specification, 9.4)
+        static inline uint8_t png_paeth(uint8_t a, uint8_t b, uint8_t c)
+        {
+                int32_t const p  = a + b - c;
+                int32_t const pa = std::abs(p - a);
+                int32_t const pb = std::abs(p - b);
+                int32_t const pc = std::abs(p - c);
+
+                if ((pa <= pb) && (pa <= pc)) {
+                        return a;
+                }
+
+                return (pb <= pc) ? b : c;
+        }
+
+        /// --------------------------------------------------------------------
+        /// filter a row with 'filter', with 'prev' being the previous
+        /// (unfiltered) row or nullptr for the first one
+        static void png_filter_row(png_filter_type filter, uint8_t const* row, uint8_t const* prev,
+                                   size_t row_len, uint8_t* dst)
+        {
+                constexpr size_t BPP = 3; /// bytes per pixel
+
+                for (size_t i = 0; i < row_len; i++) {
+                        uint8_t const a = (i >= BPP) ? row[i - BPP] : 0;
+                        uint8_t const b = (prev != nullptr) ? prev[i] : 0;
+                        uint8_t const c = ((i >= BPP) && (prev != nullptr)) ? prev[i - BPP] : 0;
+
+                        switch (filter) {
+                        case PNG_FILTER_SUB:
+                                dst[i] = row[i] - a;
+                                break;
+
+                        case PNG_FILTER_UP:
+                                dst[i] = row[i] - b;
+                                break;
+
+                        case PNG_FILTER_AVERAGE:
+                                dst[i] = row[i] - ((a + b) >> 1);
+                                break;
+
+                        case PNG_FILTER_PAETH:
+                                dst[i] = row[i] - png_paeth(a, b, c);
+                                break;
+
+                        default:
+                                dst[i] = row[i];
+                                break;
+                        }
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// write a png chunk i.e. length, type, data and crc
+        static void png_write_chunk(std::vector<uint8_t>& out, char const* type, uint8_t const* data, size_t len)
+        {
+                auto put_u32 = [&out](uint32_t v) {
+                        out.push_back(static_cast<uint8_t>(v >> 24));
+                        out.push_back(static_cast<uint8_t>(v >> 16));
+                        out.push_back(static_cast<uint8_t>(v >> 8));
+                        out.push_back(static_cast<uint8_t>(v >> 0));
+                };
+
+                put_u32(static_cast<uint32_t>(len));
+
+                size_t const crc_start = out.size();
+                out.insert(out.end(), type, type + 4);
+                out.insert(out.end(), data, data + len);
+
+                put_u32(crc32(0, out.data() + crc_start, len + 4));
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// save canvas data as an 8-bit rgb png image
+        void canvas::write_png(std::string const& fname) const
+        {
+                FILE* dst_file = fopen(fname.c_str(), "wb");
+
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
+                        return;
+                }
+
+                /// ------------------------------------------------------------
+                /// step-1: convert the whole image in one go
+                size_t const row_len = ppm_num_values();
+                std::vector<uint8_t> rgb_data(this->height_ * row_len);
+                ppm_encode(rgb_data.data());
+
+                /// ------------------------------------------------------------
+                /// step-2: filter each row. the filter with the smallest sum of
+                /// absolute (signed) differences is chosen, which is the
+                /// heuristic recommended by the png specification.
+                std::vector<uint8_t> filtered_data(this->height_ * (row_len + 1));
+                std::vector<uint8_t> candidate(row_len);
+
+                for (size_t y = 0; y < this->height_; y++) {
+                        uint8_t const* row  = rgb_data.data() + y * row_len;
+                        uint8_t const* prev = (y > 0) ? (row - row_len) : nullptr;
+                        uint8_t* dst        = filtered_data.data() + y * (row_len + 1);
+
+                        uint64_t best_cost = UINT64_MAX;
+
+                        for (uint8_t f = PNG_FILTER_NONE; f < PNG_FILTER_MAX; f++) {
+                                png_filter_row(static_cast<png_filter_type>(f), row, prev, row_len,
+                                               candidate.data());
+
+                                uint64_t cost = 0;
+                                for (auto v : candidate) {
+                                        cost += std::abs(static_cast<int8_t>(v));
+                                }
+
+                                if (cost < best_cost) {
+                                        best_cost = cost;
+                                        dst[0]    = f;
+                                        std::copy(candidate.begin(), candidate.end(), dst + 1);
+                                }
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// step-3: assemble the image, compressing the filtered rows
+                /// using all cores
+                std::vector<uint8_t> png_data = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+                // clang-format off
+                uint8_t const ihdr[13] = {
+                        static_cast<uint8_t>(this->width_ >> 24), static_cast<uint8_t>(this->width_ >> 16),
+                        static_cast<uint8_t>(this->width_ >> 8),  static_cast<uint8_t>(this->width_ >> 0),
+                        static_cast<uint8_t>(this->height_ >> 24), static_cast<uint8_t>(this->height_ >> 16),
+                        static_cast<uint8_t>(this->height_ >> 8),  static_cast<uint8_t>(this->height_ >> 0),
+                        8, /// bit-depth
+                        2, /// color-type: rgb
+                        0, /// compression: deflate
+                        0, /// filter: adaptive
+                        0, /// interlace: none
+                };
+                // clang-format on
+
+                png_write_chunk(png_data, "IHDR", ihdr, sizeof(ihdr));
+
+                auto const idat = zlib_compress(filtered_data.data(), filtered_data.size(), max_cores());
+                for (size_t i = 0; i < idat.size(); i += PNG_MAX_IDAT_SIZE) {
+                        auto const n = std::min(PNG_MAX_IDAT_SIZE, idat.size() - i);
+                        png_write_chunk(png_data, "IDAT", idat.data() + i, n);
+                }
+
+                png_write_chunk(png_data, "IEND", nullptr, 0);
+
+                if (fwrite(png_data.data(), sizeof(uint8_t), png_data.size(), dst_file) != png_data.size()) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
+                }
+
+                /// ok, we are done here
+                fflush(dst_file);
+                fclose(dst_file);
+
+                return;
+        }
+
+} // namespace raytracer
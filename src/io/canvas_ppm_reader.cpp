@@ -3,12 +3,17 @@
  **/
 
 /// c++ includes
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
 #include <optional>
 #include <sstream>
 #include <stdint.h>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 /// our includes
 #include "io/canvas.hpp"
@@ -302,31 +307,248 @@ namespace raytracer
                 }
 
                 /// --------------------------------------------------------------------
-                /// step-02: process image-raster
-                if (img_header.is_ascii()) {
-                        canvas ppm_img_retval =
-                                canvas::create_ascii(img_header.width.data, img_header.height.data);
+                /// step-02: process image-raster, directly into the canvas
+                /// pixel buffer
+                size_t const num_pixels = size_t{img_header.width.data} * img_header.height.data;
+
+                canvas ppm_img_retval =
+                        img_header.is_ascii()
+                                ? canvas::create_ascii(img_header.width.data, img_header.height.data)
+                                : canvas::create_binary(img_header.width.data, img_header.height.data);
+
+                bool const raster_ok =
+                        img_header.is_ascii()
+                                ? ppm_read_ascii_raster(ppm_file_data + ci, ei - ci, img_header.color_scale.data,
+                                                        num_pixels, ppm_img_retval.buf_.data())
+                                : ppm_read_binary_raster(ppm_file_data + ci, ei - ci, img_header.color_scale.data,
+                                                         num_pixels, ppm_img_retval.buf_.data());
+
+                if (!raster_ok) {
+                        return std::nullopt;
+                }
+
+                return ppm_img_retval;
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// split [0 .. num_items) into (atmost) one range per core, with each
+        /// range having atleast 'min_items', and invoke 'fn(begin, end)' for
+        /// each of those concurrently.
+        template <typename Fn>
+        static void ppm_parallel_for(size_t num_items, size_t min_items, Fn&& fn)
+        {
+                size_t const max_ranges = std::max<size_t>(1, num_items / std::max<size_t>(min_items, 1));
+                size_t const num_ranges = std::clamp<size_t>(max_cores(), 1, max_ranges);
+                size_t const range_size = (num_items + num_ranges - 1) / num_ranges;
+
+                if (num_ranges == 1) {
+                        fn(size_t{0}, num_items);
+                        return;
+                }
+
+                std::vector<std::thread> workers;
+                for (size_t i = 0; i < num_ranges; i++) {
+                        size_t const begin = std::min(num_items, i * range_size);
+                        size_t const end   = std::min(num_items, begin + range_size);
+
+                        workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+                }
+
+                for (auto& w : workers) {
+                        w.join();
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// lookup table for converting 8-bit samples to [0.0 .. 1.0]
+        static std::array<float, 256> ppm_sample_lut(uint32_t color_scale)
+        {
+                std::array<float, 256> lut;
+
+                for (uint32_t i = 0; i < lut.size(); i++) {
+                        lut[i] = (1.0 * i) / (1.0 * color_scale);
+                }
+
+                return lut;
+        }
 
-                        for (size_t y = 0; y < img_header.height.data; y++) {
-                                for (size_t x = 0; x < img_header.width.data; x++) {
-                                        float const r_value = (1.0 * READ_NEXT_UINT_TOKEN("R pixel")) /
-                                                              (1.0 * img_header.color_scale.data);
+        /// --------------------------------------------------------------------
+        /// this function is called to decode a P6 raster i.e. 'num_pixels' rgb
+        /// byte triplets into 'dst'. rows are decoded concurrently.
+        bool canvas::ppm_read_binary_raster(char const* data, size_t data_size, uint32_t color_scale,
+                                            size_t num_pixels, color* dst)
+        {
+                if (data_size < num_pixels * 3) {
+                        return false;
+                }
 
-                                        float const g_value = (1.0 * READ_NEXT_UINT_TOKEN("G pixel")) /
-                                                              (1.0 * img_header.color_scale.data);
+                auto const lut    = ppm_sample_lut(color_scale);
+                auto const* bytes = reinterpret_cast<uint8_t const*>(data);
 
-                                        float const b_value = (1.0 * READ_NEXT_UINT_TOKEN("B pixel")) /
-                                                              (1.0 * img_header.color_scale.data);
+                ppm_parallel_for(num_pixels, PPM_PARALLEL_MIN_PIXELS, [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; i++) {
+                                auto const* rgb = bytes + 3 * i;
+                                dst[i]          = color(lut[rgb[0]], lut[rgb[1]], lut[rgb[2]]);
+                        }
+                });
 
-                                        color const pixel_color{r_value, g_value, b_value};
-                                        ppm_img_retval.write_pixel(x, y, pixel_color);
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to decode a P3 raster i.e. 'num_pixels' rgb
+        /// ascii-value triplets into 'dst'.
+        ///
+        /// the raster is split into chunks at line boundaries (so that no
+        /// chunk starts in the middle of a token or a comment), which are
+        /// tokenized concurrently, and then converted, again concurrently,
+        /// straight into their pixels.
+        bool canvas::ppm_read_ascii_raster(char const* data, size_t data_size, uint32_t color_scale,
+                                           size_t num_pixels, color* dst)
+        {
+                /// ------------------------------------------------------------
+                /// chunk boundaries, always just after a '\n'
+                size_t const max_chunks = std::max<size_t>(1, data_size / PPM_PARALLEL_MIN_BYTES);
+                size_t const num_chunks = std::clamp<size_t>(max_cores(), 1, max_chunks);
+
+                std::vector<size_t> chunk_start = {0};
+                for (size_t i = 1; i < num_chunks; i++) {
+                        size_t pos = std::max(chunk_start.back(), (data_size / num_chunks) * i);
+                        auto nl    = static_cast<char const*>(memchr(data + pos, '\n', data_size - pos));
+
+                        if (nl == nullptr) {
+                                break;
+                        }
+
+                        chunk_start.push_back((nl - data) + 1);
+                }
+                chunk_start.push_back(data_size);
+
+                /// ------------------------------------------------------------
+                /// tokenize all the chunks
+                size_t const n = chunk_start.size() - 1;
+                std::vector<std::vector<uint32_t>> chunk_samples(n);
+                std::vector<uint8_t> chunk_ok(n, 0);
+
+                ppm_parallel_for(n, 1, [&](size_t begin, size_t end) {
+                        for (size_t c = begin; c < end; c++) {
+                                chunk_ok[c] = ppm_tokenize_ascii_samples(data + chunk_start[c],
+                                                                         chunk_start[c + 1] - chunk_start[c],
+                                                                         chunk_samples[c]);
+                        }
+                });
+
+                /// ------------------------------------------------------------
+                /// offset of the first sample of each chunk in the raster.
+                /// samples beyond the ones we need are ignored.
+                size_t const num_samples = num_pixels * 3;
+
+                std::vector<size_t> sample_start(n + 1, 0);
+                for (size_t c = 0; c < n; c++) {
+                        if ((sample_start[c] < num_samples) && !chunk_ok[c]) {
+                                return false;
+                        }
+
+                        sample_start[c + 1] = sample_start[c] + chunk_samples[c].size();
+                }
+
+                if (sample_start[n] < num_samples) {
+                        return false;
+                }
+
+                /// ------------------------------------------------------------
+                /// and convert each chunk, in place, into the pixels that start
+                /// in it. a pixel straddling chunks picks up its remaining
+                /// samples from the chunks that follow.
+                auto const lut = ppm_sample_lut(color_scale);
+                auto to_float  = [&lut, color_scale](uint32_t v) -> float {
+                        return (v < lut.size()) ? lut[v] : (1.0 * v) / (1.0 * color_scale);
+                };
+
+                auto sample_at = [&](size_t c, size_t si) -> float {
+                        while (si >= sample_start[c + 1]) {
+                                c++;
+                        }
+
+                        return to_float(chunk_samples[c][si - sample_start[c]]);
+                };
+
+                ppm_parallel_for(n, 1, [&](size_t begin, size_t end) {
+                        for (size_t c = begin; c < end; c++) {
+                                size_t const end_sample  = std::min(sample_start[c + 1], num_samples);
+                                size_t const first_pixel = (sample_start[c] + 2) / 3;
+                                size_t const last_pixel  = (end_sample + 2) / 3;
+
+                                for (size_t i = first_pixel; i < last_pixel; i++) {
+                                        dst[i] = color(sample_at(c, 3 * i + 0), /// r
+                                                       sample_at(c, 3 * i + 1), /// g
+                                                       sample_at(c, 3 * i + 2)); /// b
                                 }
                         }
+                });
+
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// tokenize ascii samples from [data .. data + data_size) into
+        /// 'samples'. returns 'false' on bogus input.
+        ///
+        /// just like the header tokenizer, '#' starts a comment which runs
+        /// till the end of the line, and tokens must be terminated by one of
+        /// ' ', '\t', '\r' or '\n' (or the end of input).
+        bool canvas::ppm_tokenize_ascii_samples(char const* data, size_t data_size, std::vector<uint32_t>& samples)
+        {
+                samples.reserve(data_size / 3);
+
+                size_t ci = 0;
+                while (ci < data_size) {
+                        char const ch = data[ci];
+
+                        switch (ch) {
+                        case ' ':
+                        case '\t':
+                        case '\n':
+                        case '\r':
+                        case '\f':
+                                ci += 1;
+                                continue;
+
+                        case '#': {
+                                auto nl = static_cast<char const*>(memchr(data + ci, '\n', data_size - ci));
+                                ci      = (nl == nullptr) ? data_size : (nl - data);
+                                continue;
+                        }
+
+                        default:
+                                break;
+                        }
+
+                        uint32_t val = 0;
+                        for (; ci < data_size; ci++) {
+                                char const d = data[ci];
+
+                                if ((d >= '0') && (d <= '9')) {
+                                        val = val * 10 + (d - '0');
+                                        continue;
+                                }
+
+                                if ((d == ' ') || (d == '\t') || (d == '\n') || (d == '\r')) {
+                                        break;
+                                }
+
+                                /// bogus characters in input
+                                return false;
+                        }
 
-                        return ppm_img_retval;
+                        samples.push_back(val);
                 }
 
-                return std::nullopt;
+                return true;
         }
 
 } // namespace raytracer
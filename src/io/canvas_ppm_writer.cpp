@@ -3,17 +3,18 @@
  **/
 
 /// c++ includes
+#include <algorithm>
+#include <cctype>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
-#include <memory>
 #include <string>
-#include <utility>
+#include <vector>
 
 /// our includes
-#include "common/include/string_utils.hpp"
 #include "io/canvas.hpp"
 #include "utils/constants.hpp"
+#include "utils/execution_profiler.hpp"
 
 namespace raytracer
 {
@@ -21,6 +22,30 @@ namespace raytracer
         /// save a canvas to persistent store
         void canvas::write(std::string const& fname) const
         {
+                PROFILE_SCOPE;
+
+                /// ------------------------------------------------------------
+                /// file extension decides the format, when it is not a ppm
+                auto has_extension = [&fname](std::string const& ext) {
+                        if (fname.size() < ext.size()) {
+                                return false;
+                        }
+
+                        return std::equal(ext.rbegin(), ext.rend(), fname.rbegin(), [](char a, char b) {
+                                return a == std::tolower(static_cast<unsigned char>(b));
+                        });
+                };
+
+                if (has_extension(".png")) {
+                        this->write_png(fname);
+                        return;
+                }
+
+                if (has_extension(".pfm")) {
+                        this->write_pfm(fname);
+                        return;
+                }
+
                 switch (this->type_) {
                 case PPM_CANVAS_BINARY:
                         this->write_binary(fname);
@@ -41,6 +66,38 @@ namespace raytracer
          * only private functions from this point onwards
          **/
 
+        /// --------------------------------------------------------------------
+        /// format 'val' as a decimal string at 'dst', and return the location
+        /// just past the last digit. no nul-termination is done.
+        static inline char* ppm_format_value(char* dst, unsigned char val)
+        {
+                if (val >= 100) {
+                        *dst++ = '0' + (val / 100);
+                        val %= 100;
+                        *dst++ = '0' + (val / 10);
+                } else if (val >= 10) {
+                        *dst++ = '0' + (val / 10);
+                }
+
+                *dst++ = '0' + (val % 10);
+
+                return dst;
+        }
+
+        /// --------------------------------------------------------------------
+        /// write the ppm header for a 'magic' format image
+        static bool ppm_write_header(FILE* dst_file, char const* magic, size_t width, size_t height)
+        {
+                return fprintf(dst_file,
+                               "%s\n"
+                               "%zu %zu\n" /// x-y dimensions
+                               "255\n"     /// colors/pixel
+                               ,           /// --values--
+                               magic,      /// P3 or P6
+                               width,      /// width
+                               height) > 0;
+        }
+
         /// --------------------------------------------------------------------
         /// save canvas data in binary format i.e. P6
         void canvas::write_binary(std::string const& fname) const
@@ -54,19 +111,19 @@ namespace raytracer
                 }
 
                 /// step-1: add image header
-                fprintf(dst_file,
-                        "P6\n"
-                        "%ld %ld\n"                   /// x-y dimensions
-                        "255\n"                       /// colors/pixel
-                        ,                             /// --values--
-                        this->width_, this->height_); /// width, height
-
-                /// step-2 : add image data (row at a time)
-                for (size_t i = 0; i < this->height_; i++) {
-                        auto raw_data     = get_ppm_row(i);
-                        auto raw_data_buf = raw_data.get();
-
-                        fwrite(raw_data_buf, sizeof(unsigned char), ppm_num_values(), dst_file);
+                ppm_write_header(dst_file, "P6", this->width_, this->height_);
+
+                /// ------------------------------------------------------------
+                /// step-2 : convert the whole image in one go, and write it
+                /// out with a single call
+                auto const num_values = this->height_ * ppm_num_values();
+                std::vector<unsigned char> ppm_data(num_values);
+
+                ppm_encode(ppm_data.data());
+
+                if (fwrite(ppm_data.data(), sizeof(unsigned char), num_values, dst_file) != num_values) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
                 }
 
                 /// ok, we are done here
@@ -80,67 +137,6 @@ namespace raytracer
         /// save canvas data in ascii format i.e. P3
         void canvas::write_ascii(std::string const& fname) const
         {
-                /// ------------------------------------------------------------
-                /// generate a ppm-fmt representation of a row of pixels
-                ///
-                /// though not 'strictly' required by P3 format specification,
-                /// but we dump an integral number of pixels-per-row. this aids
-                /// in easy scanning of generated image data
-                /// ------------------------------------------------------------
-                auto ppm_fmt_pixel_row = [](std::unique_ptr<unsigned char[]> row_data,
-                                            size_t row_data_size) -> std::string {
-                        std::string current_line;
-
-                        /// 1 color comprising 3 pixel data values are consumed per iteration
-                        for (size_t pixel = 0, current_length = 0; pixel < row_data_size; pixel += 3) {
-                                /// --------------------------------------------
-                                /// both of 'r' and 'g' components will _always_
-                                /// be followed by a ' '.
-                                ///
-                                /// the 'b' component on the other hand, can
-                                /// followed by either a ' ' or '\n'.
-                                ///
-                                /// however the '\n' will only be required when
-                                /// we have accumulated PPM_MAX_LINE_LENGTH bytes
-                                /// worth of data in the current line.
-                                ///
-                                /// so, we just add ' ' by default, and 'fix'
-                                /// things later when we hit limit...
-                                /// --------------------------------------------
-                                auto r = std::to_string(row_data[pixel + 0]) + " ";
-                                auto g = std::to_string(row_data[pixel + 1]) + " ";
-                                auto b = std::to_string(row_data[pixel + 2]) + " ";
-
-                                auto const rgb_str     = r + g + b;
-                                auto const rgb_str_len = rgb_str.size();
-
-                                /// --------------------------------------------
-                                current_line += rgb_str;
-                                current_length += rgb_str_len;
-
-                                /// --------------------------------------------
-                                /// if the *current* length exceeds
-                                /// PPM_MAX_LINE_LENGTH, it implies that the last
-                                /// rgb_str that was added pushed us over the
-                                /// edge.
-                                ///
-                                /// just go back, and repalce the extra " " with
-                                /// a '\n' to indicate starting of a new line of
-                                /// pixel data.
-                                /// --------------------------------------------
-                                if (current_length > PPM_MAX_LINE_LENGTH) {
-                                        auto nl_location              = current_line.size() - rgb_str_len;
-                                        current_line[nl_location - 1] = '\n';
-                                        current_length                = rgb_str_len;
-                                }
-                        }
-
-                        /// trim possibly trailing ' ' from the line
-                        rtrim(current_line);
-
-                        return current_line;
-                };
-
                 FILE* dst_file = fopen(fname.c_str(), "w");
 
                 if (dst_file == nullptr) {
@@ -150,22 +146,81 @@ namespace raytracer
                 }
 
                 /// step-1: add image-header
-                fprintf(dst_file,
-                        "P3\n"
-                        "%ld %ld\n"                   /// x-y dimensions
-                        "255\n"                       /// colors/pixel
-                        ,                             /// --values--
-                        this->width_, this->height_); /// width, height
+                ppm_write_header(dst_file, "P3", this->width_, this->height_);
+
+                /// ------------------------------------------------------------
+                /// step-2: convert the whole image in one go
+                std::vector<unsigned char> ppm_data(this->height_ * ppm_num_values());
+                ppm_encode(ppm_data.data());
 
                 /// ------------------------------------------------------------
-                /// step-2: add image data, 1 row at a time
-                for (size_t i = 0; i < this->height_; i++) {
-                        auto raw_data = get_ppm_row(i);
-                        auto fmt_data = ppm_fmt_pixel_row(std::move(raw_data), ppm_num_values());
+                /// step-3: format rows of pixels into a fixed size buffer,
+                /// which is written out whenever it cannot hold another row.
+                ///
+                /// a value takes atmost 4 characters ("255 "), and each row
+                /// ends with a '\n'
+                size_t const max_row_size = ppm_num_values() * 4 + 1;
+                size_t const buf_size     = std::max<size_t>(max_row_size, 1 << 20);
+
+                std::vector<char> fmt_buf(buf_size);
+                char* const fmt_buf_start = fmt_buf.data();
+                char* dst                 = fmt_buf_start;
+
+                auto flush_fmt_buf = [&]() {
+                        fwrite(fmt_buf_start, sizeof(char), dst - fmt_buf_start, dst_file);
+                        dst = fmt_buf_start;
+                };
+
+                unsigned char const* src = ppm_data.data();
+
+                for (size_t y = 0; y < this->height_; y++) {
+                        if (static_cast<size_t>(fmt_buf_start + buf_size - dst) < max_row_size) {
+                                flush_fmt_buf();
+                        }
+
+                        char* const row_start = dst;
+
+                        /// ----------------------------------------------------
+                        /// though not 'strictly' required by P3 format
+                        /// specification, but we dump an integral number of
+                        /// pixels-per-row. this aids in easy scanning of
+                        /// generated image data.
+                        ///
+                        /// each pixel is followed by a ' '. when the pixel
+                        /// pushes the current line over PPM_MAX_LINE_LENGTH,
+                        /// the ' ' preceding it is replaced with a '\n'.
+                        size_t current_length = 0;
+
+                        for (size_t x = 0; x < this->width_; x++, src += 3) {
+                                char* const pixel_start = dst;
+
+                                dst    = ppm_format_value(dst, src[0]);
+                                *dst++ = ' ';
+                                dst    = ppm_format_value(dst, src[1]);
+                                *dst++ = ' ';
+                                dst    = ppm_format_value(dst, src[2]);
+                                *dst++ = ' ';
+
+                                size_t const rgb_str_len = dst - pixel_start;
+                                current_length += rgb_str_len;
 
-                        fprintf(dst_file, "%s\n", fmt_data.c_str());
+                                if (current_length > PPM_MAX_LINE_LENGTH) {
+                                        pixel_start[-1] = '\n';
+                                        current_length  = rgb_str_len;
+                                }
+                        }
+
+                        /// ----------------------------------------------------
+                        /// the trailing ' ' (if any) ends the row
+                        if (dst != row_start) {
+                                dst[-1] = '\n';
+                        } else {
+                                *dst++ = '\n';
+                        }
                 }
 
+                flush_fmt_buf();
+
                 /// ok we are done here
                 fflush(dst_file);
                 fclose(dst_file);
@@ -0,0 +1,126 @@
+/*
+ * implement the asynchronous canvas writer
+ **/
+
+#include "io/canvas_writer.hpp"
+
+/// c++ includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// create a writer with 'num_writers' threads, and atmost
+        /// 'max_pending' canvases waiting to be written.
+        canvas_writer::canvas_writer(uint32_t num_writers, size_t max_pending)
+            : max_pending_(std::max<size_t>(max_pending, 1))
+        {
+                num_writers = std::max<uint32_t>(num_writers, 1);
+
+                for (uint32_t i = 0; i < num_writers; i++) {
+                        writers_.emplace_back(&canvas_writer::writer_loop, this);
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// flush all pending canvases, and stop the writer threads
+        canvas_writer::~canvas_writer()
+        {
+                flush();
+
+                {
+                        std::lock_guard<std::mutex> guard(lock_);
+                        shutting_down_ = true;
+                }
+
+                queue_not_empty_.notify_all();
+
+                for (auto& w : writers_) {
+                        w.join();
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// queue a canvas for writing, waiting for a free slot if required
+        void canvas_writer::submit(canvas c, std::string fname)
+        {
+                {
+                        std::unique_lock<std::mutex> guard(lock_);
+                        queue_not_full_.wait(guard, [this]() { return pending_.size() < max_pending_; });
+
+                        pending_.emplace_back(std::move(c), std::move(fname));
+                }
+
+                queue_not_empty_.notify_one();
+        }
+
+        /// --------------------------------------------------------------------
+        /// wait till all submitted canvases have been written
+        void canvas_writer::flush()
+        {
+                std::unique_lock<std::mutex> guard(lock_);
+                all_written_.wait(guard, [this]() { return pending_.empty() && (num_in_flight_ == 0); });
+        }
+
+        /// --------------------------------------------------------------------
+        /// number of canvases written so far
+        size_t canvas_writer::num_written()
+        {
+                std::lock_guard<std::mutex> guard(lock_);
+                return num_written_;
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// writer thread: pick up canvases from the queue, and write them out
+        /// till we are asked to shut down.
+        void canvas_writer::writer_loop()
+        {
+                while (true) {
+                        std::unique_lock<std::mutex> guard(lock_);
+                        queue_not_empty_.wait(guard, [this]() { return shutting_down_ || !pending_.empty(); });
+
+                        if (pending_.empty()) {
+                                /// shutting down, and nothing left to write
+                                return;
+                        }
+
+                        auto item = std::move(pending_.front());
+                        pending_.pop_front();
+                        num_in_flight_ += 1;
+
+                        guard.unlock();
+                        queue_not_full_.notify_one();
+
+                        /// ----------------------------------------------------
+                        /// encode + write without holding the lock
+                        item.first.write(item.second);
+                        LOG_DEBUG("wrote canvas: '%s'", item.second.c_str());
+
+                        guard.lock();
+                        num_in_flight_ -= 1;
+                        num_written_ += 1;
+
+                        bool const done = pending_.empty() && (num_in_flight_ == 0);
+                        guard.unlock();
+
+                        if (done) {
+                                all_written_.notify_all();
+                        }
+                }
+        }
+
+} // namespace raytracer
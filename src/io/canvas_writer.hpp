@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+ * this file implements an asynchronous canvas writer.
+ *
+ * rendering a sequence of frames (f.e. for a movie) and writing each of them
+ * out synchronously keeps the cpu(s) idle while the frame is being encoded and
+ * written. with the canvas_writer, finished canvases are handed over to a
+ * (small) pool of writer threads through a bounded queue, and the next frame
+ * can be rendered while the previous ones are being written out.
+ *
+ * when the queue is full, submit(...) blocks till a slot becomes available.
+ * this limits the number of canvases that are held in memory at any given
+ * time.
+ **/
+
+/// c++ includes
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// our includes
+#include "io/canvas.hpp"
+
+namespace raytracer
+{
+        class canvas_writer final
+        {
+            private:
+                /// ------------------------------------------------------------
+                /// a canvas waiting to be written, and its destination
+                using write_item_t = std::pair<canvas, std::string>;
+
+                size_t const max_pending_;
+
+                std::mutex lock_;
+                std::condition_variable queue_not_full_;
+                std::condition_variable queue_not_empty_;
+                std::condition_variable all_written_;
+
+                std::deque<write_item_t> pending_;
+
+                /// ------------------------------------------------------------
+                /// number of canvases being written right now
+                size_t num_in_flight_ = 0;
+
+                /// ------------------------------------------------------------
+                /// total number of canvases written so far
+                size_t num_written_ = 0;
+
+                bool shutting_down_ = false;
+
+                std::vector<std::thread> writers_;
+
+            public:
+                /// ------------------------------------------------------------
+                /// by default, a single writer thread, with atmost 2 pending
+                /// canvases is used. this is usually sufficient to keep up
+                /// with the renderer.
+                static constexpr uint32_t DEFAULT_NUM_WRITERS = 1;
+                static constexpr size_t DEFAULT_MAX_PENDING   = 2;
+
+            public:
+                canvas_writer(uint32_t num_writers = DEFAULT_NUM_WRITERS,
+                              size_t max_pending   = DEFAULT_MAX_PENDING);
+
+                /// ------------------------------------------------------------
+                /// all pending canvases are written before the writer is
+                /// destroyed.
+                ~canvas_writer();
+
+                canvas_writer(canvas_writer const&)            = delete;
+                canvas_writer& operator=(canvas_writer const&) = delete;
+
+            public:
+                /// ------------------------------------------------------------
+                /// queue a canvas for writing to 'fname'. blocks when
+                /// 'max_pending' canvases are already waiting to be written.
+                void submit(canvas c, std::string fname);
+
+                /// ------------------------------------------------------------
+                /// wait till all submitted canvases have been written
+                void flush();
+
+                /// ------------------------------------------------------------
+                /// number of canvases written so far
+                size_t num_written();
+
+            private:
+                /// ------------------------------------------------------------
+                /// writer thread main loop
+                void writer_loop();
+        };
+
+} // namespace raytracer
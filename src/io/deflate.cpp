@@ -0,0 +1,620 @@
+/*
+ * implement the deflate / zlib compressor
+ **/
+
+#include "io/deflate.hpp"
+
+/// c++ includes
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// lz77 parameters
+        constexpr size_t LZ_WINDOW_SIZE    = 32768;
+        constexpr size_t LZ_WINDOW_MASK    = LZ_WINDOW_SIZE - 1;
+        constexpr uint32_t LZ_HASH_BITS    = 15;
+        constexpr size_t LZ_HASH_SIZE      = 1 << LZ_HASH_BITS;
+        constexpr uint32_t LZ_MAX_CHAIN    = 64;
+        constexpr uint32_t LZ_MIN_MATCH    = 3;
+        constexpr uint32_t LZ_MAX_MATCH    = 258;
+        constexpr size_t MAX_BLOCK_SYMBOLS = 64 * 1024;
+
+        /// --------------------------------------------------------------------
+        /// huffman alphabets
+        constexpr size_t NUM_LITLEN_CODES  = 286;
+        constexpr size_t NUM_DIST_CODES    = 30;
+        constexpr size_t NUM_CODELEN_CODES = 19;
+        constexpr uint32_t END_OF_BLOCK    = 256;
+
+        constexpr uint32_t MAX_CODE_BITS    = 15;
+        constexpr uint32_t MAX_CODELEN_BITS = 7;
+
+        // clang-format off
+        constexpr std::array<uint16_t, 29> LENGTH_BASE = {
+                3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+        };
+
+        constexpr std::array<uint8_t, 29> LENGTH_EXTRA = {
+                0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+        };
+
+        constexpr std::array<uint16_t, 30> DIST_BASE = {
+                1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                8193, 12289, 16385, 24577,
+        };
+
+        constexpr std::array<uint8_t, 30> DIST_EXTRA = {
+                0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+        };
+
+        /// order in which code-length code lengths are written
+        constexpr std::array<uint8_t, NUM_CODELEN_CODES> CODELEN_ORDER = {
+                16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+        };
+        // clang-format on
+
+        /// --------------------------------------------------------------------
+        /// a literal (dist == 0) or a <length, distance> pair
+        struct lz_symbol {
+                uint16_t lit_or_len;
+                uint16_t dist;
+        };
+
+        /// --------------------------------------------------------------------
+        /// writes bits lsb-first into a byte vector
+        class deflate_bit_writer final
+        {
+            private:
+                std::vector<uint8_t>& out_;
+                uint64_t bits_  = 0;
+                uint32_t nbits_ = 0;
+
+            public:
+                explicit deflate_bit_writer(std::vector<uint8_t>& out)
+                    : out_(out)
+                {
+                }
+
+                void put(uint32_t value, uint32_t num_bits)
+                {
+                        bits_ |= static_cast<uint64_t>(value) << nbits_;
+                        nbits_ += num_bits;
+
+                        while (nbits_ >= 8) {
+                                out_.push_back(static_cast<uint8_t>(bits_));
+                                bits_ >>= 8;
+                                nbits_ -= 8;
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// pad with zero bits upto the next byte boundary
+                void align()
+                {
+                        if (nbits_ > 0) {
+                                put(0, 8 - nbits_);
+                        }
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// a canonical huffman code: lengths, and bit-reversed codes ready to
+        /// be written lsb-first
+        struct huffman_code {
+                std::vector<uint8_t> lengths;
+                std::vector<uint16_t> codes;
+        };
+
+        /// --------------------------------------------------------------------
+        /// index of the largest 'base' entry that is <= 'value'
+        template <size_t N>
+        static inline size_t base_index(std::array<uint16_t, N> const& base, uint32_t value)
+        {
+                return std::upper_bound(base.begin(), base.end(), value) - base.begin() - 1;
+        }
+
+        /// --------------------------------------------------------------------
+        /// reverse the lowest 'num_bits' of 'code'
+        static inline uint16_t reverse_bits(uint32_t code, uint32_t num_bits)
+        {
+                uint32_t rev = 0;
+
+                for (uint32_t i = 0; i < num_bits; i++) {
+                        rev = (rev << 1) | (code & 1);
+                        code >>= 1;
+                }
+
+                return static_cast<uint16_t>(rev);
+        }
+
+        /// --------------------------------------------------------------------
+        /// compute huffman code lengths (atmost 'max_bits' long) from symbol
+        /// frequencies.
+        ///
+        /// atleast two symbols are always given a code, so that inflaters
+        /// never see a degenerate (single code) tree.
+        static std::vector<uint8_t> huffman_code_lengths(std::vector<uint32_t> freqs, uint32_t max_bits)
+        {
+                size_t const num_symbols = freqs.size();
+                std::vector<uint8_t> lengths(num_symbols, 0);
+
+                for (size_t i = 0, num_used = std::count_if(freqs.begin(), freqs.end(),
+                                                            [](uint32_t f) { return f != 0; });
+                     (num_used < 2) && (i < num_symbols); i++) {
+                        if (freqs[i] == 0) {
+                                freqs[i] = 1;
+                                num_used += 1;
+                        }
+                }
+
+                while (true) {
+                        /// ----------------------------------------------------
+                        /// nodes [0 .. num_symbols) are leaves, the rest are
+                        /// internal nodes
+                        std::vector<int32_t> parent(num_symbols, -1);
+
+                        using node_t = std::pair<uint64_t, int32_t>; /// <freq, node-index>
+                        std::priority_queue<node_t, std::vector<node_t>, std::greater<node_t>> pq;
+
+                        for (size_t i = 0; i < num_symbols; i++) {
+                                if (freqs[i] != 0) {
+                                        pq.emplace(freqs[i], i);
+                                }
+                        }
+
+                        while (pq.size() > 1) {
+                                auto const a = pq.top();
+                                pq.pop();
+                                auto const b = pq.top();
+                                pq.pop();
+
+                                auto const node = static_cast<int32_t>(parent.size());
+                                parent.push_back(-1);
+                                parent[a.second] = node;
+                                parent[b.second] = node;
+
+                                pq.emplace(a.first + b.first, node);
+                        }
+
+                        /// ----------------------------------------------------
+                        /// depth of a leaf is its code length
+                        uint32_t longest = 0;
+                        for (size_t i = 0; i < num_symbols; i++) {
+                                if (freqs[i] == 0) {
+                                        continue;
+                                }
+
+                                uint32_t depth = 0;
+                                for (auto n = parent[i]; n != -1; n = parent[n]) {
+                                        depth += 1;
+                                }
+
+                                lengths[i] = static_cast<uint8_t>(depth);
+                                longest    = std::max(longest, depth);
+                        }
+
+                        if (longest <= max_bits) {
+                                return lengths;
+                        }
+
+                        /// ----------------------------------------------------
+                        /// flatten the distribution, and try again
+                        for (auto& f : freqs) {
+                                if (f != 0) {
+                                        f = (f >> 1) | 1;
+                                }
+                        }
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// canonical huffman codes for code lengths (rfc-1951, 3.2.2)
+        static huffman_code make_huffman_code(std::vector<uint8_t> lengths)
+        {
+                std::array<uint32_t, MAX_CODE_BITS + 1> bl_count  = {};
+                std::array<uint32_t, MAX_CODE_BITS + 1> next_code = {};
+
+                for (auto l : lengths) {
+                        bl_count[l] += 1;
+                }
+
+                bl_count[0] = 0;
+                for (uint32_t bits = 1, code = 0; bits <= MAX_CODE_BITS; bits++) {
+                        code            = (code + bl_count[bits - 1]) << 1;
+                        next_code[bits] = code;
+                }
+
+                huffman_code hc;
+                hc.codes.resize(lengths.size(), 0);
+
+                for (size_t i = 0; i < lengths.size(); i++) {
+                        if (lengths[i] != 0) {
+                                hc.codes[i] = reverse_bits(next_code[lengths[i]]++, lengths[i]);
+                        }
+                }
+
+                hc.lengths = std::move(lengths);
+
+                return hc;
+        }
+
+        /// --------------------------------------------------------------------
+        /// find lz77 matches in 'data', which are appended to 'symbols'
+        static void lz77_compress(uint8_t const* data, size_t len, std::vector<lz_symbol>& symbols)
+        {
+                /// ------------------------------------------------------------
+                /// positions are 64 bits wide, so chunks larger than 2 GiB
+                /// don't overflow them
+                std::vector<int64_t> head(LZ_HASH_SIZE, -1);
+                std::vector<int64_t> prev(LZ_WINDOW_SIZE, -1);
+
+                auto hash_at = [data](size_t i) -> uint32_t {
+                        uint32_t const v = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+                        return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+                };
+
+                auto insert_at = [&](size_t i) {
+                        if (i + LZ_MIN_MATCH <= len) {
+                                auto const h             = hash_at(i);
+                                prev[i & LZ_WINDOW_MASK] = head[h];
+                                head[h]                  = static_cast<int64_t>(i);
+                        }
+                };
+
+                size_t i = 0;
+                while (i < len) {
+                        uint32_t best_len  = 0;
+                        uint32_t best_dist = 0;
+
+                        if (i + LZ_MIN_MATCH <= len) {
+                                auto const max_len = static_cast<uint32_t>(std::min<size_t>(LZ_MAX_MATCH, len - i));
+                                auto cand          = head[hash_at(i)];
+
+                                for (uint32_t chain = 0; (cand >= 0) && (chain < LZ_MAX_CHAIN); chain++) {
+                                        auto const dist = i - static_cast<size_t>(cand);
+                                        if (dist > LZ_WINDOW_SIZE) {
+                                                break;
+                                        }
+
+                                        uint32_t l = 0;
+                                        while ((l < max_len) && (data[cand + l] == data[i + l])) {
+                                                l++;
+                                        }
+
+                                        if (l > best_len) {
+                                                best_len  = l;
+                                                best_dist = static_cast<uint32_t>(dist);
+
+                                                if (l == max_len) {
+                                                        break;
+                                                }
+                                        }
+
+                                        cand = prev[cand & LZ_WINDOW_MASK];
+                                }
+                        }
+
+                        if (best_len >= LZ_MIN_MATCH) {
+                                symbols.push_back({static_cast<uint16_t>(best_len), static_cast<uint16_t>(best_dist)});
+
+                                for (size_t j = 0; j < best_len; j++) {
+                                        insert_at(i + j);
+                                }
+
+                                i += best_len;
+                        } else {
+                                symbols.push_back({data[i], 0});
+                                insert_at(i);
+                                i += 1;
+                        }
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// write 'symbols' as a single dynamic huffman block
+        static void write_dynamic_block(deflate_bit_writer& bw, lz_symbol const* symbols, size_t num_symbols,
+                                        bool is_final)
+        {
+                /// ------------------------------------------------------------
+                /// symbol frequencies
+                std::vector<uint32_t> litlen_freqs(NUM_LITLEN_CODES, 0);
+                std::vector<uint32_t> dist_freqs(NUM_DIST_CODES, 0);
+
+                for (size_t i = 0; i < num_symbols; i++) {
+                        auto const& s = symbols[i];
+
+                        if (s.dist == 0) {
+                                litlen_freqs[s.lit_or_len] += 1;
+                        } else {
+                                litlen_freqs[257 + base_index(LENGTH_BASE, s.lit_or_len)] += 1;
+                                dist_freqs[base_index(DIST_BASE, s.dist)] += 1;
+                        }
+                }
+
+                litlen_freqs[END_OF_BLOCK] = 1;
+
+                auto const litlen_code = make_huffman_code(huffman_code_lengths(litlen_freqs, MAX_CODE_BITS));
+                auto const dist_code   = make_huffman_code(huffman_code_lengths(dist_freqs, MAX_CODE_BITS));
+
+                /// ------------------------------------------------------------
+                /// trim unused trailing codes
+                size_t num_litlen = NUM_LITLEN_CODES;
+                while ((num_litlen > 257) && (litlen_code.lengths[num_litlen - 1] == 0)) {
+                        num_litlen--;
+                }
+
+                size_t num_dist = NUM_DIST_CODES;
+                while ((num_dist > 1) && (dist_code.lengths[num_dist - 1] == 0)) {
+                        num_dist--;
+                }
+
+                /// ------------------------------------------------------------
+                /// run-length encode the code lengths of both trees
+                std::vector<uint8_t> all_lengths(litlen_code.lengths.begin(),
+                                                 litlen_code.lengths.begin() + num_litlen);
+                all_lengths.insert(all_lengths.end(), dist_code.lengths.begin(),
+                                   dist_code.lengths.begin() + num_dist);
+
+                std::vector<std::pair<uint8_t, uint8_t>> rle; /// <code-length-symbol, extra-value>
+                for (size_t i = 0; i < all_lengths.size();) {
+                        auto const val = all_lengths[i];
+                        size_t run     = 1;
+                        while ((i + run < all_lengths.size()) && (all_lengths[i + run] == val)) {
+                                run++;
+                        }
+                        i += run;
+
+                        if (val == 0) {
+                                while (run >= 11) {
+                                        auto const n = std::min<size_t>(run, 138);
+                                        rle.emplace_back(18, n - 11);
+                                        run -= n;
+                                }
+                                if (run >= 3) {
+                                        rle.emplace_back(17, run - 3);
+                                        run = 0;
+                                }
+                        } else {
+                                rle.emplace_back(val, 0);
+                                run -= 1;
+
+                                while (run >= 3) {
+                                        auto const n = std::min<size_t>(run, 6);
+                                        rle.emplace_back(16, n - 3);
+                                        run -= n;
+                                }
+                        }
+
+                        for (; run > 0; run--) {
+                                rle.emplace_back(val, 0);
+                        }
+                }
+
+                std::vector<uint32_t> codelen_freqs(NUM_CODELEN_CODES, 0);
+                for (auto const& r : rle) {
+                        codelen_freqs[r.first] += 1;
+                }
+
+                auto const codelen_code = make_huffman_code(huffman_code_lengths(codelen_freqs, MAX_CODELEN_BITS));
+
+                size_t num_codelen = NUM_CODELEN_CODES;
+                while ((num_codelen > 4) && (codelen_code.lengths[CODELEN_ORDER[num_codelen - 1]] == 0)) {
+                        num_codelen--;
+                }
+
+                /// ------------------------------------------------------------
+                /// block header
+                bw.put(is_final ? 1 : 0, 1);
+                bw.put(2, 2); /// dynamic huffman
+                bw.put(num_litlen - 257, 5);
+                bw.put(num_dist - 1, 5);
+                bw.put(num_codelen - 4, 4);
+
+                for (size_t i = 0; i < num_codelen; i++) {
+                        bw.put(codelen_code.lengths[CODELEN_ORDER[i]], 3);
+                }
+
+                for (auto const& r : rle) {
+                        bw.put(codelen_code.codes[r.first], codelen_code.lengths[r.first]);
+
+                        if (r.first == 16) {
+                                bw.put(r.second, 2);
+                        } else if (r.first == 17) {
+                                bw.put(r.second, 3);
+                        } else if (r.first == 18) {
+                                bw.put(r.second, 7);
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// block data
+                for (size_t i = 0; i < num_symbols; i++) {
+                        auto const& s = symbols[i];
+
+                        if (s.dist == 0) {
+                                bw.put(litlen_code.codes[s.lit_or_len], litlen_code.lengths[s.lit_or_len]);
+                                continue;
+                        }
+
+                        auto const li = base_index(LENGTH_BASE, s.lit_or_len);
+                        bw.put(litlen_code.codes[257 + li], litlen_code.lengths[257 + li]);
+                        bw.put(s.lit_or_len - LENGTH_BASE[li], LENGTH_EXTRA[li]);
+
+                        auto const di = base_index(DIST_BASE, s.dist);
+                        bw.put(dist_code.codes[di], dist_code.lengths[di]);
+                        bw.put(s.dist - DIST_BASE[di], DIST_EXTRA[di]);
+                }
+
+                bw.put(litlen_code.codes[END_OF_BLOCK], litlen_code.lengths[END_OF_BLOCK]);
+        }
+
+        /// --------------------------------------------------------------------
+        /// compress a single chunk into a byte-aligned sequence of blocks.
+        /// only the last chunk has the final block.
+        static std::vector<uint8_t> deflate_compress_chunk(uint8_t const* data, size_t len, bool is_last)
+        {
+                std::vector<lz_symbol> symbols;
+                symbols.reserve(len / 2);
+                lz77_compress(data, len, symbols);
+
+                std::vector<uint8_t> out;
+                out.reserve(len / 2);
+                deflate_bit_writer bw(out);
+
+                for (size_t i = 0; i < symbols.size(); i += MAX_BLOCK_SYMBOLS) {
+                        auto const n = std::min(MAX_BLOCK_SYMBOLS, symbols.size() - i);
+                        write_dynamic_block(bw, symbols.data() + i, n, is_last && (i + n == symbols.size()));
+                }
+
+                if (is_last) {
+                        if (symbols.empty()) {
+                                /// empty final block with fixed codes
+                                bw.put(1, 1);
+                                bw.put(1, 2);
+                                bw.put(0, 7);
+                        }
+                } else {
+                        /// empty stored block: byte-aligns the chunk
+                        bw.put(0, 1);
+                        bw.put(0, 2);
+                        bw.align();
+                        bw.put(0x0000, 16);
+                        bw.put(0xffff, 16);
+                }
+
+                bw.align();
+
+                return out;
+        }
+
+        /// --------------------------------------------------------------------
+        /// compress into a raw deflate stream
+        std::vector<uint8_t> deflate_compress(uint8_t const* data, size_t len, uint32_t num_threads)
+        {
+                size_t const max_chunks = std::max<size_t>(1, len / DEFLATE_MIN_CHUNK_SIZE);
+                size_t const num_chunks = std::clamp<size_t>(num_threads, 1, max_chunks);
+                size_t const chunk_size = (len + num_chunks - 1) / std::max<size_t>(num_chunks, 1);
+
+                std::vector<std::vector<uint8_t>> chunks(num_chunks);
+                std::vector<std::thread> workers;
+
+                for (size_t i = 0; i < num_chunks; i++) {
+                        size_t const start = std::min(len, i * chunk_size);
+                        size_t const end   = std::min(len, start + chunk_size);
+                        bool const is_last = (i == num_chunks - 1);
+
+                        auto compress_fn = [&chunks, data, i, start, end, is_last]() {
+                                chunks[i] = deflate_compress_chunk(data + start, end - start, is_last);
+                        };
+
+                        if (num_chunks == 1) {
+                                compress_fn();
+                        } else {
+                                workers.emplace_back(compress_fn);
+                        }
+                }
+
+                for (auto& w : workers) {
+                        w.join();
+                }
+
+                std::vector<uint8_t> out;
+                for (auto const& c : chunks) {
+                        out.insert(out.end(), c.begin(), c.end());
+                }
+
+                return out;
+        }
+
+        /// --------------------------------------------------------------------
+        /// compress into a zlib stream
+        std::vector<uint8_t> zlib_compress(uint8_t const* data, size_t len, uint32_t num_threads)
+        {
+                /// ------------------------------------------------------------
+                /// cmf: deflate with 32k window, flg: no dictionary, default
+                /// compression level, with (cmf * 256 + flg) % 31 == 0
+                std::vector<uint8_t> out = {0x78, 0x9c};
+
+                auto const compressed = deflate_compress(data, len, num_threads);
+                out.insert(out.end(), compressed.begin(), compressed.end());
+
+                auto const adler = adler32(1, data, len);
+                out.push_back(static_cast<uint8_t>(adler >> 24));
+                out.push_back(static_cast<uint8_t>(adler >> 16));
+                out.push_back(static_cast<uint8_t>(adler >> 8));
+                out.push_back(static_cast<uint8_t>(adler >> 0));
+
+                return out;
+        }
+
+        /// --------------------------------------------------------------------
+        /// adler-32 checksum
+        uint32_t adler32(uint32_t adler, uint8_t const* data, size_t len)
+        {
+                constexpr uint32_t ADLER_MOD = 65521;
+
+                /// ------------------------------------------------------------
+                /// largest n such that 255n(n+1)/2 + (n+1)(ADLER_MOD-1) fits in
+                /// 32 bits, so the modulo is required only once every n bytes
+                constexpr size_t ADLER_NMAX = 5552;
+
+                uint32_t a = adler & 0xffff;
+                uint32_t b = adler >> 16;
+
+                while (len > 0) {
+                        size_t const n = std::min(len, ADLER_NMAX);
+
+                        for (size_t i = 0; i < n; i++) {
+                                a += data[i];
+                                b += a;
+                        }
+
+                        a %= ADLER_MOD;
+                        b %= ADLER_MOD;
+
+                        data += n;
+                        len -= n;
+                }
+
+                return (b << 16) | a;
+        }
+
+        /// --------------------------------------------------------------------
+        /// crc-32
+        uint32_t crc32(uint32_t crc, uint8_t const* data, size_t len)
+        {
+                static auto const crc_table = []() {
+                        std::array<uint32_t, 256> table = {};
+
+                        for (uint32_t n = 0; n < 256; n++) {
+                                uint32_t c = n;
+                                for (uint32_t k = 0; k < 8; k++) {
+                                        c = (c & 1) ? (0xedb88320u ^ (c >> 1)) : (c >> 1);
+                                }
+                                table[n] = c;
+                        }
+
+                        return table;
+                }();
+
+                crc = ~crc;
+                for (size_t i = 0; i < len; i++) {
+                        crc = crc_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+                }
+
+                return ~crc;
+        }
+
+} // namespace raytracer
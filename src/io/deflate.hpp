@@ -0,0 +1,46 @@
+#pragma once
+
+/*
+ * this file implements a small, dependency free deflate (rfc-1951) and zlib
+ * (rfc-1950) compressor. it is used for writing png images.
+ *
+ * the input is split into chunks which are compressed concurrently. each
+ * chunk is compressed independently (lz77 matches don't cross chunk
+ * boundaries) into dynamic huffman blocks, and all but the last chunk are
+ * terminated with an empty stored block. this byte-aligns every chunk, so
+ * that compressed chunks can simply be concatenated into a single valid
+ * deflate stream.
+ **/
+
+/// c++ includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// chunks smaller than this are not worth a thread of their own
+        constexpr size_t DEFLATE_MIN_CHUNK_SIZE = 256 * 1024;
+
+        /// --------------------------------------------------------------------
+        /// compress 'len' bytes at 'data' into a raw deflate stream, using
+        /// upto 'num_threads' threads.
+        std::vector<uint8_t> deflate_compress(uint8_t const* data, size_t len, uint32_t num_threads = 1);
+
+        /// --------------------------------------------------------------------
+        /// compress 'len' bytes at 'data' into a zlib stream i.e. a deflate
+        /// stream with zlib header and adler-32 checksum.
+        std::vector<uint8_t> zlib_compress(uint8_t const* data, size_t len, uint32_t num_threads = 1);
+
+        /// --------------------------------------------------------------------
+        /// adler-32 checksum of 'len' bytes at 'data', continuing from
+        /// 'adler'
+        uint32_t adler32(uint32_t adler, uint8_t const* data, size_t len);
+
+        /// --------------------------------------------------------------------
+        /// crc-32 (as used by png and zlib) of 'len' bytes at 'data',
+        /// continuing from 'crc'
+        uint32_t crc32(uint32_t crc, uint8_t const* data, size_t len);
+
+} // namespace raytracer
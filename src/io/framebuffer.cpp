@@ -0,0 +1,383 @@
+/*
+ * implement the tiled, optionally file backed, framebuffer
+ **/
+
+#include "io/framebuffer.hpp"
+
+/// system includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// c++ includes
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+#include "primitives/color.hpp"
+#include "utils/execution_profiler.hpp"
+#include "utils/utils.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// each pixel is 3 floats
+        static constexpr size_t FRAMEBUFFER_PIXEL_SIZE = 3 * sizeof(float);
+
+        /// --------------------------------------------------------------------
+        /// create a framebuffer backed by anonymous memory
+        std::unique_ptr<framebuffer> framebuffer::create(size_t width, size_t height, size_t tile_size)
+        {
+                if (tile_size == 0) {
+                        LOG_ERROR("cannot create a framebuffer with empty tiles");
+                        return nullptr;
+                }
+
+                std::unique_ptr<framebuffer> fb(new framebuffer(width, height, tile_size));
+
+                if (!fb->map_pixels("")) {
+                        return nullptr;
+                }
+
+                return fb;
+        }
+
+        /// --------------------------------------------------------------------
+        /// create a framebuffer backed by a sparse file
+        std::unique_ptr<framebuffer> framebuffer::create_mmapped(size_t width, size_t height,
+                                                                 std::string const& fname, size_t tile_size)
+        {
+                if (tile_size == 0) {
+                        LOG_ERROR("cannot create a framebuffer with empty tiles");
+                        return nullptr;
+                }
+
+                std::unique_ptr<framebuffer> fb(new framebuffer(width, height, tile_size));
+
+                if (!fb->map_pixels(fname)) {
+                        return nullptr;
+                }
+
+                return fb;
+        }
+
+        /// --------------------------------------------------------------------
+        /// cleanup the resources. contents of the backing file (if any) are
+        /// written back by the kernel.
+        framebuffer::~framebuffer()
+        {
+                if (pixels_ != nullptr) {
+                        munmap(pixels_, mapped_size_);
+                }
+
+                if (fd_ != -1) {
+                        close(fd_);
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// the tile at (tile_x, tile_y). tiles along the right and bottom edges
+        /// are clipped to the image.
+        framebuffer_tile framebuffer::tile(uint32_t tile_x, uint32_t tile_y) const
+        {
+                framebuffer_tile t;
+
+                t.tile_x  = tile_x;
+                t.tile_y  = tile_y;
+                t.x_begin = tile_x * tile_size_;
+                t.y_begin = tile_y * tile_size_;
+                t.x_end   = std::min(width_, t.x_begin + tile_size_);
+                t.y_end   = std::min(height_, t.y_begin + tile_size_);
+
+                return t;
+        }
+
+        /// --------------------------------------------------------------------
+        /// the tile containing the pixel at (x, y)
+        framebuffer_tile framebuffer::tile_at_pixel(uint32_t x, uint32_t y) const
+        {
+                return tile(x / tile_size_, y / tile_size_);
+        }
+
+        /// --------------------------------------------------------------------
+        /// color of the pixel at (x, y)
+        color framebuffer::read_pixel(size_t x, size_t y) const
+        {
+                float const* rgb = pixel_address(x, y);
+                return color(rgb[0], rgb[1], rgb[2]);
+        }
+
+        /// --------------------------------------------------------------------
+        /// set the color of the pixel at (x, y)
+        void framebuffer::write_pixel(uint32_t x, uint32_t y, color const& c)
+        {
+                float* rgb = pixel_address(x, y);
+
+                rgb[0] = c.R();
+                rgb[1] = c.G();
+                rgb[2] = c.B();
+        }
+
+        /// --------------------------------------------------------------------
+        /// write a completed tile back to the file, and drop it from memory.
+        /// since the mapping is shared, dropped pages are read back from the
+        /// file (or the page cache) on the next access.
+        void framebuffer::tile_complete(framebuffer_tile const& t)
+        {
+                tiles_completed_.fetch_add(1, std::memory_order_relaxed);
+
+                if (!is_file_backed()) {
+                        return;
+                }
+
+                auto* tile_start = pixels_ + (t.tile_x + t.tile_y * num_tiles_x_) * tile_stride_;
+
+                if (msync(tile_start, tile_stride_, MS_ASYNC) != 0) {
+                        LOG_ERROR("msync of tile (%u, %u) failed, reason: '%s'", t.tile_x, t.tile_y,
+                                  strerror(errno));
+                        return;
+                }
+
+                madvise(tile_start, tile_stride_, MADV_DONTNEED);
+        }
+
+        /// --------------------------------------------------------------------
+        /// convert to a canvas
+        canvas framebuffer::to_canvas() const
+        {
+                auto dst = canvas::create_binary(width_, height_);
+
+                for (size_t y = 0; y < height_; y++) {
+                        for (size_t x = 0; x < width_; x++) {
+                                dst.write_pixel(x, y, read_pixel(x, y));
+                        }
+                }
+
+                return dst;
+        }
+
+        /// --------------------------------------------------------------------
+        /// save the image to a persistent store
+        void framebuffer::write(std::string const& fname) const
+        {
+                PROFILE_SCOPE;
+
+                auto has_extension = [&fname](std::string const& ext) {
+                        if (fname.size() < ext.size()) {
+                                return false;
+                        }
+
+                        return std::equal(ext.rbegin(), ext.rend(), fname.rbegin(), [](char a, char b) {
+                                return a == std::tolower(static_cast<unsigned char>(b));
+                        });
+                };
+
+                if (has_extension(".pfm")) {
+                        write_pfm(fname);
+                        return;
+                }
+
+                if (has_extension(".ppm")) {
+                        write_ppm(fname);
+                        return;
+                }
+
+                to_canvas().write(fname);
+        }
+
+        /// --------------------------------------------------------------------
+        /// meta information about the framebuffer
+        std::string framebuffer::stringify() const
+        {
+                std::stringstream ss("");
+
+                // clang-format off
+                ss << "{"
+                   << "width: "       << width_       << ", "
+                   << "height: "      << height_      << ", "
+                   << "tile-size: "   << tile_size_   << ", "
+                   << "tiles: "       << num_tiles_x_ << "x" << num_tiles_y_ << ", "
+                   << "mapped-size: " << mapped_size_ << ", "
+                   << "backing: '"    << (is_file_backed() ? fname_ : "anonymous") << "'"
+                   << "}";
+                // clang-format on
+
+                return ss.str();
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// tiles are padded to a multiple of the page size, so that each one
+        /// can be flushed || dropped on its own.
+        framebuffer::framebuffer(size_t width, size_t height, size_t tile_size)
+            : width_(width)
+            , height_(height)
+            , tile_size_(tile_size)
+            , num_tiles_x_((width + tile_size - 1) / tile_size)
+            , num_tiles_y_((height + tile_size - 1) / tile_size)
+            , tile_stride_([tile_size]() {
+                    size_t const page_size  = sysconf(_SC_PAGESIZE);
+                    size_t const tile_bytes = tile_size * tile_size * FRAMEBUFFER_PIXEL_SIZE;
+
+                    return ((tile_bytes + page_size - 1) / page_size) * page_size;
+            }())
+        {
+        }
+
+        /// --------------------------------------------------------------------
+        /// map memory for the tiles. a file backing the framebuffer is only
+        /// extended (not written), so it remains sparse until tiles are
+        /// flushed to it.
+        bool framebuffer::map_pixels(std::string const& fname)
+        {
+                mapped_size_ = num_tiles_x_ * num_tiles_y_ * tile_stride_;
+
+                if (mapped_size_ == 0) {
+                        LOG_ERROR("cannot create an empty framebuffer");
+                        return false;
+                }
+
+                int map_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+
+                if (!fname.empty()) {
+                        fd_ = open(fname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                        if (fd_ == -1) {
+                                LOG_ERROR("failed to open '%s', reason: '%s'", fname.c_str(),
+                                          strerror(errno));
+                                return false;
+                        }
+
+                        if (ftruncate(fd_, mapped_size_) != 0) {
+                                LOG_ERROR("failed to size '%s', reason: '%s'", fname.c_str(),
+                                          strerror(errno));
+                                return false;
+                        }
+
+                        fname_    = fname;
+                        map_flags = MAP_SHARED;
+                }
+
+                void* addr = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, map_flags, fd_, 0);
+                if (addr == MAP_FAILED) {
+                        LOG_ERROR("failed to map %zu bytes, reason: '%s'", mapped_size_, strerror(errno));
+                        return false;
+                }
+
+                pixels_ = static_cast<uint8_t*>(addr);
+
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// within a tile, pixels are stored row-major with rows of (the full)
+        /// tile size.
+        float* framebuffer::pixel_address(size_t x, size_t y) const
+        {
+                size_t const tile_index  = (x / tile_size_) + (y / tile_size_) * num_tiles_x_;
+                size_t const pixel_index = (x % tile_size_) + (y % tile_size_) * tile_size_;
+
+                auto* tile_start = pixels_ + tile_index * tile_stride_;
+                return reinterpret_cast<float*>(tile_start + pixel_index * FRAMEBUFFER_PIXEL_SIZE);
+        }
+
+        /// --------------------------------------------------------------------
+        /// save the image as an rgb pfm image, one row at a time. pfm rows are
+        /// stored bottom-to-top.
+        void framebuffer::write_pfm(std::string const& fname) const
+        {
+                FILE* dst_file = fopen(fname.c_str(), "wb");
+
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
+                        return;
+                }
+
+                uint16_t const endian_probe = 1;
+                bool const is_little_endian = (*reinterpret_cast<uint8_t const*>(&endian_probe) == 1);
+
+                fprintf(dst_file,
+                        "PF\n"
+                        "%zu %zu\n" /// x-y dimensions
+                        "%s\n"      /// scale + endianness
+                        ,           /// --values--
+                        width_, height_, is_little_endian ? "-1.0" : "1.0");
+
+                std::vector<float> row(width_ * 3);
+
+                for (size_t y = height_; y-- > 0;) {
+                        for (size_t x = 0; x < width_; x++) {
+                                memcpy(&row[3 * x], pixel_address(x, y), FRAMEBUFFER_PIXEL_SIZE);
+                        }
+
+                        if (fwrite(row.data(), sizeof(float), row.size(), dst_file) != row.size()) {
+                                fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                        strerror(errno));
+                                break;
+                        }
+                }
+
+                fflush(dst_file);
+                fclose(dst_file);
+        }
+
+        /// --------------------------------------------------------------------
+        /// save the image as a binary ppm image, one row at a time. colors are
+        /// quantized exactly as the canvas does.
+        void framebuffer::write_ppm(std::string const& fname) const
+        {
+                FILE* dst_file = fopen(fname.c_str(), "wb");
+
+                if (dst_file == nullptr) {
+                        fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                strerror(errno));
+                        return;
+                }
+
+                fprintf(dst_file,
+                        "P6\n"
+                        "%zu %zu\n" /// x-y dimensions
+                        "255\n"     /// colors/pixel
+                        ,           /// --values--
+                        width_, height_);
+
+                auto to_ppm_value = [](float v) -> unsigned char {
+                        return static_cast<unsigned char>(clamp_in_range(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+                };
+
+                std::vector<unsigned char> row(width_ * 3);
+
+                for (size_t y = 0; y < height_; y++) {
+                        for (size_t x = 0; x < width_; x++) {
+                                float const* rgb = pixel_address(x, y);
+
+                                row[3 * x + 0] = to_ppm_value(rgb[0]);
+                                row[3 * x + 1] = to_ppm_value(rgb[1]);
+                                row[3 * x + 2] = to_ppm_value(rgb[2]);
+                        }
+
+                        if (fwrite(row.data(), sizeof(unsigned char), row.size(), dst_file) != row.size()) {
+                                fprintf(stderr, "failed writing: '%s'. reason: '%s'\n", fname.c_str(),
+                                        strerror(errno));
+                                break;
+                        }
+                }
+
+                fflush(dst_file);
+                fclose(dst_file);
+        }
+
+} // namespace raytracer
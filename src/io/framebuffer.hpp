@@ -0,0 +1,180 @@
+#pragma once
+
+/*
+ * this file implements a framebuffer for (very) large renders.
+ *
+ * unlike a canvas, which holds a 'color' per pixel, the framebuffer stores
+ * pixels compactly as 3 floats (r, g, b), and can optionally be backed by a
+ * (sparse) memory mapped file instead of anonymous memory.
+ *
+ * pixels are laid out in square tiles, which are the unit of work when
+ * rendering to a framebuffer. each tile is thus written contiguously by a
+ * single thread, and tiles start at page boundaries, so threads never share
+ * a page (let alone a cache line). once a tile has been rendered, it is
+ * flushed to the backing file and dropped from memory. this bounds the
+ * resident memory of poster-sized renders to the tiles that are in flight.
+ **/
+
+/// c++ includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// our includes
+#include "primitives/color.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// forward declarations
+        class canvas;
+
+        /// --------------------------------------------------------------------
+        /// a single tile of the framebuffer, covering pixels
+        /// [x_begin .. x_end) x [y_begin .. y_end)
+        struct framebuffer_tile final {
+                uint32_t tile_x  = 0;
+                uint32_t tile_y  = 0;
+                uint32_t x_begin = 0;
+                uint32_t y_begin = 0;
+                uint32_t x_end   = 0;
+                uint32_t y_end   = 0;
+        };
+
+        class framebuffer final
+        {
+            private:
+                size_t const width_;
+                size_t const height_;
+                size_t const tile_size_;
+                size_t const num_tiles_x_;
+                size_t const num_tiles_y_;
+
+                /// ------------------------------------------------------------
+                /// bytes from the start of one tile to the next, which is a
+                /// multiple of the page size
+                size_t const tile_stride_;
+
+                /// ------------------------------------------------------------
+                /// the mapping holding all tiles, and the file backing it
+                /// (when there is one)
+                uint8_t* pixels_    = nullptr;
+                size_t mapped_size_ = 0;
+                int fd_             = -1;
+                std::string fname_;
+
+                /// ------------------------------------------------------------
+                /// tiles completed so far, by all rendering threads
+                std::atomic<size_t> tiles_completed_ = 0;
+
+            public:
+                static constexpr size_t DEFAULT_TILE_SIZE = 32;
+
+            public:
+                /// ------------------------------------------------------------
+                /// named constructors. pixels are held in anonymous memory, or
+                /// in 'fname' (which is created || truncated) respectively.
+                ///
+                /// returns nullptr if the memory cannot be mapped.
+                static std::unique_ptr<framebuffer> create(size_t width, size_t height,
+                                                           size_t tile_size = DEFAULT_TILE_SIZE);
+                static std::unique_ptr<framebuffer> create_mmapped(size_t width, size_t height,
+                                                                   std::string const& fname,
+                                                                   size_t tile_size = DEFAULT_TILE_SIZE);
+
+                ~framebuffer();
+
+                framebuffer(framebuffer const&)            = delete;
+                framebuffer& operator=(framebuffer const&) = delete;
+
+            public:
+                size_t width() const
+                {
+                        return width_;
+                }
+
+                size_t height() const
+                {
+                        return height_;
+                }
+
+                size_t tile_size() const
+                {
+                        return tile_size_;
+                }
+
+                size_t num_tiles_x() const
+                {
+                        return num_tiles_x_;
+                }
+
+                size_t num_tiles_y() const
+                {
+                        return num_tiles_y_;
+                }
+
+                bool is_file_backed() const
+                {
+                        return fd_ != -1;
+                }
+
+                /// ------------------------------------------------------------
+                /// number of calls to 'tile_complete(...)' since the
+                /// framebuffer was created
+                size_t tiles_completed() const
+                {
+                        return tiles_completed_.load(std::memory_order_relaxed);
+                }
+
+                /// ------------------------------------------------------------
+                /// the tile at (tile_x, tile_y), and the tile containing pixel
+                /// (x, y)
+                framebuffer_tile tile(uint32_t tile_x, uint32_t tile_y) const;
+                framebuffer_tile tile_at_pixel(uint32_t x, uint32_t y) const;
+
+                /// ------------------------------------------------------------
+                /// read || write the color of a pixel at (x, y)
+                color read_pixel(size_t x, size_t y) const;
+                void write_pixel(uint32_t x, uint32_t y, color const& c);
+
+                /// ------------------------------------------------------------
+                /// called once all pixels of a tile have been written. for
+                /// file backed framebuffers, the tile is written back to the
+                /// file, and dropped from memory. it is paged back in when read
+                /// again.
+                void tile_complete(framebuffer_tile const& t);
+
+                /// ------------------------------------------------------------
+                /// convert to a canvas. the whole image is resident then, so
+                /// this is meant for reasonably sized images only.
+                canvas to_canvas() const;
+
+                /// ------------------------------------------------------------
+                /// save the image. pfm and binary ppm images are written a row
+                /// at a time, so that the image never needs to be resident as
+                /// a whole. everything else is written via a canvas.
+                void write(std::string const& fname) const;
+
+                /// meta information about the framebuffer
+                std::string stringify() const;
+
+            private:
+                framebuffer(size_t width, size_t height, size_t tile_size);
+
+                /// ------------------------------------------------------------
+                /// map memory for all the tiles, optionally backed by a file
+                bool map_pixels(std::string const& fname);
+
+                /// ------------------------------------------------------------
+                /// location of the pixel at (x, y)
+                float* pixel_address(size_t x, size_t y) const;
+
+                /// ------------------------------------------------------------
+                /// save the image one row at a time
+                void write_pfm(std::string const& fname) const;
+                void write_ppm(std::string const& fname) const;
+        };
+
+} // namespace raytracer
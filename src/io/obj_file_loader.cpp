@@ -8,6 +8,7 @@
 #include <array>
 #include <charconv>
 #include <cstdlib>
+#include <cstring>
 #include <ctype.h>
 #include <iterator>
 #include <memory>
@@ -15,6 +16,9 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 /// our includes
 #include "common/include/logging.h"
@@ -26,6 +30,62 @@
 
 namespace raytracer
 {
+        /// --------------------------------------------------------------------
+        /// a face as parsed from a chunk of input during parallel parsing.
+        ///
+        /// indices are kept exactly as they appear in the input, along with
+        /// the number of vertices, vertex-normals and named-groups seen in the
+        /// chunk before this face. this is all that the merge pass needs to
+        /// resolve relative indices and the group that the face belongs to.
+        class obj_chunk_face final
+        {
+            public:
+                std::vector<face_vi_vni> vertices;
+                size_t num_vertices_before = 0;
+                size_t num_normals_before  = 0;
+                size_t num_groups_before   = 0;
+        };
+
+        /// --------------------------------------------------------------------
+        /// result of parsing a single chunk of input during parallel parsing
+        class obj_chunk_parse_result final
+        {
+            public:
+                /// ------------------------------------------------------------
+                /// chunk covers [start .. end) of the input
+                size_t start = 0;
+                size_t end   = 0;
+
+                /// ------------------------------------------------------------
+                /// chunk-local parse data
+                uint32_t unknown_tokens = 0;
+                size_t num_groups       = 0;
+                std::vector<tuple> vertex_list;
+                std::vector<tuple> vertex_normal_list;
+                std::vector<obj_chunk_face> face_list;
+
+                /// ------------------------------------------------------------
+                /// parsing stopped early because of malformed input
+                bool failed = false;
+
+                /// ------------------------------------------------------------
+                /// number of vertices and vertex-normals from all preceding
+                /// chunks. computed by the merge pass.
+                size_t vertex_offset = 0;
+                size_t normal_offset = 0;
+
+                /// ------------------------------------------------------------
+                /// triangles for each face. when a face has bad indices,
+                /// triangles are built only for the faces before it, with
+                /// 'bad_face_index' identifying the bad face.
+                std::vector<std::vector<std::shared_ptr<triangle>>> face_triangles;
+                std::optional<size_t> bad_face_index = std::nullopt;
+
+                /// ------------------------------------------------------------
+                /// indices of the triangles of all faces, in order
+                std::vector<obj_triangle_indices> triangle_indices;
+        };
+
         /// --------------------------------------------------------------------
         /// is this token valid ?
         bool ascii_token_t::is_valid() const
@@ -119,6 +179,10 @@ namespace raytracer
                 obj_parse_result result;
                 bool continue_parsing = true;
 
+                /// ------------------------------------------------------------
+                /// start from the top, so that the file can be parsed again
+                ri = 0;
+
                 /// ------------------------------------------------------------
                 /// continue parsing till we reach e.o.f or the parser indicates
                 /// a failure (which it does as soon as it encounters an error)
@@ -136,6 +200,137 @@ namespace raytracer
                 return result;
         }
 
+        /// --------------------------------------------------------------------
+        /// this function is called to parse a OBJ formatted file using multiple
+        /// threads.
+        ///
+        /// the work happens in three phases:
+        ///   - chunks of input are tokenized and parsed concurrently into
+        ///     chunk-local lists,
+        ///   - vertex and vertex-normal lists are concatenated (in order), and
+        ///     triangles for each chunk are then built concurrently,
+        ///   - triangles are added to their groups in input order.
+        ///
+        /// just like 'parse()', we stop at the first malformed command, and
+        /// the result contains everything that was parsed before it.
+        obj_parse_result obj_file_parser::parse_parallel(uint32_t num_threads, size_t min_chunk_size) const
+        {
+                char const* obj_file_data = reinterpret_cast<char const*>(obj_file.data());
+                obj_parse_result result;
+
+                size_t const max_chunks = std::max<size_t>(1, ei / std::max<size_t>(1, min_chunk_size));
+                size_t const num_chunks = std::clamp<size_t>(num_threads, 1, max_chunks);
+
+                std::vector<obj_chunk_parse_result> chunk_list;
+                for (auto const& [cs, ce] : split_at_line_boundaries(num_chunks)) {
+                        obj_chunk_parse_result chunk;
+                        chunk.start = cs;
+                        chunk.end   = ce;
+
+                        chunk_list.push_back(std::move(chunk));
+                }
+
+                LOG_DEBUG("parsing '%s' with '%zu' chunks", obj_file.file_name().c_str(), chunk_list.size());
+
+                /// ------------------------------------------------------------
+                /// phase-1: parse all chunks concurrently
+                {
+                        std::vector<std::thread> workers;
+                        for (auto& chunk : chunk_list) {
+                                workers.emplace_back([&] { parse_chunk(chunk, obj_file_data); });
+                        }
+
+                        for (auto& w : workers) {
+                                w.join();
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// merge vertex and vertex-normal lists. chunks after a failed
+                /// one are never looked at.
+                size_t num_used_chunks = 0;
+                for (auto& chunk : chunk_list) {
+                        chunk.vertex_offset = result.vertex_list_cref().size();
+                        chunk.normal_offset = result.vertex_normal_list_cref().size();
+
+                        auto& vl = result.vertex_list_ref();
+                        vl.insert(vl.end(), chunk.vertex_list.begin(), chunk.vertex_list.end());
+
+                        auto& vnl = result.vertex_normal_list_ref();
+                        vnl.insert(vnl.end(), chunk.vertex_normal_list.begin(), chunk.vertex_normal_list.end());
+
+                        num_used_chunks += 1;
+                        if (chunk.failed) {
+                                break;
+                        }
+                }
+                chunk_list.resize(num_used_chunks);
+
+                /// ------------------------------------------------------------
+                /// phase-2: build triangles for all chunks concurrently
+                {
+                        std::vector<std::thread> workers;
+                        for (auto& chunk : chunk_list) {
+                                workers.emplace_back([&] { build_chunk_triangles(chunk, result); });
+                        }
+
+                        for (auto& w : workers) {
+                                w.join();
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// phase-3: add triangles to their groups in input order
+                for (auto const& chunk : chunk_list) {
+                        result.unknown_tokens_ref() += chunk.unknown_tokens;
+
+                        auto const group_offset = result.group_list_cref().size();
+                        auto const num_faces =
+                                chunk.bad_face_index.value_or(chunk.face_list.size()); /// good-faces
+                        auto const num_groups =
+                                chunk.bad_face_index.has_value() ?
+                                        chunk.face_list[chunk.bad_face_index.value()].num_groups_before :
+                                        chunk.num_groups;
+
+                        for (size_t i = 0; i < num_groups; i++) {
+                                result.group_list_ref().push_back(std::make_shared<group>());
+                        }
+
+                        for (size_t i = 0; i < num_faces; i++) {
+                                auto const group_index = group_offset + chunk.face_list[i].num_groups_before;
+                                auto dst_group_ref     = (group_index == 0) ?
+                                                                 result.default_group_ref() :
+                                                                 result.group_list_ref()[group_index - 1];
+
+                                for (auto const& tri : chunk.face_triangles[i]) {
+                                        dst_group_ref->add_child(tri);
+                                }
+                        }
+
+                        /// ----------------------------------------------------
+                        /// triangles were only built for good faces
+                        auto& til = result.triangle_indices_ref();
+                        til.insert(til.end(), chunk.triangle_indices.begin(), chunk.triangle_indices.end());
+
+                        /// ----------------------------------------------------
+                        /// a bad face: drop everything that followed it
+                        if (chunk.bad_face_index.has_value()) {
+                                auto const& bad_face = chunk.face_list[chunk.bad_face_index.value()];
+
+                                auto& vl = result.vertex_list_ref();
+                                vl.erase(vl.begin() + chunk.vertex_offset + bad_face.num_vertices_before,
+                                         vl.end());
+
+                                auto& vnl = result.vertex_normal_list_ref();
+                                vnl.erase(vnl.begin() + chunk.normal_offset + bad_face.num_normals_before,
+                                          vnl.end());
+                                break;
+                        }
+                }
+
+                return result;
+        }
+
         /*
          * only private functions from this point onwards
          **/
@@ -250,9 +445,8 @@ namespace raytracer
         /// handle comment i.e. '#' token, eat everything till end-of-line
         bool obj_file_parser::tokenizer_handle_comment_char(char const* data, ascii_token_t& tok) const
         {
-                do {
-                        ri += 1;
-                } while ((ri < ei) && (data[ri] != '\n'));
+                auto eol = static_cast<char const*>(memchr(data + ri, '\n', ei - ri));
+                ri       = (eol == nullptr) ? ei : (eol - data);
 
                 /// continue tokenizing
                 return true;
@@ -269,6 +463,17 @@ namespace raytracer
                         ri += 1;
                 } while ((ri < ei) && (!isspace(data[ri])));
 
+                /// ------------------------------------------------------------
+                /// when nothing but whitespace follows, the line continues
+                /// onto the next one. so the end-of-line is eaten up as well.
+                while ((ri < ei) && isspace(data[ri]) && (data[ri] != '\n')) {
+                        ri += 1;
+                }
+
+                if ((ri < ei) && (data[ri] == '\n')) {
+                        ri += 1;
+                }
+
                 /// continue tokenizing
                 return true;
         }
@@ -474,6 +679,38 @@ namespace raytracer
                                                   result.vertex_normal(pt_3.vni())); /// pt-3-normal
         }
 
+        /// --------------------------------------------------------------------
+        /// '0' based indices of a triangle, the same way as it was created by
+        /// 'create_triangle_from_face_data(...)'. relative (negative) indices
+        /// are resolved against the vertex and vertex-normal lists so far.
+        obj_triangle_indices obj_file_parser::create_triangle_indices(obj_parse_result const& result,
+                                                                      triangle const* tri,
+                                                                      face_vi_vni const& pt_1,
+                                                                      face_vi_vni const& pt_2,
+                                                                      face_vi_vni const& pt_3) const
+        {
+                auto zero_based = [](int32_t i, size_t list_size) {
+                        return (i > 0) ? (i - 1) : static_cast<int32_t>(list_size + i);
+                };
+
+                auto const nv  = result.vertex_list_cref().size();
+                auto const nvn = result.vertex_normal_list_cref().size();
+
+                obj_triangle_indices retval;
+                retval.tri      = tri;
+                retval.vertices = {zero_based(pt_1.vi(), nv),  /// pt-1-vertex
+                                   zero_based(pt_2.vi(), nv),  /// pt-2-vertex
+                                   zero_based(pt_3.vi(), nv)}; /// pt-3-vertex
+
+                if (pt_1.vn_i_isvalid() || pt_2.vn_i_isvalid() || pt_3.vn_i_isvalid()) {
+                        retval.normals = {zero_based(pt_1.vni(), nvn),  /// pt-1-normal
+                                          zero_based(pt_2.vni(), nvn),  /// pt-2-normal
+                                          zero_based(pt_3.vni(), nvn)}; /// pt-3-normal
+                }
+
+                return retval;
+        }
+
         /// --------------------------------------------------------------------
         /// the face data that we got represents a convex polygon. triangulate
         /// it, and add to the default group.
@@ -495,6 +732,8 @@ namespace raytracer
                                                                   face_vertices[i],      /// var-vertex-1
                                                                   face_vertices[i + 1]); /// var-vertex-2
 
+                        result.triangle_indices_ref().push_back(create_triangle_indices(
+                                result, tmp.get(), face_vertices[0], face_vertices[i], face_vertices[i + 1]));
                         dst_group_ref->add_child(tmp);
                 }
 
@@ -581,6 +820,482 @@ namespace raytracer
                 return retval;
         }
 
+        /// --------------------------------------------------------------------
+        /// split the input into chunks, with each chunk ending at a line
+        /// boundary.
+        std::vector<std::pair<size_t, size_t>> obj_file_parser::split_at_line_boundaries(size_t num_chunks) const
+        {
+                char const* data = reinterpret_cast<char const*>(obj_file.data());
+                std::vector<std::pair<size_t, size_t>> retval;
+
+                size_t const chunk_size = ei / num_chunks;
+                size_t cs               = 0;
+
+                for (size_t i = 1; (i < num_chunks) && (cs < ei); i++) {
+                        size_t ce = std::max(cs, i * chunk_size);
+
+                        /// ----------------------------------------------------
+                        /// look for an end-of-line, that doesn't continue
+                        /// onto the next line
+                        while (ce < ei) {
+                                auto eol = static_cast<char const*>(memchr(data + ce, '\n', ei - ce));
+                                if (eol == nullptr) {
+                                        ce = ei;
+                                        break;
+                                }
+
+                                ce = (eol - data) + 1;
+                                if (!line_is_continued(data, ce - 1)) {
+                                        break;
+                                }
+                        }
+
+                        retval.emplace_back(cs, ce);
+                        cs = ce;
+                }
+
+                /// ------------------------------------------------------------
+                /// last chunk gets the rest of input
+                if (cs < ei) {
+                        retval.emplace_back(cs, ei);
+                }
+
+                return retval;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to check if the line ending at 'eol_index'
+        /// has a line-continuation as its last token.
+        bool obj_file_parser::line_is_continued(char const* data, size_t eol_index) const
+        {
+                size_t i = eol_index;
+
+                /// skip trailing whitespace
+                while ((i > 0) && isspace(data[i - 1]) && (data[i - 1] != '\n')) {
+                        i -= 1;
+                }
+
+                /// find beginning of the last token
+                while ((i > 0) && !isspace(data[i - 1])) {
+                        i -= 1;
+                }
+
+                return (i < eol_index) && (data[i] == '\\');
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to parse all lines of a chunk.
+        ///
+        /// tokenizing rules are identical to those of the lexer
+        /// i.e. get_next_token(...) except that a line-continuation joins the
+        /// current line with the next one.
+        void obj_file_parser::parse_chunk(obj_chunk_parse_result& chunk, char const* data) const
+        {
+                std::vector<std::string_view> line_tokens;
+                size_t ci = chunk.start;
+
+                while (ci < chunk.end) {
+                        /// ----------------------------------------------------
+                        /// fast path for the common 'v', 'vn' and 'f' lines
+                        auto const* line      = data + ci;
+                        auto const* line_end  = static_cast<char const*>(memchr(line, '\n', chunk.end - ci));
+                        size_t const line_len = (line_end == nullptr) ? (chunk.end - ci) : (line_end - line);
+
+                        if (parse_chunk_line_fast(chunk, line, line_len)) {
+                                ci = std::min(ci + line_len + 1, chunk.end);
+                                continue;
+                        }
+
+                        line_tokens.clear();
+
+                        /// ----------------------------------------------------
+                        /// gather all tokens of a (logical) line
+                        bool line_contd = false;
+                        while (ci < chunk.end) {
+                                auto const cc = data[ci];
+
+                                if (cc == '\n') {
+                                        ci += 1;
+                                        if (!line_contd) {
+                                                break;
+                                        }
+
+                                        line_contd = false;
+                                        continue;
+                                }
+
+                                if (isspace(cc)) {
+                                        ci += 1;
+                                        continue;
+                                }
+
+                                /// --------------------------------------------
+                                /// comment: eat everything till end-of-line
+                                if (cc == '#') {
+                                        auto eol = static_cast<char const*>(memchr(data + ci, '\n', chunk.end - ci));
+                                        ci       = (eol == nullptr) ? chunk.end : (eol - data);
+                                        continue;
+                                }
+
+                                size_t const ts = ci;
+                                do {
+                                        ci += 1;
+                                } while ((ci < chunk.end) && !isspace(data[ci]));
+
+                                /// --------------------------------------------
+                                /// line continuation tokens are skipped
+                                if (cc == '\\') {
+                                        line_contd = true;
+                                        continue;
+                                }
+
+                                line_contd = false;
+                                line_tokens.emplace_back(&data[ts], ci - ts);
+                        }
+
+                        if (line_tokens.empty()) {
+                                continue;
+                        }
+
+                        if (!parse_chunk_line(chunk, line_tokens)) {
+                                chunk.failed = true;
+                                return;
+                        }
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to parse a 'v', 'vn' or 'f' line from a
+        /// chunk, without splitting it up into tokens first.
+        ///
+        /// anything out of the ordinary f.e. comments, line-continuations,
+        /// malformed numbers etc. is left to the generic path, which takes
+        /// care of reporting errors as well.
+        bool obj_file_parser::parse_chunk_line_fast(obj_chunk_parse_result& chunk, char const* line,
+                                                    size_t line_len) const
+        {
+                if ((line_len < 2) || (memchr(line, '#', line_len) != nullptr) ||
+                    (memchr(line, '\\', line_len) != nullptr)) {
+                        return false;
+                }
+
+                char const* p         = line;
+                char const* const end = line + line_len;
+
+                auto is_ws = [](char c) {
+                        return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\f') || (c == '\v');
+                };
+
+                auto skip_ws = [&]() {
+                        while ((p < end) && is_ws(*p)) {
+                                p++;
+                        }
+                };
+
+                /// ------------------------------------------------------------
+                /// 'v' and 'vn' : exactly 3 numbers
+                bool const is_vertex        = (line[0] == 'v') && is_ws(line[1]);
+                bool const is_vertex_normal = (line_len > 2) && (line[0] == 'v') && (line[1] == 'n') && is_ws(line[2]);
+
+                if (is_vertex || is_vertex_normal) {
+                        std::array<double, 3> xyz;
+                        p += is_vertex ? 1 : 2;
+
+                        for (auto& val : xyz) {
+                                skip_ws();
+
+                                auto const* num_end = parse_double_fast(p, end, val);
+                                if ((num_end == nullptr) || ((num_end != end) && !is_ws(*num_end))) {
+                                        return false;
+                                }
+
+                                p = num_end;
+                        }
+
+                        skip_ws();
+                        if (p != end) {
+                                return false;
+                        }
+
+                        if (is_vertex) {
+                                chunk.vertex_list.emplace_back(create_point(xyz[0], xyz[1], xyz[2]));
+                        } else {
+                                chunk.vertex_normal_list.emplace_back(create_vector(xyz[0], xyz[1], xyz[2]));
+                        }
+
+                        return true;
+                }
+
+                /// ------------------------------------------------------------
+                /// 'f' : 3 or more 'v', 'v/vt', 'v//vn' or 'v/vt/vn' indices
+                if ((line[0] != 'f') || !is_ws(line[1])) {
+                        return false;
+                }
+
+                obj_chunk_face face;
+                face.num_vertices_before = chunk.vertex_list.size();
+                face.num_normals_before  = chunk.vertex_normal_list.size();
+                face.num_groups_before   = chunk.num_groups;
+
+                p += 1;
+                skip_ws();
+
+                while (p < end) {
+                        std::array<int32_t, 3> indices = {0, 0, 0};
+                        size_t num_indices             = 0;
+
+                        while ((p < end) && !is_ws(*p)) {
+                                /// --------------------------------------------
+                                /// just like 'split(...)', consecutive '/' are
+                                /// treated as one.
+                                if (*p == '/') {
+                                        p++;
+                                        continue;
+                                }
+
+                                if (num_indices == indices.size()) {
+                                        return false;
+                                }
+
+                                auto [num_end, ec] = std::from_chars(p, end, indices[num_indices]);
+                                if ((ec != std::errc()) ||
+                                    ((num_end != end) && !is_ws(*num_end) && (*num_end != '/'))) {
+                                        return false;
+                                }
+
+                                num_indices += 1;
+                                p = num_end;
+                        }
+
+                        if (num_indices == 0) {
+                                return false;
+                        }
+
+                        /// ----------------------------------------------------
+                        /// vertex-normal-index will be the last index always
+                        auto const vn_i = (num_indices > 1) ? indices[num_indices - 1] : 0;
+                        face.vertices.emplace_back(face_vi_vni(indices[0], vn_i));
+
+                        skip_ws();
+                }
+
+                if (face.vertices.size() < 3) {
+                        return false;
+                }
+
+                chunk.face_list.push_back(std::move(face));
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to parse a single line from a chunk.
+        bool obj_file_parser::parse_chunk_line(obj_chunk_parse_result& chunk,
+                                               std::vector<std::string_view> const& line_tokens) const
+        {
+                auto const& cmd = line_tokens[0];
+
+                /// ------------------------------------------------------------
+                /// vertex and vertex-normal data. any trailing tokens are
+                /// accounted for as unknown ones.
+                if ((cmd == std::string_view("v")) || (cmd == std::string_view("vn"))) {
+                        if (line_tokens.size() < 4) {
+                                return false;
+                        }
+
+                        std::array<double, 3> vertex_data; /// 3 ∵ x, y, z coordinates
+                        for (uint8_t i = 0; i < 3; i++) {
+                                auto maybe_tok_data = parse_token_value_as_number<double>(line_tokens[i + 1]);
+                                if (!maybe_tok_data.has_value()) {
+                                        return false;
+                                }
+
+                                vertex_data[i] = maybe_tok_data.value();
+                        }
+
+                        if (cmd == std::string_view("v")) {
+                                chunk.vertex_list.emplace_back(
+                                        create_point(vertex_data[0], vertex_data[1], vertex_data[2]));
+                        } else {
+                                chunk.vertex_normal_list.emplace_back(
+                                        create_vector(vertex_data[0], vertex_data[1], vertex_data[2]));
+                        }
+
+                        chunk.unknown_tokens += line_tokens.size() - 4;
+                        return true;
+                }
+
+                /// ------------------------------------------------------------
+                /// face data, indices are validated by the merge pass
+                if (cmd == std::string_view("f")) {
+                        obj_chunk_face face;
+                        face.num_vertices_before = chunk.vertex_list.size();
+                        face.num_normals_before  = chunk.vertex_normal_list.size();
+                        face.num_groups_before   = chunk.num_groups;
+
+                        for (size_t i = 1; i < line_tokens.size(); i++) {
+                                auto face_indices = split(line_tokens[i], "/");
+                                if (face_indices.empty() || (face_indices.size() > 3)) {
+                                        LOG_ERROR("bad face token:'%s'", std::string(line_tokens[i]).c_str());
+                                        return false;
+                                }
+
+                                auto maybe_face_v_i = parse_token_value_as_number<int32_t>(face_indices[0]);
+                                if (!maybe_face_v_i.has_value()) {
+                                        return false;
+                                }
+
+                                int32_t vn_i = 0;
+                                if (face_indices.size() > 1) {
+                                        auto maybe_face_vn_i =
+                                                parse_token_value_as_number<int32_t>(face_indices.back());
+                                        vn_i = maybe_face_vn_i.has_value() ? maybe_face_vn_i.value() : 0;
+                                }
+
+                                face.vertices.emplace_back(face_vi_vni(maybe_face_v_i.value(), vn_i));
+                        }
+
+                        if (face.vertices.size() < 3) {
+                                return false;
+                        }
+
+                        chunk.face_list.push_back(std::move(face));
+                        return true;
+                }
+
+                /// ------------------------------------------------------------
+                /// named group
+                if (cmd == std::string_view("g")) {
+                        if (line_tokens.size() < 2) {
+                                return false;
+                        }
+
+                        chunk.num_groups += 1;
+                        chunk.unknown_tokens += line_tokens.size() - 2;
+                        return true;
+                }
+
+                chunk.unknown_tokens += line_tokens.size();
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to build triangles for all faces of a
+        /// chunk.
+        ///
+        /// a face can only refer to vertices (and vertex-normals) that precede
+        /// it in the input, and relative (negative) indices are resolved
+        /// against exactly those.
+        void obj_file_parser::build_chunk_triangles(obj_chunk_parse_result& chunk,
+                                                    obj_parse_result const& result) const
+        {
+                /// ------------------------------------------------------------
+                /// resolve an index against 'n' preceding elements. returns '0'
+                /// for invalid indices.
+                auto resolve_index = [](int32_t i, size_t n) -> int32_t {
+                        if ((i > 0) && (static_cast<size_t>(i) <= n)) {
+                                return i;
+                        }
+
+                        if ((i < 0) && (static_cast<size_t>(-static_cast<int64_t>(i)) <= n)) {
+                                return static_cast<int32_t>(n + i + 1);
+                        }
+
+                        return 0;
+                };
+
+                chunk.face_triangles.reserve(chunk.face_list.size());
+
+                for (size_t fi = 0; fi < chunk.face_list.size(); fi++) {
+                        auto const& face = chunk.face_list[fi];
+                        auto const nv    = chunk.vertex_offset + face.num_vertices_before;
+                        auto const nvn   = chunk.normal_offset + face.num_normals_before;
+
+                        std::vector<face_vi_vni> abs_vertices;
+                        abs_vertices.reserve(face.vertices.size());
+
+                        bool all_normals = true;
+                        for (auto const& vi_vni : face.vertices) {
+                                auto const v_i  = resolve_index(vi_vni.vi(), nv);
+                                auto const vn_i = (vi_vni.vni() == 0) ? 0 : resolve_index(vi_vni.vni(), nvn);
+
+                                if ((v_i == 0) || ((vi_vni.vni() != 0) && (vn_i == 0))) {
+                                        chunk.bad_face_index = fi;
+                                        return;
+                                }
+
+                                all_normals = all_normals && (vn_i != 0);
+                                abs_vertices.emplace_back(face_vi_vni(v_i, vn_i));
+                        }
+
+                        /// ----------------------------------------------------
+                        /// smooth triangles need a normal at every vertex
+                        if (!all_normals) {
+                                for (auto& vi_vni : abs_vertices) {
+                                        vi_vni = face_vi_vni(vi_vni.vi(), 0);
+                                }
+                        }
+
+                        /// ----------------------------------------------------
+                        /// fan triangulation
+                        std::vector<std::shared_ptr<triangle>> face_triangles;
+                        for (size_t i = 1; i < abs_vertices.size() - 1; i++) {
+                                auto const& pt_1 = abs_vertices[0];
+                                auto const& pt_2 = abs_vertices[i];
+                                auto const& pt_3 = abs_vertices[i + 1];
+
+                                auto tri = create_triangle_from_face_data(result, pt_1, pt_2, pt_3);
+                                chunk.triangle_indices.push_back(
+                                        create_triangle_indices(result, tri.get(), pt_1, pt_2, pt_3));
+
+                                face_triangles.push_back(std::move(tri));
+                        }
+
+                        chunk.face_triangles.push_back(std::move(face_triangles));
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// parse a double from [begin .. end). returns a pointer to the first
+        /// character that is not part of the number, or nullptr if no number
+        /// could be parsed.
+        char const* obj_file_parser::parse_double_fast(char const* begin, char const* end, double& val) const
+        {
+                /*
+                 * note
+                 * ====
+                 * on MacOS llvm / clang++ does not yet (as of Apr 16, 2025)
+                 * support 'std::from_chars(...)' for 'double'.
+                 *
+                 * so we fall back to strtod(...) there, as well as for values
+                 * that from_chars(...) doesn't accept f.e. ones with a
+                 * leading '+'.
+                 **/
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+                auto [p, ec] = std::from_chars(begin, end, val);
+                if (ec == std::errc()) {
+                        return p;
+                }
+#endif
+                /// ------------------------------------------------------------
+                /// input is not nul-terminated, and strtod(...) could run past
+                /// 'end', so parse a (bounded) copy instead.
+                constexpr size_t MAX_NUMBER_LEN = 64;
+                size_t const num_len            = std::min<size_t>(end - begin, MAX_NUMBER_LEN - 1);
+
+                char num_buf[MAX_NUMBER_LEN];
+                memcpy(num_buf, begin, num_len);
+                num_buf[num_len] = '\0';
+
+                char* num_end = num_buf;
+                val           = strtod(num_buf, &num_end);
+
+                if (num_end == num_buf) {
+                        return nullptr;
+                }
+
+                return begin + (num_end - num_buf);
+        }
+
         /// --------------------------------------------------------------------
         /// parse 'string_view' as a number (int/float/double/...)
         template <typename T>
@@ -595,17 +1310,6 @@ namespace raytracer
                 /// to parse this value.
                 T ret = {};
 
-                /*
-                 * note
-                 * ====
-                 * on MacOS llvm / clang++ does not yet (as of Apr 16, 2025)
-                 * support 'std::from_chars(...)' for 'double'.
-                 *
-                 * once that happens this can go away.
-                 *
-                 * although, this *looks* ugly, but it is ensconsed in a
-                 * 'constexpr' so, runtime penalty is not really there.
-                 **/
                 if constexpr (std::is_same_v<int32_t, T>) {
                         auto [p, ec] = std::from_chars(val_begin, val_end, ret);
 
@@ -614,12 +1318,7 @@ namespace raytracer
                                 return std::nullopt;
                         }
                 } else if constexpr (std::is_same_v<double, T>) {
-                        const char* tok_begin = val_begin;
-                        char* tok_end         = const_cast<char*>(tok_begin);
-
-                        ret = strtod(tok_begin, &tok_end);
-
-                        if (tok_end != val_end) {
+                        if (parse_double_fast(val_begin, val_end, ret) != val_end) {
                                 LOG_ERROR("bad token value:'%s'", std::string(tok_val).c_str());
                                 return std::nullopt;
                         }
@@ -12,17 +12,20 @@
 #include <stdint.h>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 /// our includes
 #include "io/obj_parse_result.hpp"
 #include "platform_utils/mmapped_file_reader.hpp"
+#include "utils/utils.hpp"
 
 namespace raytracer
 {
         /// --------------------------------------------------------------------
         /// forward declarations
         class triangle;
+        class obj_chunk_parse_result;
 
         /// --------------------------------------------------------------------
         /// a token from an obj file. obj file tokens are simply character
@@ -115,12 +118,31 @@ namespace raytracer
                 /// end-index: ri will always be less than this.
                 size_t const ei;
 
+            public:
+                /// ------------------------------------------------------------
+                /// chunks smaller than this are not worth a thread of their own
+                static constexpr size_t PARALLEL_PARSE_MIN_CHUNK_SIZE = 64 * 1024;
+
             public:
                 obj_file_parser(std::string file_name);
 
             public:
                 obj_parse_result parse() const;
 
+                /// ------------------------------------------------------------
+                /// parse the file using upto 'num_threads' threads.
+                ///
+                /// the mmapped file is split into chunks at line boundaries,
+                /// each chunk is tokenized concurrently into chunk-local
+                /// vertex, vertex-normal and face lists, and a merge pass then
+                /// resolves (relative) indices and named-group order. the
+                /// result is equivalent to the one returned by 'parse()'.
+                ///
+                /// 'min_chunk_size' (in bytes) keeps small inputs from being
+                /// split into too many (tiny) chunks.
+                obj_parse_result parse_parallel(uint32_t num_threads  = max_cores(),
+                                                size_t min_chunk_size = PARALLEL_PARSE_MIN_CHUNK_SIZE) const;
+
             private:
                 /// ------------------------------------------------------------
                 /// this is the lexer for OBJ formatted files. it extracts the
@@ -200,6 +222,14 @@ namespace raytracer
                                                                          face_vi_vni const& pt_2,
                                                                          face_vi_vni const& pt_3) const;
 
+                /// ------------------------------------------------------------
+                /// '0' based indices of a triangle 'tri', created from face
+                /// vertex and vertex-normal index
+                obj_triangle_indices create_triangle_indices(obj_parse_result const& result,
+                                                             triangle const* tri, face_vi_vni const& pt_1,
+                                                             face_vi_vni const& pt_2,
+                                                             face_vi_vni const& pt_3) const;
+
                 /// ------------------------------------------------------------
                 /// parse face polygon data
                 bool parse_face_polygon_data(obj_parse_result& result,
@@ -221,6 +251,52 @@ namespace raytracer
                 /// parse a string_view as a number (int/float/double/...)
                 template <typename T>
                 std::optional<T> parse_token_value_as_number(std::string_view const& tok_val) const;
+
+                /// ------------------------------------------------------------
+                /// parse a double from [begin .. end), returning end of the
+                /// parsed number, or nullptr when there is none
+                char const* parse_double_fast(char const* begin, char const* end, double& val) const;
+
+                /*
+                 * following routines are used by parse_parallel(...) only.
+                 *
+                 * unlike the lexer above, these don't use the shared
+                 * read-index 'ri', and are therefore safe to be invoked
+                 * concurrently on disjoint chunks of the input.
+                 **/
+
+                /// ------------------------------------------------------------
+                /// split the input into (at most) 'num_chunks' chunks of
+                /// [start, end) indices. chunks always end at a line boundary
+                /// which is not preceded by a line-continuation.
+                std::vector<std::pair<size_t, size_t>> split_at_line_boundaries(size_t num_chunks) const;
+
+                /// ------------------------------------------------------------
+                /// does the line ending at 'eol_index' continue onto the next
+                /// one ? i.e. is its last token a line-continuation ?
+                bool line_is_continued(char const* data, size_t eol_index) const;
+
+                /// ------------------------------------------------------------
+                /// parse all lines from a single chunk into 'chunk'
+                void parse_chunk(obj_chunk_parse_result& chunk, char const* data) const;
+
+                /// ------------------------------------------------------------
+                /// fast path for parsing 'v', 'vn' and 'f' lines. returns
+                /// 'false' when the line must be parsed by the generic path.
+                bool parse_chunk_line_fast(obj_chunk_parse_result& chunk, char const* line,
+                                           size_t line_len) const;
+
+                /// ------------------------------------------------------------
+                /// parse a single (logical) line of input, which has already
+                /// been split into tokens. returns 'false' on errors.
+                bool parse_chunk_line(obj_chunk_parse_result& chunk,
+                                      std::vector<std::string_view> const& line_tokens) const;
+
+                /// ------------------------------------------------------------
+                /// build triangles for all faces in a chunk, once vertex and
+                /// vertex-normal lists from all chunks have been merged.
+                void build_chunk_triangles(obj_chunk_parse_result& chunk,
+                                           obj_parse_result const& result) const;
         };
 
 } // namespace raytracer
@@ -0,0 +1,555 @@
+/*
+ * this file implements the binary cache for parsed OBJ files
+ **/
+#include "io/obj_mesh_cache.hpp"
+
+/// c++ includes
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/obj_file_loader.hpp"
+#include "io/obj_parse_result.hpp"
+#include "platform_utils/mmapped_file_reader.hpp"
+#include "primitives/tuple.hpp"
+#include "shapes/group.hpp"
+#include "shapes/shape_interface.hpp"
+#include "shapes/triangle.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// kinds of bvh-nodes in the cache
+        constexpr uint32_t OBJ_MESH_CACHE_NODE_GROUP    = 0;
+        constexpr uint32_t OBJ_MESH_CACHE_NODE_TRIANGLE = 1;
+
+        /// --------------------------------------------------------------------
+        /// 'vertex-normal-index' of flat triangles
+        constexpr int32_t OBJ_MESH_CACHE_NO_NORMAL = -1;
+
+        /// --------------------------------------------------------------------
+        /// the cache file header. it is followed by the vertex, vertex-normal,
+        /// triangle and bvh-node arrays, in that order.
+        ///
+        /// all fields are 4 or 8 bytes wide, and the header size is a multiple
+        /// of 8 bytes, so all the arrays that follow are suitably aligned in
+        /// the mmapped file.
+        class obj_mesh_cache_header final
+        {
+            public:
+                uint32_t magic   = OBJ_MESH_CACHE_MAGIC;
+                uint32_t version = OBJ_MESH_CACHE_VERSION;
+
+                /// ------------------------------------------------------------
+                /// source OBJ file details
+                uint64_t src_size     = 0;
+                uint64_t src_mtime_ns = 0;
+                uint64_t src_hash     = 0;
+
+                /// ------------------------------------------------------------
+                /// parse-result details
+                uint32_t divide_threshold = 0;
+                uint32_t unknown_tokens   = 0;
+                uint32_t bad_faces        = 0;
+                uint32_t num_roots        = 0;
+
+                /// ------------------------------------------------------------
+                /// array sizes
+                uint64_t num_vertices  = 0;
+                uint64_t num_normals   = 0;
+                uint64_t num_triangles = 0;
+                uint64_t num_nodes     = 0;
+
+            public:
+                /// ------------------------------------------------------------
+                /// total size (in bytes) of a cache file described by this
+                /// header
+                size_t cache_file_size() const
+                {
+                        return sizeof(obj_mesh_cache_header) +     /// header
+                               num_vertices * 3 * sizeof(float) +  /// vertices
+                               num_normals * 3 * sizeof(float) +   /// vertex-normals
+                               num_triangles * 6 * sizeof(int32_t) + /// triangles
+                               num_nodes * 3 * sizeof(uint32_t);   /// bvh-nodes
+                }
+        };
+
+        static_assert(sizeof(obj_mesh_cache_header) % 8 == 0, "cache arrays must remain aligned");
+
+        /// --------------------------------------------------------------------
+        /// a zero-copy view of the arrays in an mmapped cache file
+        class obj_mesh_cache_view final
+        {
+            public:
+                obj_mesh_cache_header const* header = nullptr;
+                float const* vertices               = nullptr;
+                float const* normals                = nullptr;
+                int32_t const* triangles            = nullptr;
+                uint32_t const* nodes               = nullptr;
+        };
+
+        /// --------------------------------------------------------------------
+        /// contents of a cache file, in memory
+        class obj_mesh_cache_data final
+        {
+            public:
+                obj_mesh_cache_header header;
+                std::vector<float> vertices;
+                std::vector<float> normals;
+                std::vector<int32_t> triangles;
+                std::vector<uint32_t> nodes;
+
+            public:
+                obj_mesh_cache_view view() const
+                {
+                        return {&header, vertices.data(), normals.data(), triangles.data(), nodes.data()};
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// forward declarations of file-local routines
+        static uint64_t hash_file_data(void const* data, size_t size);
+        static void set_source_details(std::string const& obj_file_name, obj_mesh_cache_header& header);
+        static bool create_obj_mesh_cache_data(std::string const& obj_file_name, size_t divide_threshold,
+                                               obj_parse_result const& result, obj_mesh_cache_data& data);
+        static bool write_obj_mesh_cache_data(std::string const& obj_file_name,
+                                              obj_mesh_cache_data const& data);
+        static std::optional<obj_parse_result> create_result_from_cache(obj_mesh_cache_view const& view);
+        static std::shared_ptr<shape_interface> create_shape_from_cache(obj_mesh_cache_view const& view,
+                                                                        obj_parse_result& result,
+                                                                        uint64_t node_index);
+
+        /// --------------------------------------------------------------------
+        /// return the name of the cache file for an OBJ file
+        std::string obj_mesh_cache_file_name(std::string const& obj_file_name)
+        {
+                return obj_file_name + OBJ_MESH_CACHE_SUFFIX;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to write the parse-result of an OBJ file
+        /// into its cache file.
+        bool write_obj_mesh_cache(std::string const& obj_file_name, size_t divide_threshold,
+                                  obj_parse_result const& result)
+        {
+                obj_mesh_cache_data data;
+
+                if (!create_obj_mesh_cache_data(obj_file_name, divide_threshold, result, data)) {
+                        return false;
+                }
+
+                set_source_details(obj_file_name, data.header);
+
+                return write_obj_mesh_cache_data(obj_file_name, data);
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to read the cache file for an OBJ file.
+        ///
+        /// vertex, vertex-normal, triangle and bvh-node arrays are used
+        /// straight out of the mmapped cache file.
+        std::optional<obj_parse_result> read_obj_mesh_cache(std::string const& obj_file_name,
+                                                            size_t divide_threshold)
+        {
+                auto const cache_fname = obj_mesh_cache_file_name(obj_file_name);
+
+                /// ------------------------------------------------------------
+                /// no cache file (or a truncated one)
+                struct stat cache_info;
+                if ((stat(cache_fname.c_str(), &cache_info) != 0) ||
+                    (static_cast<size_t>(cache_info.st_size) < sizeof(obj_mesh_cache_header))) {
+                        return std::nullopt;
+                }
+
+                platform_utils::mmapped_file_reader cache(cache_fname);
+                auto const* cache_data = static_cast<char const*>(cache.data());
+                auto const& header     = *reinterpret_cast<obj_mesh_cache_header const*>(cache_data);
+
+                if ((header.magic != OBJ_MESH_CACHE_MAGIC) || (header.version != OBJ_MESH_CACHE_VERSION) ||
+                    (header.divide_threshold != divide_threshold) || (header.num_roots == 0) ||
+                    (header.num_roots > header.num_nodes) || (header.cache_file_size() != cache.size())) {
+                        LOG_INFO("mesh cache: '%s' is stale", cache_fname.c_str());
+                        return std::nullopt;
+                }
+
+                /// ------------------------------------------------------------
+                /// cheap checks first, hashing the source only when these pass
+                {
+                        platform_utils::mmapped_file_reader src(obj_file_name);
+
+                        if ((header.src_size != src.size()) || (header.src_mtime_ns != src.mtime_ns()) ||
+                            (header.src_hash != hash_file_data(src.data(), src.size()))) {
+                                LOG_INFO("mesh cache: '%s' is stale", cache_fname.c_str());
+                                return std::nullopt;
+                        }
+                }
+
+                obj_mesh_cache_view view;
+                view.header    = &header;
+                view.vertices  = reinterpret_cast<float const*>(cache_data + sizeof(header));
+                view.normals   = view.vertices + 3 * header.num_vertices;
+                view.triangles = reinterpret_cast<int32_t const*>(view.normals + 3 * header.num_normals);
+                view.nodes     = reinterpret_cast<uint32_t const*>(view.triangles + 6 * header.num_triangles);
+
+                auto maybe_result = create_result_from_cache(view);
+                if (!maybe_result.has_value()) {
+                        LOG_ERROR("mesh cache: '%s' is corrupt", cache_fname.c_str());
+                }
+
+                return maybe_result;
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to load an OBJ file, using its cache when
+        /// possible.
+        obj_parse_result load_obj_file_cached(std::string const& obj_file_name, size_t divide_threshold)
+        {
+                if (auto maybe_cached = read_obj_mesh_cache(obj_file_name, divide_threshold)) {
+                        LOG_INFO("'%s' loaded from mesh cache", obj_file_name.c_str());
+                        return std::move(maybe_cached.value());
+                }
+
+                obj_file_parser parser(obj_file_name);
+                auto result = parser.parse_parallel();
+
+                if (divide_threshold != 0) {
+                        result.default_group_ref()->divide(divide_threshold);
+                        for (auto& g : result.group_list_ref()) {
+                                g->divide(divide_threshold);
+                        }
+                }
+
+                /// ------------------------------------------------------------
+                /// vertices are stored as floats in the cache. so, the result
+                /// is rebuilt from what is cached, which ensures that we
+                /// render the exact same geometry every time.
+                obj_mesh_cache_data data;
+                if (!create_obj_mesh_cache_data(obj_file_name, divide_threshold, result, data)) {
+                        return result;
+                }
+
+                set_source_details(obj_file_name, data.header);
+                write_obj_mesh_cache_data(obj_file_name, data);
+
+                if (auto maybe_cached = create_result_from_cache(data.view())) {
+                        return std::move(maybe_cached.value());
+                }
+
+                return result;
+        }
+
+        /*
+         * only file-local functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// fnv-1a hash of file contents, a word at a time.
+        static uint64_t hash_file_data(void const* data, size_t size)
+        {
+                constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+                constexpr uint64_t FNV_PRIME        = 0x100000001b3ULL;
+
+                auto const* bytes = static_cast<unsigned char const*>(data);
+                uint64_t h        = FNV_OFFSET_BASIS;
+                size_t i          = 0;
+
+                for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+                        uint64_t word;
+                        memcpy(&word, bytes + i, sizeof(word));
+
+                        h = (h ^ word) * FNV_PRIME;
+                }
+
+                for (; i < size; i++) {
+                        h = (h ^ bytes[i]) * FNV_PRIME;
+                }
+
+                return h;
+        }
+
+        /// --------------------------------------------------------------------
+        /// size, modification time and hash of the source OBJ file
+        static void set_source_details(std::string const& obj_file_name, obj_mesh_cache_header& header)
+        {
+                platform_utils::mmapped_file_reader src(obj_file_name);
+
+                header.src_size     = src.size();
+                header.src_mtime_ns = src.mtime_ns();
+                header.src_hash     = hash_file_data(src.data(), src.size());
+        }
+
+        /// --------------------------------------------------------------------
+        /// flatten the parse-result of an OBJ file into the arrays of its
+        /// cache. triangles are written with the indices of the face that
+        /// they were created from.
+        static bool create_obj_mesh_cache_data(std::string const& obj_file_name, size_t divide_threshold,
+                                               obj_parse_result const& result, obj_mesh_cache_data& data)
+        {
+                auto& header            = data.header;
+                header.divide_threshold = divide_threshold;
+                header.unknown_tokens   = result.unknown_tokens_cref();
+                header.bad_faces        = result.bad_faces_cref();
+
+                /// ------------------------------------------------------------
+                /// vertex and vertex-normal arrays
+                data.vertices.reserve(3 * result.vertex_list_cref().size());
+                for (auto const& v : result.vertex_list_cref()) {
+                        data.vertices.insert(data.vertices.end(), {float(v.x()), float(v.y()), float(v.z())});
+                }
+
+                data.normals.reserve(3 * result.vertex_normal_list_cref().size());
+                for (auto const& vn : result.vertex_normal_list_cref()) {
+                        auto const xyz = {float(vn.x()), float(vn.y()), float(vn.z())};
+                        data.normals.insert(data.normals.end(), xyz);
+                }
+
+                /// ------------------------------------------------------------
+                /// triangles sorted by address, for looking up their indices
+                auto const& til = result.triangle_indices_cref();
+
+                std::vector<obj_triangle_indices const*> sorted_til;
+                sorted_til.reserve(til.size());
+                for (auto const& ti : til) {
+                        sorted_til.push_back(&ti);
+                }
+
+                std::sort(sorted_til.begin(), sorted_til.end(),
+                          [](auto const* a, auto const* b) { return std::less<>{}(a->tri, b->tri); });
+
+                /// ------------------------------------------------------------
+                /// flatten the group hierarchy, in breadth-first order, into
+                /// bvh-nodes. this ensures that children of a group are
+                /// always contiguous, and that roots are the first few nodes.
+                std::vector<std::shared_ptr<shape_interface const>> node_shapes;
+
+                node_shapes.push_back(result.default_group_cref());
+                for (auto const& g : result.group_list_cref()) {
+                        node_shapes.push_back(g);
+                }
+                header.num_roots = node_shapes.size();
+
+                for (size_t i = 0; i < node_shapes.size(); i++) {
+                        auto const* shape = node_shapes[i].get();
+
+                        if (auto const* g = dynamic_cast<group const*>(shape)) {
+                                auto const& children = g->child_shapes_cref();
+                                data.nodes.insert(data.nodes.end(),
+                                                  {OBJ_MESH_CACHE_NODE_GROUP,
+                                                   static_cast<uint32_t>(node_shapes.size()),
+                                                   static_cast<uint32_t>(children.size())});
+
+                                node_shapes.insert(node_shapes.end(), children.begin(), children.end());
+                                continue;
+                        }
+
+                        auto const* t = dynamic_cast<triangle const*>(shape);
+                        if (t == nullptr) {
+                                LOG_ERROR("unsupported shape:'%s' in '%s'", shape->stringify().c_str(),
+                                          obj_file_name.c_str());
+                                return false;
+                        }
+
+                        auto const til_less = [](auto const* ti, triangle const* key) {
+                                return std::less<>{}(ti->tri, key);
+                        };
+
+                        auto iter = std::lower_bound(sorted_til.begin(), sorted_til.end(), t, til_less);
+
+                        if ((iter == sorted_til.end()) || ((*iter)->tri != t)) {
+                                LOG_ERROR("triangle:'%s' without face indices in '%s'",
+                                          t->stringify().c_str(), obj_file_name.c_str());
+                                return false;
+                        }
+
+                        auto const& ti = **iter;
+                        auto const tri_index = static_cast<uint32_t>(data.triangles.size() / 6);
+                        data.nodes.insert(data.nodes.end(), {OBJ_MESH_CACHE_NODE_TRIANGLE, tri_index, 0});
+                        data.triangles.insert(data.triangles.end(), ti.vertices.begin(), ti.vertices.end());
+                        data.triangles.insert(data.triangles.end(), ti.normals.begin(), ti.normals.end());
+                }
+
+                header.num_vertices  = result.vertex_list_cref().size();
+                header.num_normals   = result.vertex_normal_list_cref().size();
+                header.num_triangles = data.triangles.size() / 6;
+                header.num_nodes     = data.nodes.size() / 3;
+
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// write the cache file for an OBJ file.
+        ///
+        /// the cache is written to a temporary file first, which is then
+        /// renamed. so concurrent readers never get to see a partially
+        /// written cache.
+        static bool write_obj_mesh_cache_data(std::string const& obj_file_name,
+                                              obj_mesh_cache_data const& data)
+        {
+                auto const& header     = data.header;
+                auto const cache_fname = obj_mesh_cache_file_name(obj_file_name);
+                auto const tmp_fname   = cache_fname + ".tmp." + std::to_string(getpid());
+
+                FILE* dst_file = fopen(tmp_fname.c_str(), "wb");
+                if (dst_file == nullptr) {
+                        LOG_ERROR("failed writing: '%s'. reason: '%s'", tmp_fname.c_str(), strerror(errno));
+                        return false;
+                }
+
+                auto write_array = [dst_file](auto const& array) {
+                        using T = typename std::decay_t<decltype(array)>::value_type;
+                        return fwrite(array.data(), sizeof(T), array.size(), dst_file) == array.size();
+                };
+
+                bool write_ok = (fwrite(&header, sizeof(header), 1, dst_file) == 1);
+                write_ok      = write_ok && write_array(data.vertices);
+                write_ok      = write_ok && write_array(data.normals);
+                write_ok      = write_ok && write_array(data.triangles);
+                write_ok      = write_ok && write_array(data.nodes);
+                write_ok      = (fclose(dst_file) == 0) && write_ok;
+
+                if (!write_ok || (rename(tmp_fname.c_str(), cache_fname.c_str()) != 0)) {
+                        LOG_ERROR("failed writing: '%s'. reason: '%s'", cache_fname.c_str(), strerror(errno));
+                        unlink(tmp_fname.c_str());
+                        return false;
+                }
+
+                LOG_INFO("mesh cache written: '%s' (%zu bytes)", cache_fname.c_str(),
+                         header.cache_file_size());
+                return true;
+        }
+
+        /// --------------------------------------------------------------------
+        /// rebuild the parse-result from the arrays of a cache. returns
+        /// std::nullopt for malformed caches.
+        static std::optional<obj_parse_result> create_result_from_cache(obj_mesh_cache_view const& view)
+        {
+                auto const& header = *view.header;
+
+                obj_parse_result result;
+                result.unknown_tokens_ref() = header.unknown_tokens;
+                result.bad_faces_ref()      = header.bad_faces;
+
+                auto& vertex_list = result.vertex_list_ref();
+                vertex_list.reserve(header.num_vertices);
+                for (size_t i = 0; i < header.num_vertices; i++) {
+                        auto const* v = view.vertices + 3 * i;
+                        vertex_list.emplace_back(create_point(v[0], v[1], v[2]));
+                }
+
+                auto& vertex_normal_list = result.vertex_normal_list_ref();
+                vertex_normal_list.reserve(header.num_normals);
+                for (size_t i = 0; i < header.num_normals; i++) {
+                        auto const* vn = view.normals + 3 * i;
+                        vertex_normal_list.emplace_back(create_vector(vn[0], vn[1], vn[2]));
+                }
+
+                result.triangle_indices_ref().reserve(header.num_triangles);
+
+                /// ------------------------------------------------------------
+                /// rebuild the default group and named groups
+                for (uint32_t i = 0; i < header.num_roots; i++) {
+                        auto const shape = create_shape_from_cache(view, result, i);
+                        auto root        = std::dynamic_pointer_cast<group>(shape);
+                        if (root == nullptr) {
+                                return std::nullopt;
+                        }
+
+                        if (i == 0) {
+                                result.default_group_ref() = root;
+                        } else {
+                                result.group_list_ref().push_back(root);
+                        }
+                }
+
+                return result;
+        }
+
+        /// --------------------------------------------------------------------
+        /// create the shape for a bvh-node (and all its descendants).
+        ///
+        /// children are added to a group only once they are completely built,
+        /// so that the group's bounding box is correct. returns 'nullptr' for
+        /// malformed nodes.
+        static std::shared_ptr<shape_interface> create_shape_from_cache(obj_mesh_cache_view const& view,
+                                                                        obj_parse_result& result,
+                                                                        uint64_t node_index)
+        {
+                auto const* node = view.nodes + 3 * node_index;
+
+                if (node[0] == OBJ_MESH_CACHE_NODE_TRIANGLE) {
+                        if (node[1] >= view.header->num_triangles) {
+                                return nullptr;
+                        }
+
+                        auto const* tri = view.triangles + 6 * node[1];
+                        for (size_t i = 0; i < 3; i++) {
+                                if ((tri[i] < 0) || (static_cast<uint64_t>(tri[i]) >= view.header->num_vertices)) {
+                                        return nullptr;
+                                }
+                        }
+
+                        obj_triangle_indices ti;
+                        ti.vertices = {tri[0], tri[1], tri[2]};
+
+                        std::shared_ptr<triangle> new_triangle;
+
+                        auto const& vl = result.vertex_list_cref();
+                        if (tri[3] == OBJ_MESH_CACHE_NO_NORMAL) {
+                                new_triangle = std::make_shared<triangle>(vl[tri[0]], vl[tri[1]], vl[tri[2]]);
+                        } else {
+                                for (size_t i = 3; i < 6; i++) {
+                                        if ((tri[i] < 0) ||
+                                            (static_cast<uint64_t>(tri[i]) >= view.header->num_normals)) {
+                                                return nullptr;
+                                        }
+                                }
+
+                                auto const& vnl = result.vertex_normal_list_cref();
+                                new_triangle    = std::make_shared<triangle>(
+                                        vl[tri[0]], vl[tri[1]], vl[tri[2]],     /// vertices
+                                        vnl[tri[3]], vnl[tri[4]], vnl[tri[5]]); /// normals
+                                ti.normals      = {tri[3], tri[4], tri[5]};
+                        }
+
+                        ti.tri = new_triangle.get();
+                        result.triangle_indices_ref().push_back(ti);
+
+                        return new_triangle;
+                }
+
+                /// ------------------------------------------------------------
+                /// children always follow their parent in breadth-first order,
+                /// which also guarantees that we terminate
+                uint64_t const first = node[1];
+                uint64_t const count = node[2];
+                if ((node[0] != OBJ_MESH_CACHE_NODE_GROUP) || (first <= node_index) ||
+                    (first + count > view.header->num_nodes)) {
+                        return nullptr;
+                }
+
+                auto new_group = std::make_shared<group>();
+                for (uint64_t i = first; i < first + count; i++) {
+                        auto child = create_shape_from_cache(view, result, i);
+                        if (child == nullptr) {
+                                return nullptr;
+                        }
+
+                        new_group->add_child(child);
+                }
+
+                return new_group;
+        }
+
+} // namespace raytracer
@@ -0,0 +1,80 @@
+#pragma once
+
+/*
+ * this file implements a binary cache for parsed OBJ files.
+ *
+ * parsing a large OBJ file, and then dividing the resulting groups into a
+ * bounding-volume hierarchy takes a while. the cache is written next to the
+ * OBJ file on first load, and on subsequent loads, it is mmapped and the
+ * groups are rebuilt directly from it. no parsing or dividing is required.
+ *
+ * cache file layout (all values in native byte order):
+ *
+ *    +--------------------------------------------------+
+ *    | header: magic, version, source file size, mtime, |
+ *    |         hash, divide-threshold, counts...        |
+ *    +--------------------------------------------------+
+ *    | vertices       : float[3 * num_vertices]         |
+ *    | vertex-normals : float[3 * num_normals]          |
+ *    | triangles      : int32[6 * num_triangles]        |
+ *    |                  (3 vertex + 3 normal indices)   |
+ *    | bvh-nodes      : uint32[3 * num_nodes]           |
+ *    |                  (kind, first, count)            |
+ *    +--------------------------------------------------+
+ *
+ * the cache is invalidated when the source file's size, modification time or
+ * contents (hash) change, or when it was created with a different divide
+ * threshold.
+ **/
+
+/// c++ includes
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/// our includes
+#include "io/obj_parse_result.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// identifies the cache file and the version of its layout. the
+        /// version must be bumped whenever the layout changes.
+        constexpr uint32_t OBJ_MESH_CACHE_MAGIC   = 0x434d5452; /// 'RTMC'
+        constexpr uint32_t OBJ_MESH_CACHE_VERSION = 1;
+
+        /// --------------------------------------------------------------------
+        /// cache file for 'foo.obj' is 'foo.obj.rtmc'
+        constexpr char const* OBJ_MESH_CACHE_SUFFIX = ".rtmc";
+
+        /// --------------------------------------------------------------------
+        /// return the name of the cache file for an OBJ file
+        std::string obj_mesh_cache_file_name(std::string const& obj_file_name);
+
+        /// --------------------------------------------------------------------
+        /// write 'result' (parsed from 'obj_file_name' and divided with
+        /// 'divide_threshold') into the cache file.
+        ///
+        /// returns 'true' if the cache was written, 'false' otherwise.
+        bool write_obj_mesh_cache(std::string const& obj_file_name, size_t divide_threshold,
+                                  obj_parse_result const& result);
+
+        /// --------------------------------------------------------------------
+        /// read the cache file for 'obj_file_name'.
+        ///
+        /// returns std::nullopt when the cache file doesn't exist or is stale.
+        std::optional<obj_parse_result> read_obj_mesh_cache(std::string const& obj_file_name,
+                                                            size_t divide_threshold);
+
+        /// --------------------------------------------------------------------
+        /// load an OBJ file, via its cache when possible.
+        ///
+        /// when the cache is missing or stale, the OBJ file is parsed, the
+        /// default and named groups are divided with 'divide_threshold' (a
+        /// threshold of '0' implies no division), and the cache is written
+        /// for the next time around. the result returned then is built from
+        /// the in-memory cache contents, without reading the file back.
+        obj_parse_result load_obj_file_cached(std::string const& obj_file_name, size_t divide_threshold = 0);
+
+} // namespace raytracer
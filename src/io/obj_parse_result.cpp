@@ -83,6 +83,16 @@ namespace raytracer
                 return this->vertex_normal_list_;
         }
 
+        std::vector<obj_triangle_indices>& obj_parse_result::triangle_indices_ref()
+        {
+                return this->triangle_indices_;
+        }
+
+        std::vector<obj_triangle_indices> const& obj_parse_result::triangle_indices_cref() const
+        {
+                return this->triangle_indices_;
+        }
+
         /// --------------------------------------------------------------------
         /// this function is called to return the reference to the most recent
         /// group that was added
@@ -103,7 +113,7 @@ namespace raytracer
         /// index == 1, 2nd at index == 2 etc.
         tuple const& obj_parse_result::vertex(int32_t i) const
         {
-                i = get_1_based_index(i);
+                i = get_1_based_index(i, vertex_list_.size());
                 return vertex_list_[i];
         }
 
@@ -115,13 +125,11 @@ namespace raytracer
         /// index == 1, 2nd at index == 2 etc.
         std::optional<std::reference_wrapper<tuple const>> obj_parse_result::checked_vertex(int32_t i) const
         {
-                uint32_t k = get_1_based_index(i);
-
-                if (!vertex_index_is_valid(k)) {
+                if (!vertex_index_is_valid(i)) {
                         return std::nullopt;
                 }
 
-                return std::cref(vertex_list_[k]);
+                return std::cref(vertex_list_[get_1_based_index(i, vertex_list_.size())]);
         }
 
         /// --------------------------------------------------------------------
@@ -132,7 +140,7 @@ namespace raytracer
         /// index == 1, 2nd at index == 2 etc.
         tuple const& obj_parse_result::vertex_normal(int32_t i) const
         {
-                i = get_1_based_index(i);
+                i = get_1_based_index(i, vertex_normal_list_.size());
                 return vertex_normal_list_[i];
         }
 
@@ -145,22 +153,20 @@ namespace raytracer
         std::optional<std::reference_wrapper<tuple const>>
         obj_parse_result::checked_vertex_normal(int32_t i) const
         {
-                uint32_t k = get_1_based_index(i);
-
-                if (!vertex_index_is_valid(k)) {
+                if (!vertex_normal_index_is_valid(i)) {
                         return std::nullopt;
                 }
 
-                return std::cref(vertex_normal_list_[k]);
+                return std::cref(vertex_normal_list_[get_1_based_index(i, vertex_normal_list_.size())]);
         }
 
         /// --------------------------------------------------------------------
         /// add support for negative indexes as well
         bool obj_parse_result::vertex_index_is_valid(int32_t i) const
         {
-                uint32_t non_neg_i = get_1_based_index(i);
+                uint32_t non_neg_i = get_1_based_index(i, vertex_list_.size());
 
-                if (non_neg_i > this->vertex_list_.size()) {
+                if (non_neg_i >= this->vertex_list_.size()) {
                         return false;
                 }
 
@@ -171,9 +177,9 @@ namespace raytracer
         /// add support for negative indexes as well
         bool obj_parse_result::vertex_normal_index_is_valid(int32_t i) const
         {
-                uint32_t non_neg_i = get_1_based_index(i);
+                uint32_t non_neg_i = get_1_based_index(i, vertex_normal_list_.size());
 
-                if (non_neg_i > this->vertex_normal_list_.size()) {
+                if (non_neg_i >= this->vertex_normal_list_.size()) {
                         return false;
                 }
 
@@ -200,9 +206,9 @@ namespace raytracer
         }
 
         /// --------------------------------------------------------------------
-        /// return '1' based vertex-index, negative indices are from the end of
-        /// *current* vertex_list.
-        uint32_t obj_parse_result::get_1_based_index(int32_t i) const
+        /// return '1' based index, negative indices are from the end of the
+        /// *current* list (vertex or vertex-normal) being indexed.
+        uint32_t obj_parse_result::get_1_based_index(int32_t i, size_t list_size) const
         {
                 /// ------------------------------------------------------------
                 /// most common case
@@ -213,7 +219,11 @@ namespace raytracer
                 /// ------------------------------------------------------------
                 /// next common
                 if (i < 0) {
-                        return (this->vertex_list_.size() - std::abs(i));
+                        if (static_cast<size_t>(std::abs(i)) > list_size) {
+                                return std::numeric_limits<int32_t>::max();
+                        }
+
+                        return (list_size - std::abs(i));
                 }
 
                 /// i == 0 is least common ∵ 1 based index
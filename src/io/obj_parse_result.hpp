@@ -6,6 +6,7 @@
  **/
 
 /// c++ includes
+#include <array>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -21,6 +22,19 @@ namespace raytracer
         /// --------------------------------------------------------------------
         /// forward declarations
         class group;
+        class triangle;
+
+        /// --------------------------------------------------------------------
+        /// vertex and vertex-normal indices of a triangle, as they were in the
+        /// face that it was created from. indices are '0' based, and
+        /// vertex-normal indices of flat triangles are '-1'.
+        class obj_triangle_indices final
+        {
+            public:
+                triangle const* tri             = nullptr;
+                std::array<int32_t, 3> vertices = {0, 0, 0};
+                std::array<int32_t, 3> normals  = {-1, -1, -1};
+        };
 
         /// --------------------------------------------------------------------
         /// this describes the result of parsing an obj file
@@ -51,6 +65,11 @@ namespace raytracer
                 /// vertex-normal list
                 std::vector<tuple> vertex_normal_list_ = {};
 
+                /// ------------------------------------------------------------
+                /// indices of each triangle, in the order that they were
+                /// created
+                std::vector<obj_triangle_indices> triangle_indices_ = {};
+
             public:
                 obj_parse_result();
 
@@ -99,6 +118,11 @@ namespace raytracer
                 std::vector<tuple>& vertex_normal_list_ref();
                 std::vector<tuple> const& vertex_normal_list_cref() const;
 
+                /// ------------------------------------------------------------
+                /// ref and const-ref for triangle-indices
+                decltype(triangle_indices_)& triangle_indices_ref();
+                decltype(triangle_indices_) const& triangle_indices_cref() const;
+
                 /// ------------------------------------------------------------
                 /// return 'ith' vertex from the vertex-list. this is a '1'
                 /// based index, so first vertex is at index 'i == 1', second
@@ -141,9 +165,10 @@ namespace raytracer
 
             private:
                 /// ------------------------------------------------------------
-                /// return '1' based vertex index. useful for reading actual
-                /// vertex values
-                uint32_t get_1_based_index(int32_t i) const;
+                /// return '1' based index into a list of 'list_size'
+                /// elements. negative indices are relative to the end of that
+                /// list.
+                uint32_t get_1_based_index(int32_t i, size_t list_size) const;
         };
 
 } // namespace raytracer
@@ -9,6 +9,7 @@
 /// our includes
 #include "patterns/material.hpp"
 #include "primitives/color.hpp"
+#include "primitives/intersection_info.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
 #include "shapes/shape_interface.hpp"
@@ -16,6 +17,16 @@
 
 namespace raytracer
 {
+        /// --------------------------------------------------------------------
+        /// file specific functions
+        static color phong_illumination(material const& surface_material,  /// material
+                                        color const& surface_color,        /// its color where lit
+                                        tuple const& surface_point,        /// where ray intersects surface
+                                        point_light const& incident_light, /// light illuminating the scene
+                                        tuple const& eye_vector,           /// camera || viewer
+                                        tuple const& surface_normal,       /// normal at intersection
+                                        bool is_shadowed);                 /// is the point shadowed ?
+
         /*
          * this function implements the phong reflection model, a brief
          * description of which follows:
@@ -50,17 +61,46 @@ namespace raytracer
                                  tuple const& surface_normal,       /// normal at intersection
                                  bool is_shadowed)                  /// is the point shadowed ?
         {
-                PROFILE_SCOPE;
+                auto const surface_material = shape->get_material();
+
+                return phong_illumination(surface_material, surface_material.get_color(shape, surface_point),
+                                          surface_point, incident_light, eye_vector, surface_normal,
+                                          is_shadowed);
+        }
 
-                // clang-format off
+        /// --------------------------------------------------------------------
+        /// phong illumination at the over-position of a hit
+        color phong_illumination(intersection_info_t const& xs_info, /// the hit
+                                 point_light const& incident_light,  /// light illuminating the scene
+                                 bool is_shadowed)                   /// is the point shadowed ?
+        {
+                auto const surface_material = xs_info.what_object()->get_material();
+
+                return phong_illumination(surface_material, surface_material.get_color(xs_info),
+                                          xs_info.over_position(), incident_light, xs_info.eye_vector(),
+                                          xs_info.normal_vector(), is_shadowed);
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// the phong reflection model, with the color of the surface at
+        /// 'surface_point' known already
+        static color phong_illumination(material const& surface_material,  /// material
+                                        color const& surface_color,        /// its color where lit
+                                        tuple const& surface_point,        /// where ray intersects surface
+                                        point_light const& incident_light, /// light illuminating the scene
+                                        tuple const& eye_vector,           /// camera || viewer
+                                        tuple const& surface_normal,       /// normal at intersection
+                                        bool is_shadowed)                  /// is the point shadowed ?
+        {
+                PROFILE_SCOPE_SAMPLED;
 
                 /// ------------------------------------------------------------
-                /// get the color at a specific point on the shape. each point
-                /// on the shape can have a different color
-                auto const surface_material = shape->get_material();
-                auto const effective_color  = (surface_material.get_color(shape, surface_point) *
-                                               incident_light.get_color());
-                // clang-format on
+                /// each point on the shape can have a different color
+                auto const effective_color = surface_color * incident_light.get_color();
 
                 /// direction of the light-source
                 auto const incident_light_dir = normalize(incident_light.position() - surface_point);
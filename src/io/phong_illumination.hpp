@@ -3,6 +3,7 @@
 /// our includes
 #include "patterns/material.hpp"
 #include "primitives/color.hpp"
+#include "primitives/intersection_info.hpp"
 #include "primitives/point_light.hpp"
 #include "primitives/tuple.hpp"
 #include "shapes/shape_interface.hpp"
@@ -15,4 +16,12 @@ namespace raytracer
                                  tuple const& eye_vector,                /// camera || viewer
                                  tuple const& surface_normal,            /// normal at intersection
                                  bool is_shadowed = false);              /// is the point shadowed ?
+
+        /// --------------------------------------------------------------------
+        /// phong illumination at the over-position of a hit. the color of the
+        /// surface there comes from what the hit carries, see
+        /// 'pattern_interface::color_at_hit(...)'
+        color phong_illumination(intersection_info_t const& xs_info, /// the hit
+                                 point_light const& incident_light,  /// light illuminating the scene
+                                 bool is_shadowed = false);          /// is the point shadowed ?
 }
@@ -0,0 +1,176 @@
+/*
+ * implement the per-pixel cost of rendering, and its heatmaps
+ **/
+
+#include "io/pixel_costs.hpp"
+
+/// c++ includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+#include "primitives/color.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// all metrics, in the order their heatmaps are written
+        static constexpr pixel_cost_metric ALL_PIXEL_COST_METRICS[] = {
+                pixel_cost_metric::PIXEL_COST_CYCLES,
+                pixel_cost_metric::PIXEL_COST_RAYS,
+                pixel_cost_metric::PIXEL_COST_PRIMITIVE_TESTS,
+        };
+
+        /// --------------------------------------------------------------------
+        /// value of a metric for a single pixel
+        static uint64_t metric_value(pixel_cost const& c, pixel_cost_metric const& M)
+        {
+                switch (M) {
+                case pixel_cost_metric::PIXEL_COST_RAYS:
+                        return c.rays;
+
+                case pixel_cost_metric::PIXEL_COST_PRIMITIVE_TESTS:
+                        return c.primitive_tests;
+
+                case pixel_cost_metric::PIXEL_COST_CYCLES:
+                default:
+                        break;
+                }
+
+                return c.cycles;
+        }
+
+        /// --------------------------------------------------------------------
+        /// false-color for 't' in [0.0, 1.0], going from blue, through cyan,
+        /// green and yellow, to red.
+        static color false_color(double t)
+        {
+                static constexpr size_t NUM_STOPS = 5;
+                static constexpr float stops[][3] = {
+                        {0.0f, 0.0f, 1.0f}, /// blue
+                        {0.0f, 1.0f, 1.0f}, /// cyan
+                        {0.0f, 1.0f, 0.0f}, /// green
+                        {1.0f, 1.0f, 0.0f}, /// yellow
+                        {1.0f, 0.0f, 0.0f}, /// red
+                };
+
+                auto const pos   = std::clamp(t, 0.0, 1.0) * (NUM_STOPS - 1);
+                auto const i     = std::min<size_t>(pos, NUM_STOPS - 2);
+                auto const blend = static_cast<float>(pos - i);
+
+                return color(stops[i][0] + (stops[i + 1][0] - stops[i][0]) * blend,
+                             stops[i][1] + (stops[i + 1][1] - stops[i][1]) * blend,
+                             stops[i][2] + (stops[i + 1][2] - stops[i][2]) * blend);
+        }
+
+        /// --------------------------------------------------------------------
+        /// create an instance where all pixels cost nothing
+        pixel_cost_map::pixel_cost_map(uint32_t width, uint32_t height)
+            : width_(width)
+            , height_(height)
+            , costs_(size_t{width} * height)
+        {
+        }
+
+        /// --------------------------------------------------------------------
+        /// render a metric as a false-color heatmap
+        canvas pixel_cost_map::heatmap(pixel_cost_metric const& M) const
+        {
+                auto dst_canvas = canvas::create_binary(width_, height_);
+
+                if (costs_.empty()) {
+                        return dst_canvas;
+                }
+
+                auto const by_metric = [&M](auto const& a, auto const& b) {
+                        return metric_value(a, M) < metric_value(b, M);
+                };
+
+                auto const [lo_it, hi_it] = std::minmax_element(costs_.begin(), costs_.end(), by_metric);
+
+                auto const lo    = metric_value(*lo_it, M);
+                auto const range = std::log1p(double(metric_value(*hi_it, M) - lo));
+
+                for (uint32_t y = 0; y < height_; y++) {
+                        for (uint32_t x = 0; x < width_; x++) {
+                                auto const v = std::log1p(double(metric_value(at(x, y), M) - lo));
+                                dst_canvas.write_pixel(x, y, false_color(range > 0.0 ? v / range : 0.0));
+                        }
+                }
+
+                return dst_canvas;
+        }
+
+        /// --------------------------------------------------------------------
+        /// write heatmaps of all metrics next to 'image_fname', with the same
+        /// format as that of the image.
+        void pixel_cost_map::write_heatmaps(std::string const& image_fname) const
+        {
+                auto const dot_pos = image_fname.find_last_of('.');
+                auto const has_ext = (dot_pos != std::string::npos) &&
+                                     (image_fname.find('/', dot_pos) == std::string::npos);
+
+                auto const stem = has_ext ? image_fname.substr(0, dot_pos) : image_fname;
+                auto const ext  = has_ext ? image_fname.substr(dot_pos) : std::string(".ppm");
+
+                for (auto const M : ALL_PIXEL_COST_METRICS) {
+                        auto const fname = stem + "-" + stringify_pixel_cost_metric(M) + ext;
+
+                        LOG_INFO("writing heatmap: '%s'", fname.c_str());
+                        heatmap(M).write(fname);
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the costs i.e. the costliest pixel
+        /// for each metric
+        std::string pixel_cost_map::stringify() const
+        {
+                std::stringstream ss("");
+
+                ss << "{"
+                   << "width: " << width_ << ", "
+                   << "height: " << height_;
+
+                for (auto const M : ALL_PIXEL_COST_METRICS) {
+                        uint64_t max_value = 0;
+                        for (auto const& c : costs_) {
+                                max_value = std::max(max_value, metric_value(c, M));
+                        }
+
+                        ss << ", max-" << stringify_pixel_cost_metric(M) << ": " << max_value;
+                }
+
+                ss << "}";
+
+                return ss.str();
+        }
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the metric
+        std::string stringify_pixel_cost_metric(pixel_cost_metric const& M)
+        {
+                switch (M) {
+                case pixel_cost_metric::PIXEL_COST_CYCLES:
+                        return "cycles";
+
+                case pixel_cost_metric::PIXEL_COST_RAYS:
+                        return "rays";
+
+                case pixel_cost_metric::PIXEL_COST_PRIMITIVE_TESTS:
+                        return "primitive-tests";
+
+                default:
+                        break;
+                }
+
+                return "unknown";
+        }
+
+} // namespace raytracer
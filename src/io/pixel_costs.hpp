@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+ * this file implements a per-pixel record of the cost of rendering a scene,
+ * along with its rendering as false-color heatmaps.
+ *
+ * heatmaps make it easy to spot where the time goes f.e. large triangles that
+ * straddle the partitions of a group (and are left behind in its root), or
+ * deep recursion through glass.
+ **/
+
+/// c++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "io/canvas.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// cost of rendering a single pixel
+        struct pixel_cost final {
+                uint64_t cycles          = 0; /// see 'utils/cycle_counter.hpp'
+                uint32_t rays            = 0; /// of all kinds
+                uint32_t primitive_tests = 0;
+        };
+
+        /// --------------------------------------------------------------------
+        /// costs that can be rendered as heatmaps
+        enum class pixel_cost_metric {
+                PIXEL_COST_CYCLES          = 0,
+                PIXEL_COST_RAYS            = 1,
+                PIXEL_COST_PRIMITIVE_TESTS = 2,
+        };
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the metric, suitable for file names
+        std::string stringify_pixel_cost_metric(pixel_cost_metric const& M);
+
+        /// --------------------------------------------------------------------
+        /// costs of all pixels of a render
+        class pixel_cost_map final
+        {
+            private:
+                uint32_t width_  = 0;
+                uint32_t height_ = 0;
+                std::vector<pixel_cost> costs_;
+
+            public:
+                pixel_cost_map() = default;
+                pixel_cost_map(uint32_t width, uint32_t height);
+
+            public:
+                uint32_t width() const
+                {
+                        return width_;
+                }
+
+                uint32_t height() const
+                {
+                        return height_;
+                }
+
+                bool empty() const
+                {
+                        return costs_.empty();
+                }
+
+                /// ------------------------------------------------------------
+                /// cost of the pixel at (x, y). distinct pixels can be updated
+                /// by different threads without any locking.
+                pixel_cost& at(uint32_t x, uint32_t y)
+                {
+                        return costs_[size_t{y} * width_ + x];
+                }
+
+                pixel_cost const& at(uint32_t x, uint32_t y) const
+                {
+                        return costs_[size_t{y} * width_ + x];
+                }
+
+                /// ------------------------------------------------------------
+                /// render a metric as a false-color heatmap, going from blue
+                /// (cheapest) through green and yellow, to red (costliest).
+                ///
+                /// costs tend to span a few orders of magnitude, so they are
+                /// scaled logarithmically, otherwise all but the few costliest
+                /// pixels end up in the blues.
+                canvas heatmap(pixel_cost_metric const& M) const;
+
+                /// ------------------------------------------------------------
+                /// write heatmaps of all metrics next to an image, f.e. for
+                /// 'dragon.ppm', these are 'dragon-cycles.ppm' etc.
+                void write_heatmaps(std::string const& image_fname) const;
+
+                std::string stringify() const;
+        };
+
+} // namespace raytracer
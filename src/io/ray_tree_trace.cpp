@@ -0,0 +1,325 @@
+/*
+ * implement the ray-tree trace of a single pixel
+ **/
+
+#include "io/ray_tree_trace.hpp"
+
+/// c++ includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "common/include/logging.h"
+#include "primitives/color.hpp"
+#include "primitives/intersection_record.hpp"
+#include "primitives/ray.hpp"
+#include "primitives/tuple.hpp"
+#include "shapes/shape_interface.hpp"
+#include "utils/render_counters.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// convenience
+        static std::string json_string(std::string const& s)
+        {
+                std::string retval = "\"";
+
+                for (auto const ch : s) {
+                        switch (ch) {
+                        case '"':
+                                retval += "\\\"";
+                                break;
+
+                        case '\\':
+                                retval += "\\\\";
+                                break;
+
+                        case '\n':
+                                retval += "\\n";
+                                break;
+
+                        default:
+                                retval += ch;
+                                break;
+                        }
+                }
+
+                return retval + "\"";
+        }
+
+        static std::string json_tuple(tuple const& t)
+        {
+                std::stringstream ss("");
+                ss << std::setprecision(9) << "[" << t.x() << ", " << t.y() << ", " << t.z() << "]";
+
+                return ss.str();
+        }
+
+        static std::string json_color(color const& c)
+        {
+                std::stringstream ss("");
+                ss << std::setprecision(6) << "[" << c.R() << ", " << c.G() << ", " << c.B() << "]";
+
+                return ss.str();
+        }
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the kind of ray
+        std::string stringify_traced_ray_kind(traced_ray_kind const& K)
+        {
+                switch (K) {
+                case traced_ray_kind::TRACED_RAY_PRIMARY:
+                        return "primary";
+
+                case traced_ray_kind::TRACED_RAY_SHADOW:
+                        return "shadow";
+
+                case traced_ray_kind::TRACED_RAY_REFLECTED:
+                        return "reflected";
+
+                case traced_ray_kind::TRACED_RAY_REFRACTED:
+                        return "refracted";
+                }
+
+                return "unknown";
+        }
+
+        /// --------------------------------------------------------------------
+        /// create an instance, nothing has been traced yet
+        ray_tree_trace::ray_tree_trace(uint32_t x, uint32_t y)
+            : x_(x)
+            , y_(y)
+        {
+        }
+
+        uint32_t ray_tree_trace::x() const
+        {
+                return x_;
+        }
+
+        uint32_t ray_tree_trace::y() const
+        {
+                return y_;
+        }
+
+        std::vector<traced_ray> const& ray_tree_trace::rays() const
+        {
+                return rays_;
+        }
+
+        std::vector<size_t> const& ray_tree_trace::roots() const
+        {
+                return roots_;
+        }
+
+        color ray_tree_trace::pixel_color() const
+        {
+                return pixel_color_;
+        }
+
+        uint64_t ray_tree_trace::total_ns() const
+        {
+                return total_ns_;
+        }
+
+        /// --------------------------------------------------------------------
+        /// the pixel is colored
+        void ray_tree_trace::pixel_done(color const& pixel_color, uint64_t total_ns)
+        {
+                pixel_color_ = pixel_color;
+                total_ns_    = total_ns;
+        }
+
+        /// --------------------------------------------------------------------
+        /// the ray-tree as json
+        std::string ray_tree_trace::to_json() const
+        {
+                std::stringstream ss("");
+
+                ss << "{\n"
+                   << "  \"pixel\": [" << x_ << ", " << y_ << "],\n"
+                   << "  \"color\": " << json_color(pixel_color_) << ",\n"
+                   << "  \"total_ns\": " << total_ns_ << ",\n"
+                   << "  \"num_rays\": " << rays_.size() << ",\n"
+                   << "  \"rays\": [";
+
+                std::string dst = ss.str();
+
+                for (size_t i = 0; i < roots_.size(); i++) {
+                        dst += (i == 0) ? "\n" : ",\n";
+                        ray_to_json(dst, roots_[i], 4);
+                }
+
+                dst += roots_.empty() ? "]\n" : "\n  ]\n";
+                dst += "}\n";
+
+                return dst;
+        }
+
+        /// --------------------------------------------------------------------
+        /// write the ray-tree as json
+        bool ray_tree_trace::write_json(std::string const& fname) const
+        {
+                std::ofstream dst(fname);
+                dst << to_json();
+
+                if (!dst.good()) {
+                        LOG_ERROR("failed writing ray-tree trace to: '%s'", fname.c_str());
+                        return false;
+                }
+
+                return true;
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// record details of the innermost ray being traced
+        void ray_tree_trace::record_intersections(uint64_t objects_tested, uint64_t intersections)
+        {
+                if (auto* r = innermost_ray(); r != nullptr) {
+                        r->objects_tested = objects_tested;
+                        r->intersections  = intersections;
+                }
+        }
+
+        void ray_tree_trace::record_hit(intersection_record const& xs)
+        {
+                if (auto* r = innermost_ray(); r != nullptr) {
+                        r->hit        = true;
+                        r->hit_t      = xs.where();
+                        r->hit_object = xs.what_object()->stringify();
+                }
+        }
+
+        void ray_tree_trace::record_occluded(bool occluded)
+        {
+                if (auto* r = innermost_ray(); r != nullptr) {
+                        r->hit = occluded;
+                }
+        }
+
+        void ray_tree_trace::record_color(color const& c)
+        {
+                if (auto* r = innermost_ray(); r != nullptr) {
+                        r->ray_color = c;
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// start tracing a ray, as a child of the innermost ray being traced
+        void ray_tree_trace::begin_ray(traced_ray_kind K, ray_t const& R)
+        {
+                auto const index = rays_.size();
+                rays_.emplace_back(K, R, static_cast<uint32_t>(open_.size()));
+
+                if (open_.empty()) {
+                        roots_.push_back(index);
+                } else {
+                        rays_[open_.back().index].children.push_back(index);
+                }
+
+                auto const& counters = render_counters::this_thread();
+
+                /// ------------------------------------------------------------
+                /// the clock is read last, so that the bookkeeping above is not
+                /// part of the ray's time
+                open_.push_back({index, clock::time_point(), counters.box_tests, counters.primitive_tests});
+                open_.back().start_time = clock::now();
+        }
+
+        /// --------------------------------------------------------------------
+        /// done tracing the innermost ray. its children are done as well, so
+        /// what they took is taken out of its own.
+        void ray_tree_trace::end_ray()
+        {
+                auto const end_time  = clock::now();
+                auto const& counters = render_counters::this_thread();
+                auto const o         = open_.back();
+
+                open_.pop_back();
+
+                auto& r = rays_[o.index];
+
+                using nanoseconds = std::chrono::nanoseconds;
+
+                r.total_ns        = std::chrono::duration_cast<nanoseconds>(end_time - o.start_time).count();
+                r.box_tests       = counters.box_tests - o.start_box_tests;
+                r.primitive_tests = counters.primitive_tests - o.start_primitive_tests;
+
+                uint64_t children_ns = 0;
+                for (auto const c : r.children) {
+                        children_ns += rays_[c].total_ns;
+                        r.box_tests -= rays_[c].box_tests;
+                        r.primitive_tests -= rays_[c].primitive_tests;
+                }
+
+                r.self_ns = (r.total_ns > children_ns) ? (r.total_ns - children_ns) : 0;
+        }
+
+        /// --------------------------------------------------------------------
+        /// innermost ray being traced, nullptr when there is none
+        traced_ray* ray_tree_trace::innermost_ray()
+        {
+                if (open_.empty()) {
+                        return nullptr;
+                }
+
+                return &rays_[open_.back().index];
+        }
+
+        /// --------------------------------------------------------------------
+        /// a ray, and all its children, as json
+        void ray_tree_trace::ray_to_json(std::string& dst, size_t index, size_t indent) const
+        {
+                auto const& r   = rays_[index];
+                auto const pad  = std::string(indent, ' ');
+                auto const pad2 = std::string(indent + 2, ' ');
+
+                std::stringstream ss("");
+
+                ss << pad << "{\n"
+                   << pad2 << "\"kind\": " << json_string(stringify_traced_ray_kind(r.kind)) << ",\n"
+                   << pad2 << "\"depth\": " << r.depth << ",\n"
+                   << pad2 << "\"origin\": " << json_tuple(r.the_ray.origin()) << ",\n"
+                   << pad2 << "\"direction\": " << json_tuple(r.the_ray.direction()) << ",\n"
+                   << pad2 << "\"objects_tested\": " << r.objects_tested << ",\n"
+                   << pad2 << "\"intersections\": " << r.intersections << ",\n"
+                   << pad2 << "\"box_tests\": " << r.box_tests << ",\n"
+                   << pad2 << "\"primitive_tests\": " << r.primitive_tests << ",\n"
+                   << pad2 << "\"hit\": " << (r.hit ? "true" : "false") << ",\n";
+
+                if (!r.hit_object.empty()) {
+                        ss << pad2 << "\"hit_t\": " << std::setprecision(9) << r.hit_t << ",\n"
+                           << pad2 << "\"hit_object\": " << json_string(r.hit_object) << ",\n";
+                }
+
+                if (r.kind != traced_ray_kind::TRACED_RAY_SHADOW) {
+                        ss << pad2 << "\"color\": " << json_color(r.ray_color) << ",\n";
+                }
+
+                ss << pad2 << "\"total_ns\": " << r.total_ns << ",\n"
+                   << pad2 << "\"self_ns\": " << r.self_ns << ",\n"
+                   << pad2 << "\"children\": [";
+
+                dst += ss.str();
+
+                for (size_t i = 0; i < r.children.size(); i++) {
+                        dst += (i == 0) ? "\n" : ",\n";
+                        ray_to_json(dst, r.children[i], indent + 4);
+                }
+
+                dst += r.children.empty() ? "]\n" : ("\n" + pad2 + "]\n");
+                dst += pad + "}";
+        }
+
+} // namespace raytracer
@@ -0,0 +1,232 @@
+#pragma once
+
+/*
+ * this file implements a debug trace of all the rays which color a single
+ * pixel i.e. its ray-tree.
+ *
+ * the primary ray(s) of a pixel are the roots of its ray-tree. shadow,
+ * reflected and refracted rays cast from where a ray hits the world are its
+ * children. for each ray the trace records where it came from, where it was
+ * headed, what it was tested against and hit, and the time it took.
+ *
+ * tracing is meant for looking at individual pixels (see camera::trace_pixel
+ * (...)), f.e. the ones that a heatmap shows to be far costlier than the rest.
+ * when a thread is not tracing, the hooks in the rendering code amount to a
+ * check of a thread-local pointer.
+ **/
+
+/// c++ includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "primitives/color.hpp"
+#include "primitives/intersection_record.hpp"
+#include "primitives/ray.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// kinds of rays in a ray-tree
+        enum class traced_ray_kind {
+                TRACED_RAY_PRIMARY   = 0,
+                TRACED_RAY_SHADOW    = 1,
+                TRACED_RAY_REFLECTED = 2,
+                TRACED_RAY_REFRACTED = 3,
+        };
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the kind of ray
+        std::string stringify_traced_ray_kind(traced_ray_kind const& K);
+
+        /// --------------------------------------------------------------------
+        /// a ray of a ray-tree
+        struct traced_ray final {
+                traced_ray_kind kind;
+                ray_t the_ray;
+
+                /// ------------------------------------------------------------
+                /// depth in the ray-tree, primary rays are at depth 0
+                uint32_t depth = 0;
+
+                /// ------------------------------------------------------------
+                /// indices of the rays cast from this one, in the order in
+                /// which they were cast
+                std::vector<size_t> children = {};
+
+                /// ------------------------------------------------------------
+                /// shapes of the world that the ray was tested against, the
+                /// intersections that it made with them, and the intersection
+                /// tests that it took (excluding the tests of its children)
+                uint64_t objects_tested  = 0;
+                uint64_t intersections   = 0;
+                uint64_t box_tests       = 0;
+                uint64_t primitive_tests = 0;
+
+                /// ------------------------------------------------------------
+                /// for shadow rays, a hit is something between the point and
+                /// the light. for the rest, it is the visible intersection.
+                bool hit               = false;
+                double hit_t           = 0.0;
+                std::string hit_object = "";
+
+                /// ------------------------------------------------------------
+                /// color brought back by the ray. shadow rays have none.
+                color ray_color = color();
+
+                /// ------------------------------------------------------------
+                /// time taken by the ray, including || excluding its children
+                uint64_t total_ns = 0;
+                uint64_t self_ns  = 0;
+
+                traced_ray(traced_ray_kind K, ray_t const& R, uint32_t D)
+                    : kind(K)
+                    , the_ray(R)
+                    , depth(D)
+                {
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// ray-tree of a single pixel
+        class ray_tree_trace final
+        {
+            private:
+                using clock = std::chrono::steady_clock;
+
+                /// ------------------------------------------------------------
+                /// a ray which is being traced, its children are too
+                struct open_ray final {
+                        size_t index;
+                        clock::time_point start_time;
+                        uint64_t start_box_tests;
+                        uint64_t start_primitive_tests;
+                };
+
+                uint32_t x_;
+                uint32_t y_;
+
+                /// ------------------------------------------------------------
+                /// all rays of the tree, in the order in which they were cast
+                std::vector<traced_ray> rays_;
+                std::vector<size_t> roots_;
+                std::vector<open_ray> open_;
+
+                color pixel_color_ = color();
+                uint64_t total_ns_ = 0;
+
+            public:
+                ray_tree_trace(uint32_t x, uint32_t y);
+
+                uint32_t x() const;
+                uint32_t y() const;
+                std::vector<traced_ray> const& rays() const;
+
+                /// ------------------------------------------------------------
+                /// indices of the primary rays. without antialiasing there is
+                /// exactly one.
+                std::vector<size_t> const& roots() const;
+
+                color pixel_color() const;
+                uint64_t total_ns() const;
+
+                /// ------------------------------------------------------------
+                /// called once the pixel is colored
+                void pixel_done(color const& pixel_color, uint64_t total_ns);
+
+                /// ------------------------------------------------------------
+                /// the ray-tree as json
+                std::string to_json() const;
+
+                /// ------------------------------------------------------------
+                /// write the ray-tree as json to 'fname', returns false on
+                /// failure
+                bool write_json(std::string const& fname) const;
+
+                /// ------------------------------------------------------------
+                /// trace being recorded by the calling thread, nullptr when it
+                /// is not tracing
+                static ray_tree_trace*& this_thread()
+                {
+                        static thread_local ray_tree_trace* trace = nullptr;
+                        return trace;
+                }
+
+                /// ------------------------------------------------------------
+                /// a ray is traced for as long as an instance of this is in
+                /// scope
+                class scope final
+                {
+                    private:
+                        ray_tree_trace* const trace_;
+
+                    public:
+                        scope(traced_ray_kind K, ray_t const& R)
+                            : trace_(this_thread())
+                        {
+                                if (trace_ != nullptr) {
+                                        trace_->begin_ray(K, R);
+                                }
+                        }
+
+                        ~scope()
+                        {
+                                if (trace_ != nullptr) {
+                                        trace_->end_ray();
+                                }
+                        }
+
+                        scope(scope const&)            = delete;
+                        scope& operator=(scope const&) = delete;
+                };
+
+                /// ------------------------------------------------------------
+                /// record details of the innermost ray being traced by the
+                /// calling thread, if any. these are called for every ray, so
+                /// just like the scope, they check the thread-local pointer
+                /// inline, and record out-of-line only when tracing.
+                static void note_intersections(uint64_t objects_tested, uint64_t intersections)
+                {
+                        if (this_thread() != nullptr) {
+                                this_thread()->record_intersections(objects_tested, intersections);
+                        }
+                }
+
+                static void note_hit(intersection_record const& xs)
+                {
+                        if (this_thread() != nullptr) {
+                                this_thread()->record_hit(xs);
+                        }
+                }
+
+                static void note_occluded(bool occluded)
+                {
+                        if (this_thread() != nullptr) {
+                                this_thread()->record_occluded(occluded);
+                        }
+                }
+
+                static void note_color(color const& c)
+                {
+                        if (this_thread() != nullptr) {
+                                this_thread()->record_color(c);
+                        }
+                }
+
+            private:
+                void begin_ray(traced_ray_kind K, ray_t const& R);
+                void end_ray();
+
+                void record_intersections(uint64_t objects_tested, uint64_t intersections);
+                void record_hit(intersection_record const& xs);
+                void record_occluded(bool occluded);
+                void record_color(color const& c);
+
+                traced_ray* innermost_ray();
+                void ray_to_json(std::string& dst, size_t index, size_t indent) const;
+        };
+
+} // namespace raytracer
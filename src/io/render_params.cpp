@@ -58,6 +58,31 @@ namespace raytracer
                 return antialias_enabled_;
         }
 
+        bool config_render_params::heatmap() const
+        {
+                return heatmap_;
+        }
+
+        uint32_t config_render_params::progress_interval_ms() const
+        {
+                return progress_interval_ms_;
+        }
+
+        std::string const& config_render_params::progress_status_file() const
+        {
+                return progress_status_fname_;
+        }
+
+        uint32_t config_render_params::work_item_pixels() const
+        {
+                return work_item_pixels_;
+        }
+
+        bool config_render_params::perf_counters() const
+        {
+                return perf_counters_;
+        }
+
         /// --------------------------------------------------------------------
         /// show progress of rendering as pixels are colored ?
         config_render_params&& config_render_params::online(bool val)
@@ -118,6 +143,46 @@ namespace raytracer
                 return std::move(*this);
         }
 
+        /// --------------------------------------------------------------------
+        /// record the cost of rendering each pixel ?
+        config_render_params&& config_render_params::heatmap(bool val)
+        {
+                heatmap_ = val;
+                return std::move(*this);
+        }
+
+        /// --------------------------------------------------------------------
+        /// report progress of rendering every 'val' milliseconds (0 == never)
+        config_render_params&& config_render_params::progress_interval_ms(uint32_t val)
+        {
+                progress_interval_ms_ = val;
+                return std::move(*this);
+        }
+
+        /// --------------------------------------------------------------------
+        /// write progress reports to this file as well
+        config_render_params&& config_render_params::progress_status_file(std::string val)
+        {
+                progress_status_fname_ = std::move(val);
+                return std::move(*this);
+        }
+
+        /// --------------------------------------------------------------------
+        /// pixels per work item (0 == default of the rendering style)
+        config_render_params&& config_render_params::work_item_pixels(uint32_t val)
+        {
+                work_item_pixels_ = val;
+                return std::move(*this);
+        }
+
+        /// --------------------------------------------------------------------
+        /// count hardware events of each phase of rendering ?
+        config_render_params&& config_render_params::perf_counters(bool val)
+        {
+                perf_counters_ = val;
+                return std::move(*this);
+        }
+
         /// --------------------------------------------------------------------
         /// stringified representation of rendering parameters
         std::string config_render_params::stringify() const
@@ -136,6 +201,31 @@ namespace raytracer
                            << "aa-color-threshold: '" << AA_COLOR_DIFF_THRESHOLD << "'";
                 }
 
+                if (this->heatmap_) {
+                        ss << ", "
+                           << "heatmap: '" << str_boolean(this->heatmap_) << "'";
+                }
+
+                if (this->progress_interval_ms_ != 0) {
+                        ss << ", "
+                           << "progress-interval: '" << this->progress_interval_ms_ << "ms'";
+
+                        if (!this->progress_status_fname_.empty()) {
+                                ss << ", "
+                                   << "progress-status-file: '" << this->progress_status_fname_ << "'";
+                        }
+                }
+
+                if (this->work_item_pixels_ != 0) {
+                        ss << ", "
+                           << "work-item-pixels: '" << this->work_item_pixels_ << "'";
+                }
+
+                if (this->perf_counters_) {
+                        ss << ", "
+                           << "perf-counters: '" << str_boolean(this->perf_counters_) << "'";
+                }
+
                 if (this->benchmark_) {
                         ss << ", "
                            << "benchmark: '" << str_boolean(this->benchmark_) << "', "
@@ -30,9 +30,10 @@ namespace raytracer
                 /// ------------------------------------------------------------
                 /// should the rendering progress be show while rendering ?
                 ///
-                /// when enabled, this seems to be adding approximately 7..10
-                /// second delay. however, it ends up producing a cool looking
-                /// effect. so yeah, totally worth it.
+                /// rendering threads only update an in-memory image, which is
+                /// painted by a separate display thread a few times a second.
+                /// so this costs next to nothing, and ends up producing a cool
+                /// looking effect. so yeah, totally worth it.
                 ///
                 /// the 'cool looking effect' is especially more pronounced when
                 /// the 'rendering_style::RENDERING_STYLE_HILBERT' is used.
@@ -66,6 +67,44 @@ namespace raytracer
                 /// rendering order
                 rendering_style render_style_ = rendering_style::RENDERING_STYLE_SCANLINE;
 
+                /// ------------------------------------------------------------
+                /// when true, the cost of rendering each pixel (cycles, rays
+                /// and primitive tests) is recorded, and can be rendered as a
+                /// heatmap. see 'io/pixel_costs.hpp' for details.
+                ///
+                /// reading the cycle counter twice per pixel is cheap, but not
+                /// free. so this is disabled by default.
+                bool heatmap_ = false;
+
+                /// ------------------------------------------------------------
+                /// when non-zero, the progress of a render (percentage done,
+                /// rays/sec and time to finish) is reported every so many
+                /// milliseconds. see 'io/render_progress.hpp' for details.
+                ///
+                /// when 'progress_status_fname_' is not empty, each report is
+                /// written to that file as well.
+                uint32_t progress_interval_ms_     = 0;
+                std::string progress_status_fname_ = "";
+
+                /// ------------------------------------------------------------
+                /// pixels in a single work item that a rendering thread picks
+                /// up at a time, 0 being the default of each rendering style.
+                ///
+                /// scanline and hilbert work items are runs of pixels along
+                /// their curves, and tiles are (about) square. smaller work
+                /// items balance the load better towards the end of a render,
+                /// at the cost of more trips to the work-queue.
+                uint32_t work_item_pixels_ = 0;
+
+                /// ------------------------------------------------------------
+                /// when true, hardware events (cycles, instructions, cache and
+                /// branch misses) of each phase of rendering are counted. see
+                /// 'io/render_perf_counters.hpp' for details.
+                ///
+                /// this needs a system call at every change of phase, so it is
+                /// disabled by default.
+                bool perf_counters_ = false;
+
             public:
                 /// ------------------------------------------------------------
                 /// see camera::adaptively_color_a_pixel_at(...) to get some
@@ -77,6 +116,12 @@ namespace raytracer
                 /// sample there.
                 static constexpr double AA_COLOR_DIFF_THRESHOLD = 0.05;
 
+                /// ------------------------------------------------------------
+                /// offset (in pixels) of the corners of a pixel from its center
+                /// when it is first sampled for antialiasing. the offset is
+                /// halved with each subdivision of the pixel.
+                static constexpr double AA_PIXEL_DELTA = 0.5;
+
             public:
                 /// ------------------------------------------------------------
                 /// create default instance
@@ -96,6 +141,11 @@ namespace raytracer
                 uint32_t benchmark_num_discard_initial() const;
                 rendering_style render_style() const;
                 bool antialias() const;
+                bool heatmap() const;
+                uint32_t progress_interval_ms() const;
+                std::string const& progress_status_file() const;
+                uint32_t work_item_pixels() const;
+                bool perf_counters() const;
 
                 /// ------------------------------------------------------------
                 /// configure various properties
@@ -106,6 +156,11 @@ namespace raytracer
                 config_render_params&& benchmark_discard_initial(uint32_t);
                 config_render_params&& render_style(rendering_style const&);
                 config_render_params&& antialias(bool);
+                config_render_params&& heatmap(bool);
+                config_render_params&& progress_interval_ms(uint32_t);
+                config_render_params&& progress_status_file(std::string);
+                config_render_params&& work_item_pixels(uint32_t);
+                config_render_params&& perf_counters(bool);
 
             private:
                 /// ------------------------------------------------------------
@@ -0,0 +1,188 @@
+/*
+ * implement the attribution of hardware events to phases of rendering
+ **/
+
+#include "io/render_perf_counters.hpp"
+
+/// c++ includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// our includes
+#include "platform_utils/perf_counters.hpp"
+#include "utils/render_counters.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// convenience
+        namespace PU = platform_utils;
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of a phase of rendering
+        std::string stringify_render_phase(render_phase const& P)
+        {
+                switch (P) {
+                case RENDER_PHASE_WORK_GENERATION:
+                        return "work-generation";
+
+                case RENDER_PHASE_TRAVERSAL:
+                        return "traversal";
+
+                case RENDER_PHASE_SHADING:
+                        return "shading";
+
+                case RENDER_PHASE_ANTIALIASING:
+                        return "antialiasing";
+
+                case RENDER_PHASE_OUTPUT:
+                        return "output";
+
+                case RENDER_PHASE_OTHER:
+                        return "other";
+
+                case RENDER_PHASE_MAX:
+                        break;
+                }
+
+                return "unknown";
+        }
+
+        /// --------------------------------------------------------------------
+        /// ratios of events of a phase
+        render_phase_summary summarize_render_phase(render_phase_events const& events, render_phase P)
+        {
+                render_phase_summary summary;
+
+                auto const& e           = events[P];
+                auto const cycles       = e[PU::PERF_EVENT_CYCLES];
+                auto const instructions = e[PU::PERF_EVENT_INSTRUCTIONS];
+
+                uint64_t total_cycles = 0;
+                for (auto const& phase_events : events) {
+                        total_cycles += phase_events[PU::PERF_EVENT_CYCLES];
+                }
+
+                if (cycles != 0) {
+                        summary.ipc = double(instructions) / cycles;
+                }
+
+                if (instructions != 0) {
+                        summary.l1d_mpki    = e[PU::PERF_EVENT_L1D_MISSES] * 1000.0 / instructions;
+                        summary.llc_mpki    = e[PU::PERF_EVENT_LLC_MISSES] * 1000.0 / instructions;
+                        summary.branch_mpki = e[PU::PERF_EVENT_BRANCH_MISSES] * 1000.0 / instructions;
+                }
+
+                if (total_cycles != 0) {
+                        summary.cycles_share = double(cycles) / total_cycles;
+                }
+
+                return summary;
+        }
+
+        /// --------------------------------------------------------------------
+        /// start counting events of the calling thread
+        render_perf_counters::render_perf_counters(render_phase base)
+            : counters_(PU::perf_counters::open_for_this_thread())
+        {
+                if ((counters_ == nullptr) || !counters_->read(last_)) {
+                        counters_ = nullptr;
+                        return;
+                }
+
+                /// ------------------------------------------------------------
+                /// phases nest as deep as rays are traced, and antialiasing
+                /// subdivides. this is plenty for both.
+                phases_.reserve(64);
+                phases_.push_back(base);
+
+                this_thread() = this;
+        }
+
+        render_perf_counters::~render_perf_counters()
+        {
+                stop();
+        }
+
+        bool render_perf_counters::counting() const
+        {
+                return counters_ != nullptr;
+        }
+
+        /// --------------------------------------------------------------------
+        /// events since the last change of phase belong to the phase that the
+        /// thread is in
+        render_phase_events const& render_perf_counters::stop()
+        {
+                if (counters_ == nullptr) {
+                        return events_;
+                }
+
+                attribute_events(phases_.back());
+
+                if (this_thread() == this) {
+                        this_thread() = nullptr;
+                }
+
+                counters_ = nullptr;
+                phases_.clear();
+
+                return events_;
+        }
+
+        /// --------------------------------------------------------------------
+        /// counters are opened just once, for finding out
+        bool render_perf_counters::available()
+        {
+                static bool const can_count = (PU::perf_counters::open_for_this_thread() != nullptr);
+                return can_count;
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// entering a phase, events so far belong to the enclosing one. a
+        /// phase nested in itself (f.e. subdivisions of a pixel) changes
+        /// nothing.
+        void render_perf_counters::enter(render_phase P)
+        {
+                if (phases_.back() != P) {
+                        attribute_events(phases_.back());
+                }
+
+                phases_.push_back(P);
+        }
+
+        /// --------------------------------------------------------------------
+        /// leaving a phase, events so far belong to it
+        void render_perf_counters::leave()
+        {
+                auto const P = phases_.back();
+                phases_.pop_back();
+
+                if (phases_.back() != P) {
+                        attribute_events(P);
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// attribute events since the last read of the counters to phase 'P'
+        void render_perf_counters::attribute_events(render_phase P)
+        {
+                PU::perf_event_counts now;
+
+                if (!counters_->read(now)) {
+                        return;
+                }
+
+                for (size_t i = 0; i < PU::PERF_EVENT_MAX; i++) {
+                        events_[P][i] += (now[i] > last_[i]) ? (now[i] - last_[i]) : 0;
+                }
+
+                last_ = now;
+        }
+
+} // namespace raytracer
@@ -0,0 +1,148 @@
+#pragma once
+
+/*
+ * this file implements the attribution of hardware events (cycles,
+ * instructions, cache and branch misses, see 'platform_utils/perf_counters.hpp')
+ * of a rendering thread to the phases of rendering:
+ *
+ *     - work generation: creating the work-queue of a render
+ *     - traversal: finding intersections of rays with the world
+ *     - shading: coloring intersections, less the rays that this casts
+ *     - antialiasing: sampling, and subdividing pixels
+ *     - output: writing pixels to the canvas || framebuffer, and display
+ *     - other: everything else f.e. picking work items
+ *
+ * rendering code marks phases with a 'phase_scope', and the events since the
+ * last mark are attributed to the innermost phase. so, shading f.e. does not
+ * include the traversal of the shadow rays that it casts.
+ *
+ * counters are read at every change of phase, which costs a system call. so
+ * counting events slows rendering down noticeably, and is meant for finding
+ * out whether a phase is bound by memory (misses) || by computation (low ipc),
+ * rather than for timing renders. when a thread is not counting, the hooks in
+ * the rendering code amount to a check of a thread-local pointer.
+ **/
+
+/// c++ includes
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "platform_utils/perf_counters.hpp"
+#include "utils/render_counters.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// stringified representation of a phase of rendering
+        std::string stringify_render_phase(render_phase const& P);
+
+        /// --------------------------------------------------------------------
+        /// hardware events of each phase of rendering
+        using render_phase_events = std::array<platform_utils::perf_event_counts, RENDER_PHASE_MAX>;
+
+        /// --------------------------------------------------------------------
+        /// ratios of interest of the events of a phase
+        struct render_phase_summary final {
+                /// ------------------------------------------------------------
+                /// instructions per cycle
+                double ipc = 0.0;
+
+                /// ------------------------------------------------------------
+                /// misses per thousand instructions
+                double l1d_mpki    = 0.0;
+                double llc_mpki    = 0.0;
+                double branch_mpki = 0.0;
+
+                /// ------------------------------------------------------------
+                /// fraction of cycles of the whole render spent in the phase
+                double cycles_share = 0.0;
+        };
+
+        /// --------------------------------------------------------------------
+        /// ratios of events of phase 'P'
+        render_phase_summary summarize_render_phase(render_phase_events const& events, render_phase P);
+
+        /// --------------------------------------------------------------------
+        /// hardware events of the calling thread, by phase of rendering
+        class render_perf_counters final
+        {
+            private:
+                std::unique_ptr<platform_utils::perf_counters> counters_;
+                platform_utils::perf_event_counts last_ = {};
+                render_phase_events events_             = {};
+
+                /// ------------------------------------------------------------
+                /// phases that the thread is in, the innermost one last
+                std::vector<render_phase> phases_;
+
+            public:
+                /// ------------------------------------------------------------
+                /// start counting events of the calling thread, attributing
+                /// them to 'base' outside of any other phase. nothing is
+                /// counted when the platform cannot count events.
+                explicit render_perf_counters(render_phase base);
+                ~render_perf_counters();
+
+                render_perf_counters(render_perf_counters const&)            = delete;
+                render_perf_counters& operator=(render_perf_counters const&) = delete;
+
+                /// ------------------------------------------------------------
+                /// are events being counted ?
+                bool counting() const;
+
+                /// ------------------------------------------------------------
+                /// stop counting, and return the events of each phase
+                render_phase_events const& stop();
+
+                /// ------------------------------------------------------------
+                /// can the platform count events at all ?
+                static bool available();
+
+                /// ------------------------------------------------------------
+                /// counters of the calling thread, nullptr when it is not
+                /// counting
+                static render_perf_counters*& this_thread()
+                {
+                        static thread_local render_perf_counters* counters = nullptr;
+                        return counters;
+                }
+
+                /// ------------------------------------------------------------
+                /// events are attributed to 'P' for as long as an instance of
+                /// this is in scope, and no inner phase is
+                class phase_scope final
+                {
+                    private:
+                        render_perf_counters* const counters_;
+
+                    public:
+                        explicit phase_scope(render_phase P)
+                            : counters_(this_thread())
+                        {
+                                if (counters_ != nullptr) {
+                                        counters_->enter(P);
+                                }
+                        }
+
+                        ~phase_scope()
+                        {
+                                if (counters_ != nullptr) {
+                                        counters_->leave();
+                                }
+                        }
+
+                        phase_scope(phase_scope const&)            = delete;
+                        phase_scope& operator=(phase_scope const&) = delete;
+                };
+
+            private:
+                void enter(render_phase P);
+                void leave();
+                void attribute_events(render_phase P);
+        };
+
+} // namespace raytracer
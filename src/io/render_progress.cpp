@@ -0,0 +1,237 @@
+/*
+ * implement progress reporting of a render
+ **/
+
+#include "io/render_progress.hpp"
+
+/// c++ includes
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/// our includes
+#include "common/include/logging.h"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// percentage of pixels rendered
+        double render_progress_snapshot::percent() const
+        {
+                if (pixels_total == 0) {
+                        return 100.0;
+                }
+
+                return 100.0 * pixels_done / pixels_total;
+        }
+
+        /// --------------------------------------------------------------------
+        /// estimated seconds to finish the render
+        std::optional<double> render_progress_snapshot::eta_sec() const
+        {
+                if (done || (pixels_done >= pixels_total)) {
+                        return 0.0;
+                }
+
+                if ((pixels_done == 0) || (elapsed_sec <= 0.0)) {
+                        return std::nullopt;
+                }
+
+                auto const pixels_per_sec = pixels_done / elapsed_sec;
+                return (pixels_total - pixels_done) / pixels_per_sec;
+        }
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the progress
+        std::string render_progress_snapshot::stringify() const
+        {
+                std::stringstream ss("");
+                ss << std::fixed << std::setprecision(1);
+
+                auto const eta = eta_sec();
+
+                ss << "{"
+                   << "done: " << percent() << "%, "
+                   << "pixels: " << pixels_done << "/" << pixels_total << ", "
+                   << "work-items: " << work_items_done << "/" << work_items_total << ", "
+                   << "rays: " << rays_cast << ", "
+                   << "rays/sec: " << rays_per_sec << ", "
+                   << "elapsed: " << elapsed_sec << "s, "
+                   << "eta: ";
+
+                if (eta) {
+                        ss << eta.value() << "s";
+                } else {
+                        ss << "unknown";
+                }
+
+                ss << "}";
+
+                return ss.str();
+        }
+
+        /// --------------------------------------------------------------------
+        /// json representation of the progress
+        std::string render_progress_snapshot::to_json() const
+        {
+                std::stringstream ss("");
+                ss << std::fixed << std::setprecision(3);
+
+                auto const eta = eta_sec();
+
+                // clang-format off
+                ss << "{"
+                   << "\"state\": \""           << (done ? "done" : "rendering") << "\", "
+                   << "\"percent\": "           << percent()                     << ", "
+                   << "\"pixels_done\": "       << pixels_done                   << ", "
+                   << "\"pixels_total\": "      << pixels_total                  << ", "
+                   << "\"work_items_done\": "   << work_items_done               << ", "
+                   << "\"work_items_total\": "  << work_items_total              << ", "
+                   << "\"rays\": "              << rays_cast                     << ", "
+                   << "\"rays_per_sec\": "      << rays_per_sec                  << ", "
+                   << "\"elapsed_sec\": "       << elapsed_sec                   << ", "
+                   << "\"eta_sec\": ";
+                // clang-format on
+
+                if (eta) {
+                        ss << eta.value();
+                } else {
+                        ss << "null";
+                }
+
+                ss << "}";
+
+                return ss.str();
+        }
+
+        /// --------------------------------------------------------------------
+        /// create an instance, nothing is done yet
+        render_progress::render_progress(uint64_t pixels_total, uint64_t work_items_total)
+            : pixels_total_(pixels_total)
+            , work_items_total_(work_items_total)
+            , start_time_(std::chrono::steady_clock::now())
+        {
+        }
+
+        /// --------------------------------------------------------------------
+        /// progress so far
+        render_progress_snapshot render_progress::snapshot() const
+        {
+                using seconds = std::chrono::duration<double>;
+
+                render_progress_snapshot s;
+
+                s.elapsed_sec      = seconds(std::chrono::steady_clock::now() - start_time_).count();
+                s.pixels_done      = pixels_done_.load(std::memory_order_relaxed);
+                s.pixels_total     = pixels_total_;
+                s.work_items_done  = work_items_done_.load(std::memory_order_relaxed);
+                s.work_items_total = work_items_total_;
+                s.rays_cast        = rays_cast_.load(std::memory_order_relaxed);
+
+                return s;
+        }
+
+        /// --------------------------------------------------------------------
+        /// start reporting progress
+        render_progress_reporter::render_progress_reporter(render_progress const& progress,
+                                                           std::chrono::milliseconds interval,
+                                                           std::string status_fname)
+            : progress_(progress)
+            , interval_(interval)
+            , status_fname_(std::move(status_fname))
+        {
+                reporter_ = std::thread(&render_progress_reporter::report_loop, this);
+        }
+
+        /// --------------------------------------------------------------------
+        /// stop reporting, and report the render as done
+        render_progress_reporter::~render_progress_reporter()
+        {
+                {
+                        std::lock_guard<std::mutex> guard(lock_);
+                        done_ = true;
+                }
+
+                wakeup_.notify_one();
+                reporter_.join();
+
+                report(true);
+        }
+
+        /// --------------------------------------------------------------------
+        /// the reporter thread
+        void render_progress_reporter::report_loop()
+        {
+                std::unique_lock<std::mutex> guard(lock_);
+
+                while (!wakeup_.wait_for(guard, interval_, [this]() { return done_; })) {
+                        report(false);
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// report progress so far
+        void render_progress_reporter::report(bool done)
+        {
+                auto s = progress_.snapshot();
+                s.done = done;
+
+                auto const dt = s.elapsed_sec - prev_.elapsed_sec;
+                if (dt > 0.0) {
+                        s.rays_per_sec = (s.rays_cast - prev_.rays_cast) / dt;
+                }
+
+                /// ------------------------------------------------------------
+                /// the final report is about the whole render
+                if (done && (s.elapsed_sec > 0.0)) {
+                        s.rays_per_sec = s.rays_cast / s.elapsed_sec;
+                }
+
+                LOG_INFO("render progress: %s", s.stringify().c_str());
+
+                if (!status_fname_.empty()) {
+                        write_status_file(s);
+                }
+
+                prev_ = s;
+        }
+
+        /// --------------------------------------------------------------------
+        /// replace contents of the status file. the status is written to a
+        /// temporary file first, and then renamed, so that whoever polls the
+        /// status file never sees a partial one.
+        void render_progress_reporter::write_status_file(render_progress_snapshot const& s) const
+        {
+                auto const tmp_fname = status_fname_ + ".tmp";
+
+                FILE* dst_file = fopen(tmp_fname.c_str(), "w");
+                if (dst_file == nullptr) {
+                        LOG_ERROR("failed writing: '%s'. reason: '%s'", tmp_fname.c_str(), strerror(errno));
+                        return;
+                }
+
+                auto const status = s.to_json() + "\n";
+                auto const written = fwrite(status.data(), 1, status.size(), dst_file);
+
+                if ((fclose(dst_file) != 0) || (written != status.size())) {
+                        LOG_ERROR("failed writing: '%s'. reason: '%s'", tmp_fname.c_str(), strerror(errno));
+                        remove(tmp_fname.c_str());
+                        return;
+                }
+
+                if (rename(tmp_fname.c_str(), status_fname_.c_str()) != 0) {
+                        LOG_ERROR("failed renaming: '%s' to '%s'. reason: '%s'", tmp_fname.c_str(),
+                                  status_fname_.c_str(), strerror(errno));
+                        remove(tmp_fname.c_str());
+                }
+        }
+
+} // namespace raytracer
@@ -0,0 +1,137 @@
+#pragma once
+
+/*
+ * this file implements progress reporting of a render i.e. how much of the
+ * image is done, how fast rays are being cast, and how long the rest of it is
+ * expected to take.
+ *
+ * rendering threads publish their progress once per work item (a batch of
+ * pixels, or a tile of a framebuffer), so that publishing costs next to
+ * nothing. a separate reporter thread periodically logs the progress, and
+ * optionally writes it to a status file for f.e. a job scheduler to poll.
+ **/
+
+/// c++ includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// progress of a render at a point in time
+        struct render_progress_snapshot final {
+                double elapsed_sec        = 0.0;
+                uint64_t pixels_done      = 0;
+                uint64_t pixels_total     = 0;
+                uint64_t work_items_done  = 0;
+                uint64_t work_items_total = 0;
+                uint64_t rays_cast        = 0;
+
+                /// ------------------------------------------------------------
+                /// rays cast per second, since the previous snapshot
+                double rays_per_sec = 0.0;
+
+                /// ------------------------------------------------------------
+                /// is the render done ?
+                bool done = false;
+
+                /// ------------------------------------------------------------
+                /// percentage of pixels rendered
+                double percent() const;
+
+                /// ------------------------------------------------------------
+                /// estimated seconds to finish the render, at the average rate
+                /// so far. there is no estimate until some pixels are done.
+                std::optional<double> eta_sec() const;
+
+                std::string stringify() const;
+
+                /// ------------------------------------------------------------
+                /// json representation (on a single line), as written to the
+                /// status file
+                std::string to_json() const;
+        };
+
+        /// --------------------------------------------------------------------
+        /// progress counters of a single render, shared by all rendering
+        /// threads
+        class render_progress final
+        {
+            private:
+                uint64_t const pixels_total_;
+                uint64_t const work_items_total_;
+                std::chrono::steady_clock::time_point const start_time_;
+
+                std::atomic<uint64_t> pixels_done_     = 0;
+                std::atomic<uint64_t> work_items_done_ = 0;
+                std::atomic<uint64_t> rays_cast_       = 0;
+
+            public:
+                render_progress(uint64_t pixels_total, uint64_t work_items_total);
+
+                render_progress(render_progress const&)            = delete;
+                render_progress& operator=(render_progress const&) = delete;
+
+                /// ------------------------------------------------------------
+                /// called by a rendering thread when it is done with a work
+                /// item of 'pixels', for which it cast 'rays'
+                void work_item_done(uint64_t pixels, uint64_t rays)
+                {
+                        pixels_done_.fetch_add(pixels, std::memory_order_relaxed);
+                        rays_cast_.fetch_add(rays, std::memory_order_relaxed);
+                        work_items_done_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                /// ------------------------------------------------------------
+                /// progress so far. 'rays_per_sec' is not filled in.
+                render_progress_snapshot snapshot() const;
+        };
+
+        /// --------------------------------------------------------------------
+        /// periodically report the progress of a render, until the reporter
+        /// is destroyed, at which point the render is reported as done.
+        class render_progress_reporter final
+        {
+            private:
+                render_progress const& progress_;
+                std::chrono::milliseconds const interval_;
+                std::string const status_fname_;
+
+                /// ------------------------------------------------------------
+                /// the previous report, for the rate of rays cast
+                render_progress_snapshot prev_ = {};
+
+                /// ------------------------------------------------------------
+                /// the reporter thread, which is woken up early when the
+                /// reporter is destroyed
+                std::mutex lock_;
+                std::condition_variable wakeup_;
+                bool done_ = false;
+                std::thread reporter_;
+
+            public:
+                /// ------------------------------------------------------------
+                /// report 'progress' every 'interval'. when 'status_fname' is
+                /// not empty, each report replaces the contents of that file
+                /// as well.
+                render_progress_reporter(render_progress const& progress, std::chrono::milliseconds interval,
+                                         std::string status_fname = "");
+
+                ~render_progress_reporter();
+
+                render_progress_reporter(render_progress_reporter const&)            = delete;
+                render_progress_reporter& operator=(render_progress_reporter const&) = delete;
+
+            private:
+                void report_loop();
+                void report(bool done);
+                void write_status_file(render_progress_snapshot const& s) const;
+        };
+
+} // namespace raytracer
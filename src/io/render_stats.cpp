@@ -0,0 +1,160 @@
+/*
+ * implement statistics gathered while rendering
+ **/
+
+#include "io/render_stats.hpp"
+
+/// c++ includes
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// our includes
+#include "io/render_perf_counters.hpp"
+#include "platform_utils/perf_counters.hpp"
+#include "utils/render_counters.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// create an instance from the counters of all rendering threads
+        render_stats::render_stats(uint64_t pixels, std::vector<render_counters> per_thread,
+                                   std::vector<render_thread_times> per_thread_times, uint64_t wall_ns)
+            : pixels_(pixels)
+            , wall_ns_(wall_ns)
+            , per_thread_(std::move(per_thread))
+            , per_thread_times_(std::move(per_thread_times))
+        {
+                for (auto const& c : per_thread_) {
+                        totals_ += c;
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// idle time of a rendering thread
+        uint64_t render_stats::idle_ns(uint32_t thread) const
+        {
+                if (thread >= per_thread_times_.size()) {
+                        return 0;
+                }
+
+                auto const busy_ns = per_thread_times_[thread].busy_ns;
+                return (wall_ns_ > busy_ns) ? (wall_ns_ - busy_ns) : 0;
+        }
+
+        /// --------------------------------------------------------------------
+        /// idle time of a rendering thread, once it ran out of work
+        uint64_t render_stats::tail_idle_ns(uint32_t thread) const
+        {
+                if (thread >= per_thread_times_.size()) {
+                        return 0;
+                }
+
+                auto const done_ns = per_thread_times_[thread].done_ns;
+                return (wall_ns_ > done_ns) ? (wall_ns_ - done_ns) : 0;
+        }
+
+        /// --------------------------------------------------------------------
+        /// busy time of all rendering threads over their total time
+        double render_stats::utilization() const
+        {
+                if ((wall_ns_ == 0) || per_thread_times_.empty()) {
+                        return 0.0;
+                }
+
+                uint64_t busy_ns = 0;
+                for (auto const& t : per_thread_times_) {
+                        busy_ns += t.busy_ns;
+                }
+
+                return double(busy_ns) / (double(wall_ns_) * per_thread_times_.size());
+        }
+
+        /// --------------------------------------------------------------------
+        /// events of a phase that none of the rendering threads did
+        void render_stats::add_phase_events(render_phase P, platform_utils::perf_event_counts const& events)
+        {
+                for (size_t i = 0; i < platform_utils::PERF_EVENT_MAX; i++) {
+                        totals_.phase_events[P][i] += events[i];
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// every phase runs some instructions, so without any, nothing was
+        /// counted
+        bool render_stats::has_phase_events() const
+        {
+                for (auto const& events : totals_.phase_events) {
+                        if ((events[platform_utils::PERF_EVENT_CYCLES] != 0) ||
+                            (events[platform_utils::PERF_EVENT_INSTRUCTIONS] != 0)) {
+                                return true;
+                        }
+                }
+
+                return false;
+        }
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the statistics
+        std::string render_stats::stringify() const
+        {
+                std::stringstream ss("");
+
+                // clang-format off
+                ss << "{"
+                   << "pixels: "          << pixels_                 << ", "
+                   << "threads: "         << threads()               << ", "
+                   << "rays: "            << totals_.rays()          << ", "
+                   << "primary-rays: "    << totals_.primary_rays    << ", "
+                   << "shadow-rays: "     << totals_.shadow_rays     << ", "
+                   << "reflected-rays: "  << totals_.reflected_rays  << ", "
+                   << "refracted-rays: "  << totals_.refracted_rays  << ", "
+                   << "box-tests: "       << totals_.box_tests       << ", "
+                   << "primitive-tests: " << totals_.primitive_tests << ", "
+                   << "aa-samples: [";
+                // clang-format on
+
+                for (size_t i = 0; i < totals_.aa_samples.size(); i++) {
+                        ss << (i == 0 ? "" : ", ") << totals_.aa_samples[i];
+                }
+
+                ss << "]";
+
+                if (wall_ns_ != 0) {
+                        ss << ", wall-ms: " << (wall_ns_ / 1.0e6) << ", utilization: " << utilization();
+                }
+
+                if (has_phase_events()) {
+                        auto const& events = totals_.phase_events;
+
+                        ss << ", phases: {";
+
+                        for (size_t p = 0; p < RENDER_PHASE_MAX; p++) {
+                                auto const P      = static_cast<render_phase>(p);
+                                auto const s      = summarize_render_phase(events, P);
+                                auto const cycles = events[P][platform_utils::PERF_EVENT_CYCLES];
+
+                                // clang-format off
+                                ss << (p == 0 ? "" : ", ")
+                                   << stringify_render_phase(P) << ": {"
+                                   << "cycles: "       << cycles         << ", "
+                                   << "cycles-share: " << s.cycles_share << ", "
+                                   << "ipc: "          << s.ipc          << ", "
+                                   << "l1d-mpki: "     << s.l1d_mpki     << ", "
+                                   << "llc-mpki: "     << s.llc_mpki     << ", "
+                                   << "branch-mpki: "  << s.branch_mpki  << "}";
+                                // clang-format on
+                        }
+
+                        ss << "}";
+                }
+
+                ss << "}";
+
+                return ss.str();
+        }
+
+} // namespace raytracer
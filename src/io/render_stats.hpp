@@ -0,0 +1,115 @@
+#pragma once
+
+/*
+ * this file implements statistics that are gathered while rendering a scene.
+ *
+ * counters are kept per rendering thread, so that updating them is (almost)
+ * free, and are aggregated into 'render_stats' once all rendering threads are
+ * done.
+ *
+ * along with the counters, each rendering thread records the time it spent
+ * rendering work items, and when it ran out of work. the rest of the render is
+ * time that it sat idle, mostly waiting for the other threads to finish their
+ * last work items.
+ **/
+
+/// c++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "platform_utils/perf_counters.hpp"
+#include "utils/render_counters.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// times of a single rendering thread, from the start of the render
+        struct render_thread_times final {
+                /// ------------------------------------------------------------
+                /// time spent rendering work items
+                uint64_t busy_ns = 0;
+
+                /// ------------------------------------------------------------
+                /// when the thread ran out of work
+                uint64_t done_ns = 0;
+        };
+
+        /// --------------------------------------------------------------------
+        /// statistics of a single render
+        class render_stats final
+        {
+            private:
+                uint64_t pixels_  = 0;
+                uint64_t wall_ns_ = 0;
+                std::vector<render_counters> per_thread_;
+                std::vector<render_thread_times> per_thread_times_;
+                render_counters totals_;
+
+            public:
+                render_stats() = default;
+                render_stats(uint64_t pixels, std::vector<render_counters> per_thread,
+                             std::vector<render_thread_times> per_thread_times = {}, uint64_t wall_ns = 0);
+
+            public:
+                uint64_t pixels() const
+                {
+                        return pixels_;
+                }
+
+                uint32_t threads() const
+                {
+                        return per_thread_.size();
+                }
+
+                /// ------------------------------------------------------------
+                /// counters of individual rendering threads, and their sum
+                std::vector<render_counters> const& per_thread() const
+                {
+                        return per_thread_;
+                }
+
+                render_counters const& totals() const
+                {
+                        return totals_;
+                }
+
+                /// ------------------------------------------------------------
+                /// time from the start of the render until all rendering
+                /// threads were done, and the times of individual threads
+                uint64_t wall_ns() const
+                {
+                        return wall_ns_;
+                }
+
+                std::vector<render_thread_times> const& per_thread_times() const
+                {
+                        return per_thread_times_;
+                }
+
+                /// ------------------------------------------------------------
+                /// time that a rendering thread was not rendering work items,
+                /// and the part of that after it ran out of work
+                uint64_t idle_ns(uint32_t thread) const;
+                uint64_t tail_idle_ns(uint32_t thread) const;
+
+                /// ------------------------------------------------------------
+                /// fraction of the time of all rendering threads spent
+                /// rendering work items, 1.0 being no idling at all
+                double utilization() const;
+
+                /// ------------------------------------------------------------
+                /// hardware events of a phase of rendering done by some other
+                /// thread than the rendering ones f.e. generating work. these
+                /// only count towards the totals.
+                void add_phase_events(render_phase P, platform_utils::perf_event_counts const& events);
+
+                /// ------------------------------------------------------------
+                /// were hardware events counted ?
+                bool has_phase_events() const;
+
+                std::string stringify() const;
+        };
+
+} // namespace raytracer
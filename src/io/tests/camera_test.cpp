@@ -98,3 +98,143 @@ TEST_CASE("camera::ray_for_pixel(...) test" * doctest::skip(true))
 
         CHECK(got_color_at_pixel == exp_color_at_pixel);
 }
+
+/// ----------------------------------------------------------------------------
+/// statistics gathered while rendering a world
+TEST_CASE("camera::render_with_stats(...) test")
+{
+        auto w_01       = RT::world::create_default_world();
+        auto c_01       = RT::camera(11, 11, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        auto const [img, stats] = c_01.render_with_stats(w_01, RT::config_render_params().hw_threads(2));
+        auto const& totals      = stats.totals();
+
+        CHECK(stats.pixels() == 121);
+        CHECK(stats.threads() == 2);
+        CHECK(stats.per_thread()[0].primary_rays + stats.per_thread()[1].primary_rays == 121);
+
+        /// --------------------------------------------------------------------
+        /// every primary ray is tested against both spheres, and a shadow ray
+        /// against one || both of them. there are no groups, and nothing is
+        /// reflective || transparent
+        CHECK(totals.primary_rays == 121);
+        CHECK(totals.shadow_rays > 0);
+        CHECK(totals.shadow_rays < 121);
+        CHECK(totals.reflected_rays == 0);
+        CHECK(totals.refracted_rays == 0);
+        CHECK(totals.rays() == totals.primary_rays + totals.shadow_rays);
+        CHECK(totals.box_tests == 0);
+        CHECK(totals.primitive_tests >= 2 * 121 + totals.shadow_rays);
+        CHECK(totals.primitive_tests <= 2 * (121 + totals.shadow_rays));
+        CHECK(totals.aa_samples[0] == 0);
+
+        CHECK(c_01.last_render_stats().totals().primary_rays == 121);
+}
+
+/// ----------------------------------------------------------------------------
+/// statistics gathered while rendering a world with antialiasing
+TEST_CASE("camera::render_with_stats(...) antialiasing test")
+{
+        auto w_01       = RT::world::create_default_world();
+        auto c_01       = RT::camera(11, 11, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        auto const params       = RT::config_render_params().hw_threads(1).antialias(true);
+        auto const [img, stats] = c_01.render_with_stats(w_01, params);
+        auto const& totals      = stats.totals();
+
+        /// --------------------------------------------------------------------
+        /// every pixel is sampled at least once, with 5 rays. subdivisions are
+        /// sampled with 5 rays as well, except at the deepest one.
+        uint64_t max_primary_rays = 0;
+        for (size_t i = 0; i < RT::render_counters::MAX_AA_DEPTH; i++) {
+                max_primary_rays += 5 * totals.aa_samples[i];
+        }
+
+        CHECK(totals.aa_samples[0] == 121);
+        CHECK(totals.primary_rays >= 5 * 121);
+        CHECK(totals.primary_rays <= max_primary_rays);
+}
+
+/// ----------------------------------------------------------------------------
+/// the image does not depend upon the order in which pixels are rendered, the
+/// size of work items || the number of threads
+TEST_CASE("camera::render(...) rendering styles and work items test")
+{
+        auto w_01       = RT::world::create_default_world();
+        auto c_01       = RT::camera(13, 7, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        auto const img_01 = c_01.render(w_01, RT::config_render_params().hw_threads(1));
+
+        for (auto const style : {RT::rendering_style::RENDERING_STYLE_SCANLINE,
+                                 RT::rendering_style::RENDERING_STYLE_HILBERT,
+                                 RT::rendering_style::RENDERING_STYLE_TILE}) {
+                for (auto const work_item_pixels : {0, 1, 5, 16, 1000}) {
+                        for (auto const threads : {1, 3}) {
+                                auto const params = RT::config_render_params()
+                                                            .hw_threads(threads)
+                                                            .render_style(style)
+                                                            .work_item_pixels(work_item_pixels);
+
+                                auto const [img_02, stats] = c_01.render_with_stats(w_01, params);
+
+                                CHECK(stats.totals().primary_rays == 13 * 7);
+
+                                for (uint32_t y = 0; y < 7; y++) {
+                                        for (uint32_t x = 0; x < 13; x++) {
+                                                CHECK(img_02.read_pixel(x, y) == img_01.read_pixel(x, y));
+                                        }
+                                }
+                        }
+                }
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// time rendering threads spend rendering, and idling
+TEST_CASE("camera::render_with_stats(...) thread times test")
+{
+        auto w_01       = RT::world::create_default_world();
+        auto c_01       = RT::camera(11, 11, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        auto const [img, stats] = c_01.render_with_stats(w_01, RT::config_render_params().hw_threads(2));
+
+        CHECK(stats.wall_ns() > 0);
+        CHECK(stats.per_thread_times().size() == 2);
+        CHECK(stats.utilization() > 0.0);
+        CHECK(stats.utilization() <= 1.0);
+
+        for (uint32_t i = 0; i < 2; i++) {
+                auto const& t = stats.per_thread_times()[i];
+
+                CHECK(t.busy_ns <= t.done_ns);
+                CHECK(t.done_ns <= stats.wall_ns());
+                CHECK(stats.idle_ns(i) == stats.wall_ns() - t.busy_ns);
+                CHECK(stats.tail_idle_ns(i) == stats.wall_ns() - t.done_ns);
+                CHECK(stats.tail_idle_ns(i) <= stats.idle_ns(i));
+        }
+
+        /// --------------------------------------------------------------------
+        /// no such thread
+        CHECK(stats.idle_ns(2) == 0);
+        CHECK(stats.tail_idle_ns(2) == 0);
+}
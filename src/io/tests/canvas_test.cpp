@@ -1,5 +1,7 @@
 /// c++ includes
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <optional>
 #include <stdint.h>
 #include <string>
@@ -14,6 +16,7 @@
 /// our includes
 #include "common/include/logging.h"
 #include "io/canvas.hpp"
+#include "io/deflate.hpp"
 #include "patterns/uv_image_pattern.hpp"
 #include "platform_utils/mmapped_file_reader.hpp"
 #include "primitives/color.hpp"
@@ -400,3 +403,210 @@ TEST_CASE("uv_image checkers patterned canvas")
 
         return;
 }
+
+/// ----------------------------------------------------------------------------
+/// canvas written as a png image
+TEST_CASE("canvas::write(...) png image")
+{
+        auto c = RT::canvas::create_binary(300, 200);
+        for (size_t y = 0; y < c.height(); y++) {
+                for (size_t x = 0; x < c.width(); x++) {
+                        c.write_pixel(x, y, RT::color(x / 300.0, y / 200.0, 0.5));
+                }
+        }
+
+        auto const png_fname = std::string("/tmp/rt-test-canvas.png");
+        c.write(png_fname);
+
+        std::ifstream png_file(png_fname, std::ios::binary);
+        std::vector<uint8_t> png_data((std::istreambuf_iterator<char>(png_file)), std::istreambuf_iterator<char>());
+        unlink(png_fname.c_str());
+
+        CHECK(png_data.size() > 8 + 25 + 12);
+        if (png_data.size() <= 8 + 25 + 12) {
+                return;
+        }
+
+        /// ------------------------------------------------------------
+        /// signature, followed by the 'IHDR' chunk
+        std::vector<uint8_t> const png_signature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+        CHECK(std::equal(png_signature.begin(), png_signature.end(), png_data.begin()));
+
+        auto read_u32 = [&png_data](size_t offset) -> uint32_t {
+                return (png_data[offset + 0] << 24) | (png_data[offset + 1] << 16) |
+                       (png_data[offset + 2] << 8) | (png_data[offset + 3] << 0);
+        };
+
+        CHECK(read_u32(8) == 13);
+        CHECK(std::string(png_data.begin() + 12, png_data.begin() + 16) == "IHDR");
+        CHECK(read_u32(16) == 300);
+        CHECK(read_u32(20) == 200);
+        CHECK(png_data[24] == 8);
+        CHECK(png_data[25] == 2);
+        CHECK(read_u32(29) == RT::crc32(0, png_data.data() + 12, 17));
+
+        /// ------------------------------------------------------------
+        /// compressed image must be smaller than the raw one
+        CHECK(png_data.size() < 300 * 200 * 3);
+
+        /// ------------------------------------------------------------
+        /// and the image ends with an 'IEND' chunk
+        CHECK(std::string(png_data.end() - 8, png_data.end() - 4) == "IEND");
+}
+
+/// ----------------------------------------------------------------------------
+/// compressed data of large png images is split across bounded 'IDAT' chunks
+TEST_CASE("canvas::write(...) png image with multiple IDAT chunks")
+{
+        /// --------------------------------------------------------------------
+        /// noise doesn't compress, so this needs more than one chunk
+        uint32_t lcg = 12345;
+        auto c       = RT::canvas::create_binary(640, 480);
+        for (size_t y = 0; y < c.height(); y++) {
+                for (size_t x = 0; x < c.width(); x++) {
+                        lcg = lcg * 1103515245 + 12345;
+                        c.write_pixel(x, y, RT::color::RGB(lcg >> 24, (lcg >> 16) & 0xff, (lcg >> 8) & 0xff));
+                }
+        }
+
+        auto const png_fname = std::string("/tmp/rt-test-canvas-idat.png");
+        c.write(png_fname);
+
+        std::ifstream png_file(png_fname, std::ios::binary);
+        std::vector<uint8_t> png_data((std::istreambuf_iterator<char>(png_file)),
+                                      std::istreambuf_iterator<char>());
+        unlink(png_fname.c_str());
+
+        auto read_u32 = [&png_data](size_t offset) -> uint32_t {
+                return (png_data[offset + 0] << 24) | (png_data[offset + 1] << 16) |
+                       (png_data[offset + 2] << 8) | (png_data[offset + 3] << 0);
+        };
+
+        /// --------------------------------------------------------------------
+        /// walk all the chunks, checking their crc's, and collect the
+        /// compressed data
+        size_t num_idat = 0;
+        std::vector<uint8_t> idat_data;
+
+        for (size_t offset = 8; offset + 12 <= png_data.size();) {
+                auto const len = read_u32(offset);
+                if (offset + 12 + len > png_data.size()) {
+                        break;
+                }
+
+                CHECK(read_u32(offset + 8 + len) == RT::crc32(0, png_data.data() + offset + 4, len + 4));
+
+                if (std::string(png_data.begin() + offset + 4, png_data.begin() + offset + 8) == "IDAT") {
+                        CHECK(len <= 1024 * 1024);
+
+                        num_idat += 1;
+                        idat_data.insert(idat_data.end(), png_data.begin() + offset + 8,
+                                         png_data.begin() + offset + 8 + len);
+                }
+
+                offset += 12 + len;
+        }
+
+        CHECK(num_idat > 1);
+
+        /// --------------------------------------------------------------------
+        /// chunks are consecutive pieces of a single zlib stream
+        CHECK(idat_data.size() > 640 * 480 * 3);
+        if (idat_data.size() > 2) {
+                CHECK(((idat_data[0] << 8) | idat_data[1]) % 31 == 0);
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// canvas written as a pfm image
+TEST_CASE("canvas::write(...) pfm image")
+{
+        auto c = RT::canvas::create_binary(3, 2);
+        c.write_pixel(0, 0, RT::color(1.5, 0.25, -0.5));
+        c.write_pixel(2, 1, RT::color(0.125, 2.0, 0.75));
+
+        auto const pfm_fname = std::string("/tmp/rt-test-canvas.PFM");
+        c.write(pfm_fname);
+
+        std::ifstream pfm_file(pfm_fname, std::ios::binary);
+
+        std::string magic, scale;
+        size_t width = 0, height = 0;
+        pfm_file >> magic >> width >> height >> scale;
+        pfm_file.get();
+
+        CHECK(magic == "PF");
+        CHECK(width == 3);
+        CHECK(height == 2);
+
+        std::vector<float> pfm_data(3 * 2 * 3);
+        pfm_file.read(reinterpret_cast<char*>(pfm_data.data()), pfm_data.size() * sizeof(float));
+        CHECK(pfm_file.gcount() == static_cast<std::streamsize>(pfm_data.size() * sizeof(float)));
+        unlink(pfm_fname.c_str());
+
+        /// ------------------------------------------------------------
+        /// rows are bottom-to-top, and colors are neither clamped nor
+        /// quantized
+        CHECK(pfm_data[9 + 0] == 1.5f);
+        CHECK(pfm_data[9 + 1] == 0.25f);
+        CHECK(pfm_data[9 + 2] == -0.5f);
+
+        CHECK(pfm_data[6 + 0] == 0.125f);
+        CHECK(pfm_data[6 + 1] == 2.0f);
+        CHECK(pfm_data[6 + 2] == 0.75f);
+}
+
+/// ----------------------------------------------------------------------------
+/// binary (P6) and ascii (P3) images are read back as they were written, for
+/// images large enough to be read concurrently as well.
+TEST_CASE("canvas::load_from_file(...) round trip")
+{
+        for (auto create_fn : {RT::canvas::create_ascii, RT::canvas::create_binary}) {
+                for (size_t const width : {7, 1200}) {
+                        auto c = create_fn(width, 500);
+
+                        for (size_t y = 0; y < c.height(); y++) {
+                                for (size_t x = 0; x < c.width(); x++) {
+                                        c.write_pixel(x, y, RT::color::RGB(x % 256, y % 256, (x * y) % 256));
+                                }
+                        }
+
+                        auto const ppm_fname = std::string("/tmp/rt-test-canvas-round-trip.ppm");
+                        c.write(ppm_fname);
+
+                        auto maybe_canvas = RT::canvas::load_from_file(ppm_fname);
+                        unlink(ppm_fname.c_str());
+
+                        CHECK(maybe_canvas.has_value());
+                        if (!maybe_canvas.has_value()) {
+                                continue;
+                        }
+
+                        auto const& got = maybe_canvas.value();
+                        CHECK(got.width() == c.width());
+                        CHECK(got.height() == c.height());
+
+                        size_t num_mismatches = 0;
+                        for (size_t y = 0; y < c.height(); y++) {
+                                for (size_t x = 0; x < c.width(); x++) {
+                                        num_mismatches += (got.read_pixel(x, y) != c.read_pixel(x, y));
+                                }
+                        }
+
+                        CHECK(num_mismatches == 0);
+                }
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// binary (P6) image with too little raster data
+TEST_CASE("canvas::load_from_file(...) truncated binary image")
+{
+        std::string_view ppm_data = "P6\n2 2\n255\n\x01\x02\x03\x04\x05\x06\x07\x08\x09";
+
+        std::string ppm_fname = platform_utils::fill_file_with_data(ppm_data);
+
+        auto maybe_ppm_canvas = RT::canvas::load_from_file(ppm_fname);
+        CHECK(maybe_ppm_canvas.has_value() == false);
+        unlink(ppm_fname.c_str());
+}
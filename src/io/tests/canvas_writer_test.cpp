@@ -0,0 +1,74 @@
+/// c++ includes
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+#include "io/canvas_writer.hpp"
+#include "primitives/color.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// a convenience alias
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// all submitted canvases are on disk after a flush
+TEST_CASE("canvas_writer::submit(...)/flush(...)")
+{
+        constexpr uint32_t num_canvases = 8;
+        std::vector<std::string> fnames;
+
+        RT::canvas_writer writer(2, 1);
+
+        for (uint32_t i = 0; i < num_canvases; i++) {
+                auto c = RT::canvas::create_ascii(16, 8);
+                c.write_pixel(i, 0, RT::color(1.0, 0.0, 0.0));
+
+                auto fname = "/tmp/rt-test-canvas-writer-" + std::to_string(i) + ".ppm";
+                fnames.push_back(fname);
+
+                writer.submit(std::move(c), fname);
+        }
+
+        writer.flush();
+        CHECK(writer.num_written() == num_canvases);
+
+        for (uint32_t i = 0; i < num_canvases; i++) {
+                auto maybe_canvas = RT::canvas::load_from_file(fnames[i]);
+                CHECK(maybe_canvas.has_value());
+
+                if (maybe_canvas.has_value()) {
+                        CHECK(maybe_canvas->width() == 16);
+                        CHECK(maybe_canvas->height() == 8);
+                        CHECK(maybe_canvas->read_pixel(i, 0) == RT::color(1.0, 0.0, 0.0));
+                }
+
+                unlink(fnames[i].c_str());
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// destroying the writer writes out everything that is still pending
+TEST_CASE("canvas_writer::~canvas_writer(...)")
+{
+        auto const fname = std::string("/tmp/rt-test-canvas-writer-dtor.ppm");
+        unlink(fname.c_str());
+
+        {
+                RT::canvas_writer writer;
+                writer.submit(RT::canvas::create_ascii(4, 4), fname);
+        }
+
+        auto maybe_canvas = RT::canvas::load_from_file(fname);
+        CHECK(maybe_canvas.has_value());
+        unlink(fname.c_str());
+}
@@ -0,0 +1,365 @@
+/// c++ includes
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/deflate.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// a convenience alias
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// a minimal inflater (rfc-1951), along the lines of zlib's 'puff'. it is just
+/// enough to check that compressed streams decompress back to the original.
+class test_inflater final
+{
+    private:
+        /// ------------------------------------------------------------
+        /// a canonical huffman code: number of codes of each length, and
+        /// symbols ordered by their codes
+        struct huffman_table {
+                std::array<uint16_t, 16> counts = {};
+                std::vector<uint16_t> symbols;
+        };
+
+    private:
+        std::vector<uint8_t> const& in_;
+        size_t bit_pos_ = 0;
+        bool bad_       = false;
+
+    public:
+        explicit test_inflater(std::vector<uint8_t> const& in)
+            : in_(in)
+        {
+        }
+
+        /// ------------------------------------------------------------
+        /// inflate the whole stream, std::nullopt if it is malformed or
+        /// if there is trailing data
+        std::optional<std::vector<uint8_t>> inflate()
+        {
+                std::vector<uint8_t> out;
+
+                for (bool is_final = false; !is_final && !bad_;) {
+                        is_final        = get_bits(1);
+                        auto const type = get_bits(2);
+
+                        if (type == 0) {
+                                inflate_stored(out);
+                        } else if (type == 1) {
+                                inflate_fixed(out);
+                        } else if (type == 2) {
+                                inflate_dynamic(out);
+                        } else {
+                                bad_ = true;
+                        }
+                }
+
+                if (bad_ || ((bit_pos_ + 7) / 8 != in_.size())) {
+                        return std::nullopt;
+                }
+
+                return out;
+        }
+
+    private:
+        uint32_t get_bits(uint32_t num_bits)
+        {
+                uint32_t val = 0;
+
+                for (uint32_t i = 0; i < num_bits; i++, bit_pos_++) {
+                        if (bit_pos_ / 8 >= in_.size()) {
+                                bad_ = true;
+                                return 0;
+                        }
+
+                        val |= ((in_[bit_pos_ / 8] >> (bit_pos_ % 8)) & 1) << i;
+                }
+
+                return val;
+        }
+
+        static huffman_table make_table(uint8_t const* lengths, size_t num_symbols)
+        {
+                huffman_table t;
+                std::array<uint16_t, 16> offsets = {};
+
+                for (size_t i = 0; i < num_symbols; i++) {
+                        t.counts[lengths[i]]++;
+                }
+
+                t.counts[0] = 0;
+                for (size_t l = 1; l < 16; l++) {
+                        offsets[l] = offsets[l - 1] + t.counts[l - 1];
+                }
+
+                t.symbols.resize(num_symbols);
+                for (size_t i = 0; i < num_symbols; i++) {
+                        if (lengths[i] != 0) {
+                                t.symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+                        }
+                }
+
+                return t;
+        }
+
+        int32_t decode(huffman_table const& t)
+        {
+                int32_t code  = 0;
+                int32_t first = 0;
+                int32_t index = 0;
+
+                for (size_t l = 1; (l < 16) && !bad_; l++) {
+                        code |= get_bits(1);
+
+                        int32_t const count = t.counts[l];
+                        if (code - count < first) {
+                                return t.symbols[index + (code - first)];
+                        }
+
+                        index += count;
+                        first = (first + count) << 1;
+                        code <<= 1;
+                }
+
+                bad_ = true;
+                return -1;
+        }
+
+        void inflate_stored(std::vector<uint8_t>& out)
+        {
+                bit_pos_ = (bit_pos_ + 7) & ~size_t{7};
+
+                auto const len  = get_bits(16);
+                auto const nlen = get_bits(16);
+                if ((len ^ 0xffff) != nlen) {
+                        bad_ = true;
+                        return;
+                }
+
+                for (uint32_t i = 0; (i < len) && !bad_; i++) {
+                        out.push_back(static_cast<uint8_t>(get_bits(8)));
+                }
+        }
+
+        void inflate_fixed(std::vector<uint8_t>& out)
+        {
+                std::array<uint8_t, 288> litlen_lengths = {};
+                std::array<uint8_t, 30> dist_lengths    = {};
+
+                for (size_t i = 0; i < litlen_lengths.size(); i++) {
+                        litlen_lengths[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+                }
+                dist_lengths.fill(5);
+
+                inflate_codes(out, make_table(litlen_lengths.data(), litlen_lengths.size()),
+                              make_table(dist_lengths.data(), dist_lengths.size()));
+        }
+
+        void inflate_dynamic(std::vector<uint8_t>& out)
+        {
+                static constexpr std::array<uint8_t, 19> codelen_order = {
+                        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+                };
+
+                auto const num_litlen  = get_bits(5) + 257;
+                auto const num_dist    = get_bits(5) + 1;
+                auto const num_codelen = get_bits(4) + 4;
+
+                std::array<uint8_t, 19> codelen_lengths = {};
+                for (size_t i = 0; i < num_codelen; i++) {
+                        codelen_lengths[codelen_order[i]] = static_cast<uint8_t>(get_bits(3));
+                }
+
+                auto const codelen_table = make_table(codelen_lengths.data(), codelen_lengths.size());
+
+                std::vector<uint8_t> lengths;
+                while ((lengths.size() < num_litlen + num_dist) && !bad_) {
+                        auto const sym = decode(codelen_table);
+
+                        if (sym < 16) {
+                                lengths.push_back(static_cast<uint8_t>(sym));
+                        } else if ((sym == 16) && !lengths.empty()) {
+                                lengths.insert(lengths.end(), 3 + get_bits(2), lengths.back());
+                        } else if (sym == 17) {
+                                lengths.insert(lengths.end(), 3 + get_bits(3), 0);
+                        } else if (sym == 18) {
+                                lengths.insert(lengths.end(), 11 + get_bits(7), 0);
+                        } else {
+                                bad_ = true;
+                        }
+                }
+
+                if (bad_ || (lengths.size() != num_litlen + num_dist)) {
+                        bad_ = true;
+                        return;
+                }
+
+                inflate_codes(out, make_table(lengths.data(), num_litlen),
+                              make_table(lengths.data() + num_litlen, num_dist));
+        }
+
+        void inflate_codes(std::vector<uint8_t>& out, huffman_table const& litlen, huffman_table const& dist)
+        {
+                // clang-format off
+                static constexpr std::array<uint16_t, 29> length_base = {
+                        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+                };
+
+                static constexpr std::array<uint8_t, 29> length_extra = {
+                        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+                };
+
+                static constexpr std::array<uint16_t, 30> dist_base = {
+                        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                        8193, 12289, 16385, 24577,
+                };
+
+                static constexpr std::array<uint8_t, 30> dist_extra = {
+                        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+                };
+                // clang-format on
+
+                while (!bad_) {
+                        auto const sym = decode(litlen);
+
+                        if (sym < 256) {
+                                out.push_back(static_cast<uint8_t>(sym));
+                                continue;
+                        }
+
+                        if (sym == 256) {
+                                return;
+                        }
+
+                        auto const li = static_cast<size_t>(sym - 257);
+                        if (li >= length_base.size()) {
+                                bad_ = true;
+                                return;
+                        }
+
+                        auto const len = length_base[li] + get_bits(length_extra[li]);
+                        auto const di  = static_cast<size_t>(decode(dist));
+                        if (di >= dist_base.size()) {
+                                bad_ = true;
+                                return;
+                        }
+
+                        auto const d = dist_base[di] + get_bits(dist_extra[di]);
+                        if (d > out.size()) {
+                                bad_ = true;
+                                return;
+                        }
+
+                        for (uint32_t i = 0; i < len; i++) {
+                                out.push_back(out[out.size() - d]);
+                        }
+                }
+        }
+};
+
+/// ----------------------------------------------------------------------------
+/// checksums against well known values
+TEST_CASE("crc32(...)/adler32(...)")
+{
+        std::string const check = "123456789";
+        auto const* check_data  = reinterpret_cast<uint8_t const*>(check.data());
+
+        CHECK(RT::crc32(0, check_data, check.size()) == 0xcbf43926);
+        CHECK(RT::crc32(RT::crc32(0, check_data, 4), check_data + 4, 5) == 0xcbf43926);
+
+        std::string const wiki = "Wikipedia";
+        CHECK(RT::adler32(1, reinterpret_cast<uint8_t const*>(wiki.data()), wiki.size()) == 0x11e60398);
+}
+
+/// ----------------------------------------------------------------------------
+/// zlib stream framing
+TEST_CASE("zlib_compress(...)")
+{
+        std::vector<uint8_t> data(1024 * 1024);
+        for (size_t i = 0; i < data.size(); i++) {
+                data[i] = static_cast<uint8_t>((i / 7) % 13);
+        }
+
+        for (uint32_t num_threads : {1, 4}) {
+                auto const z = RT::zlib_compress(data.data(), data.size(), num_threads);
+
+                CHECK(z.size() > 6);
+                CHECK(z.size() < data.size() / 10);
+
+                /// header
+                CHECK(((z[0] << 8) | z[1]) % 31 == 0);
+                CHECK((z[0] & 0x0f) == 8);
+
+                /// trailer
+                uint32_t const adler = (z[z.size() - 4] << 24) | (z[z.size() - 3] << 16) |
+                                       (z[z.size() - 2] << 8) | (z[z.size() - 1] << 0);
+                CHECK(adler == RT::adler32(1, data.data(), data.size()));
+        }
+
+        /// empty input is a valid (empty) stream
+        auto const z = RT::zlib_compress(nullptr, 0);
+        CHECK(z.size() == 2 + 2 + 4);
+}
+
+/// ----------------------------------------------------------------------------
+/// compressed streams decompress back to the original, for inputs that span
+/// several blocks and several (concurrently compressed) chunks
+TEST_CASE("deflate_compress(...) round trip")
+{
+        uint32_t lcg = 12345;
+        auto next    = [&lcg]() {
+                lcg = lcg * 1103515245 + 12345;
+                return static_cast<uint8_t>(lcg >> 16);
+        };
+
+        std::string const text = "the quick brown fox jumps over the lazy dog";
+
+        std::vector<std::vector<uint8_t>> tc_list = {
+                {},
+                {0x2a},
+                std::vector<uint8_t>(text.begin(), text.end()),
+                std::vector<uint8_t>(100000, 0x07),
+        };
+
+        /// --------------------------------------------------------------------
+        /// incompressible data
+        std::vector<uint8_t> noise(300000);
+        for (auto& v : noise) {
+                v = next();
+        }
+        tc_list.push_back(noise);
+
+        /// --------------------------------------------------------------------
+        /// mostly repetitive data, with some noise, large enough for multiple
+        /// chunks
+        std::vector<uint8_t> mixed(4 * RT::DEFLATE_MIN_CHUNK_SIZE + 1234);
+        for (size_t i = 0; i < mixed.size(); i++) {
+                mixed[i] = (next() < 16) ? next() : static_cast<uint8_t>(text[i % text.size()]);
+        }
+        tc_list.push_back(mixed);
+
+        for (auto const& data : tc_list) {
+                for (uint32_t num_threads : {1, 4}) {
+                        auto const compressed = RT::deflate_compress(data.data(), data.size(), num_threads);
+                        auto const got        = test_inflater(compressed).inflate();
+
+                        CHECK(got.has_value());
+                        CHECK(got.value_or(std::vector<uint8_t>{}) == data);
+                }
+        }
+}
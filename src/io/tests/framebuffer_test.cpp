@@ -0,0 +1,201 @@
+/// c++ includes
+#include <cstdio>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/canvas.hpp"
+#include "io/framebuffer.hpp"
+#include "io/render_params.hpp"
+#include "io/world.hpp"
+#include "primitives/color.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/tuple.hpp"
+#include "utils/constants.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// convenience
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// a unique file name in the temporary directory
+static std::string temp_file_name(char const* suffix)
+{
+        char fname[] = "/tmp/rt-framebuffer-test-XXXXXX";
+
+        int fd = mkstemp(fname);
+        close(fd);
+        unlink(fname);
+
+        return std::string(fname) + suffix;
+}
+
+/// ----------------------------------------------------------------------------
+/// a color that is unique for each pixel
+static RT::color pixel_color(size_t x, size_t y)
+{
+        return RT::color(x / 64.0, y / 64.0, (x + y) / 128.0);
+}
+
+/// ----------------------------------------------------------------------------
+/// pixels can be read back from tiles, including partial ones along the edges
+TEST_CASE("framebuffer::read_pixel(...)/write_pixel(...)")
+{
+        auto const fb_fname = temp_file_name(".raw");
+
+        auto fb_01 = RT::framebuffer::create(37, 21, 8);
+        auto fb_02 = RT::framebuffer::create_mmapped(37, 21, fb_fname, 8);
+
+        CHECK(fb_01 != nullptr);
+        CHECK(fb_02 != nullptr);
+
+        if ((fb_01 == nullptr) || (fb_02 == nullptr)) {
+                return;
+        }
+
+        CHECK(!fb_01->is_file_backed());
+        CHECK(fb_02->is_file_backed());
+
+        for (auto* fb : {fb_01.get(), fb_02.get()}) {
+                CHECK(fb->num_tiles_x() == 5);
+                CHECK(fb->num_tiles_y() == 3);
+
+                auto const t = fb->tile_at_pixel(36, 20);
+                CHECK(t.tile_x == 4);
+                CHECK(t.tile_y == 2);
+                CHECK(t.x_begin == 32);
+                CHECK(t.y_begin == 16);
+                CHECK(t.x_end == 37);
+                CHECK(t.y_end == 21);
+
+                for (uint32_t ty = 0; ty < fb->num_tiles_y(); ty++) {
+                        for (uint32_t tx = 0; tx < fb->num_tiles_x(); tx++) {
+                                auto const tile = fb->tile(tx, ty);
+
+                                for (uint32_t y = tile.y_begin; y < tile.y_end; y++) {
+                                        for (uint32_t x = tile.x_begin; x < tile.x_end; x++) {
+                                                fb->write_pixel(x, y, pixel_color(x, y));
+                                        }
+                                }
+
+                                fb->tile_complete(tile);
+                        }
+                }
+
+                /// completed tiles (even the dropped ones) read back fine
+                for (size_t y = 0; y < fb->height(); y++) {
+                        for (size_t x = 0; x < fb->width(); x++) {
+                                CHECK(fb->read_pixel(x, y) == pixel_color(x, y));
+                        }
+                }
+        }
+
+        fb_02.reset();
+        unlink(fb_fname.c_str());
+}
+
+/// ----------------------------------------------------------------------------
+/// images written from a framebuffer are identical to the ones written from a
+/// canvas
+TEST_CASE("framebuffer::write(...)")
+{
+        auto fb = RT::framebuffer::create(45, 19, 16);
+        CHECK(fb != nullptr);
+
+        if (fb == nullptr) {
+                return;
+        }
+
+        for (uint32_t y = 0; y < fb->height(); y++) {
+                for (uint32_t x = 0; x < fb->width(); x++) {
+                        fb->write_pixel(x, y, pixel_color(x, y));
+                }
+        }
+
+        auto const c = fb->to_canvas();
+
+        auto read_file = [](std::string const& fname) {
+                std::vector<char> data;
+
+                if (FILE* f = fopen(fname.c_str(), "rb"); f != nullptr) {
+                        char buf[4096];
+                        size_t n;
+
+                        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+                                data.insert(data.end(), buf, buf + n);
+                        }
+
+                        fclose(f);
+                }
+
+                return data;
+        };
+
+        for (auto const* ext : {".ppm", ".pfm", ".png"}) {
+                auto const fb_fname     = temp_file_name(ext);
+                auto const canvas_fname = temp_file_name(ext);
+
+                fb->write(fb_fname);
+                c.write(canvas_fname);
+
+                auto const fb_data = read_file(fb_fname);
+
+                CHECK(!fb_data.empty());
+                CHECK(fb_data == read_file(canvas_fname));
+
+                unlink(fb_fname.c_str());
+                unlink(canvas_fname.c_str());
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// rendering into a framebuffer is the same as rendering into a canvas
+TEST_CASE("camera::render(...) into a framebuffer")
+{
+        auto const w = RT::world::create_default_world();
+
+        auto cam = RT::camera(53, 31, RT::PI_BY_2F);
+        cam.transform(RT::matrix_transformations_t::create_view_transform(RT::create_point(0.0, 0.0, -5.0),
+                                                                          RT::create_point(0.0, 0.0, 0.0),
+                                                                          RT::create_vector(0.0, 1.0, 0.0)));
+
+        auto const params = RT::config_render_params().hw_threads(2).antialias(false);
+        auto const c      = cam.render(w, params);
+
+        auto fb = RT::framebuffer::create(cam.hsize(), cam.vsize(), 16);
+        CHECK(fb != nullptr);
+
+        if (fb == nullptr) {
+                return;
+        }
+
+        cam.render(w, *fb, params);
+
+        bool all_equal = true;
+        for (size_t y = 0; y < c.height(); y++) {
+                for (size_t x = 0; x < c.width(); x++) {
+                        all_equal = all_equal && (fb->read_pixel(x, y) == c.read_pixel(x, y));
+                }
+        }
+
+        CHECK(all_equal);
+}
+
+/// ----------------------------------------------------------------------------
+/// tiles cannot be empty
+TEST_CASE("framebuffer::create(...) with empty tiles")
+{
+        auto const fb_fname = temp_file_name(".raw");
+
+        CHECK(RT::framebuffer::create(37, 21, 0) == nullptr);
+        CHECK(RT::framebuffer::create_mmapped(37, 21, fb_fname, 0) == nullptr);
+}
@@ -431,3 +431,156 @@ f 1/0/3 2/102/1 3/14/2
 
         CHECK(*gs_1 == *gs_2);
 }
+
+/// ----------------------------------------------------------------------------
+/// parallel parsing of an OBJ file must match the serial one, irrespective of
+/// the number of chunks that the input is split into.
+TEST_CASE("obj_file_loader::parse_parallel(...) matches parse(...)")
+{
+        std::string_view obj_data = R"""(# vertices before any group
+v -1 1 0
+v -1 0 0
+v 1 0 0
+v 1 1 0
+vn 0 0 1
+vn 0 1 0
+vt 0.5 0.5
+
+# face in the default group
+f 1 2 3 4
+
+g FirstGroup
+v 0 2 0
+# relative indices
+f -1 -4 -3
+f 1//2 2//1 -1//-1
+
+g SecondGroup
+v 0 3 0
+f 1 \
+  3 5 -1
+)""";
+
+        std::string fname = platform_utils::fill_file_with_data(obj_data);
+
+        RT::obj_file_parser p1(fname);
+        auto const serial_result = p1.parse();
+
+        CHECK(serial_result.unknown_tokens_cref() == 3);
+        CHECK(serial_result.vertex_list_cref().size() == 6);
+        CHECK(serial_result.vertex_normal_list_cref().size() == 2);
+        CHECK(serial_result.default_group_cref()->child_shapes_cref().size() == 2);
+        CHECK(serial_result.group_list_cref().size() == 2);
+
+        for (uint32_t num_threads : {1, 2, 3, 7, 64}) {
+                /// ------------------------------------------------------------
+                /// tiny chunks, to force splitting the input up
+                auto const parallel_result = p1.parse_parallel(num_threads, 1);
+
+                CHECK(parallel_result.unknown_tokens_cref() == serial_result.unknown_tokens_cref());
+                CHECK(parallel_result.vertex_list_cref() == serial_result.vertex_list_cref());
+                CHECK(parallel_result.vertex_normal_list_cref() == serial_result.vertex_normal_list_cref());
+                CHECK(parallel_result.group_list_cref().size() == serial_result.group_list_cref().size());
+
+                /// ------------------------------------------------------------
+                /// compare triangles in the default and all named groups
+                auto same_triangles = [](auto const& g1, auto const& g2) {
+                        auto const& g1_shapes = g1->child_shapes_cref();
+                        auto const& g2_shapes = g2->child_shapes_cref();
+
+                        if (g1_shapes.size() != g2_shapes.size()) {
+                                return false;
+                        }
+
+                        for (size_t i = 0; i < g1_shapes.size(); i++) {
+                                auto t1 = dynamic_cast<const RT::triangle*>(g1_shapes[i].get());
+                                auto t2 = dynamic_cast<const RT::triangle*>(g2_shapes[i].get());
+
+                                if (!(*t1 == *t2) || !(t1->n1() == t2->n1()) || !(t1->n3() == t2->n3())) {
+                                        return false;
+                                }
+                        }
+
+                        return true;
+                };
+
+                CHECK(same_triangles(parallel_result.default_group_cref(), serial_result.default_group_cref()));
+                for (size_t i = 0; i < serial_result.group_list_cref().size(); i++) {
+                        CHECK(same_triangles(parallel_result.group_list_cref()[i],
+                                             serial_result.group_list_cref()[i]));
+                }
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// parallel parsing stops at the first bad face, just like the serial one.
+TEST_CASE("obj_file_loader::parse_parallel(...) with bad face data")
+{
+        std::string_view obj_data = R"""(v -1 1 0
+v -1 0 0
+v 1 0 0
+f 1 2 3
+g AGroup
+f 1 2 3
+v 1 1 0
+f 1 2 100
+v 0 2 0
+f 1 2 3
+)""";
+
+        std::string fname = platform_utils::fill_file_with_data(obj_data);
+
+        RT::obj_file_parser p1(fname);
+        for (uint32_t num_threads : {1, 2, 4, 8}) {
+                auto const parse_result = p1.parse_parallel(num_threads, 1);
+
+                CHECK(parse_result.vertex_list_cref().size() == 4);
+                CHECK(parse_result.default_group_cref()->child_shapes_cref().size() == 1);
+                CHECK(parse_result.group_list_cref().size() == 1);
+                CHECK(parse_result.group_list_cref()[0]->child_shapes_cref().size() == 1);
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// lines which the fast path doesn't handle (signs, comments, extra values,
+/// odd whitespace etc.) are parsed just like the serial parser does.
+TEST_CASE("obj_file_loader::parse_parallel(...) fast path equivalence")
+{
+        std::string_view obj_data = "v\t-1.0e0  +1 0\r\n"
+                                    "v -1 0 0 # a comment\n"
+                                    "v 1 0 0 1.0\n"
+                                    "v 1 1 0\n"
+                                    "vn 0 0 -1\n"
+                                    "vn +0 1 0\n"
+                                    "f 1//1 2//2 3//1 4//2\n"
+                                    "f -4/1/-1 -3/2/-2 -2/3/-1\n"
+                                    "f 1 2 3 # another comment\n";
+
+        std::string fname = platform_utils::fill_file_with_data(obj_data);
+
+        RT::obj_file_parser p1(fname);
+        auto const serial_result   = p1.parse();
+        auto const parallel_result = p1.parse_parallel(2, 1);
+
+        CHECK(serial_result.vertex_list_cref().size() == 4);
+        CHECK(serial_result.vertex_normal_list_cref().size() == 2);
+        CHECK(serial_result.default_group_cref()->child_shapes_cref().size() == 4);
+
+        CHECK(parallel_result.unknown_tokens_cref() == serial_result.unknown_tokens_cref());
+        CHECK(parallel_result.vertex_list_cref() == serial_result.vertex_list_cref());
+        CHECK(parallel_result.vertex_normal_list_cref() == serial_result.vertex_normal_list_cref());
+
+        auto const& s_shapes = serial_result.default_group_cref()->child_shapes_cref();
+        auto const& p_shapes = parallel_result.default_group_cref()->child_shapes_cref();
+        CHECK(p_shapes.size() == s_shapes.size());
+
+        for (size_t i = 0; i < std::min(s_shapes.size(), p_shapes.size()); i++) {
+                auto t1 = dynamic_cast<const RT::triangle*>(s_shapes[i].get());
+                auto t2 = dynamic_cast<const RT::triangle*>(p_shapes[i].get());
+
+                CHECK(*t1 == *t2);
+                CHECK(t1->n1() == t2->n1());
+                CHECK(t1->n2() == t2->n2());
+                CHECK(t1->n3() == t2->n3());
+        }
+}
@@ -0,0 +1,191 @@
+/// c++ includes
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <stdio.h>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/obj_file_loader.hpp"
+#include "io/obj_mesh_cache.hpp"
+#include "io/obj_parse_result.hpp"
+#include "platform_utils/mmapped_file_reader.hpp"
+#include "primitives/tuple.hpp"
+#include "shapes/group.hpp"
+#include "shapes/shape_interface.hpp"
+#include "shapes/triangle.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_INFO;
+
+/// a convenience alias
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// a small mesh with flat and smooth triangles, in both default and named
+/// groups
+static std::string_view const obj_data = R"""(v -1 1 0
+v -1 0 0
+v 1 0 0
+v 1 1 0
+v 0 2 0
+v 0.5 0.25 1.5
+vn 0 0 1
+vn 0 1 0
+vn 1 0 0
+f 1 2 3 4
+f 1 2 6
+g FirstGroup
+f 1//1 2//2 3//3
+f 3 4 5
+f 2 5 6
+)""";
+
+/// ----------------------------------------------------------------------------
+/// count all triangles in a group hierarchy
+static size_t count_triangles(std::shared_ptr<RT::shape_interface const> const& shape)
+{
+        if (auto g = std::dynamic_pointer_cast<RT::group const>(shape)) {
+                size_t retval = 0;
+                for (auto const& cs : g->child_shapes_cref()) {
+                        retval += count_triangles(cs);
+                }
+
+                return retval;
+        }
+
+        return 1;
+}
+
+/// ----------------------------------------------------------------------------
+/// face indices of all triangles in a parse-result, in a canonical order
+static std::vector<std::pair<std::array<int32_t, 3>, std::array<int32_t, 3>>> sorted_face_indices(
+        RT::obj_parse_result const& result)
+{
+        std::vector<std::pair<std::array<int32_t, 3>, std::array<int32_t, 3>>> retval;
+
+        for (auto const& ti : result.triangle_indices_cref()) {
+                retval.emplace_back(ti.vertices, ti.normals);
+        }
+        std::sort(retval.begin(), retval.end());
+
+        return retval;
+}
+
+/// ----------------------------------------------------------------------------
+/// the parser records face indices of every triangle that it creates
+TEST_CASE("obj_file_parser::parse_parallel(...) records triangle indices")
+{
+        std::string fname = platform_utils::fill_file_with_data(obj_data);
+        auto const result = RT::obj_file_parser(fname).parse_parallel();
+
+        auto const& til = result.triangle_indices_cref();
+        CHECK(til.size() == 6);
+
+        for (auto const& ti : til) {
+                CHECK(ti.tri != nullptr);
+
+                auto const& vl = result.vertex_list_cref();
+                CHECK(ti.tri->p1() == vl[ti.vertices[0]]);
+                CHECK(ti.tri->p2() == vl[ti.vertices[1]]);
+                CHECK(ti.tri->p3() == vl[ti.vertices[2]]);
+        }
+
+        /// --------------------------------------------------------------------
+        /// flat triangles have no normal indices, smooth ones do
+        using index_triple = std::array<int32_t, 3>;
+
+        auto const face_indices = sorted_face_indices(result);
+        auto const flat_tri     = std::make_pair(index_triple{0, 1, 2}, index_triple{-1, -1, -1});
+        auto const smooth_tri   = std::make_pair(index_triple{0, 1, 2}, index_triple{0, 1, 2});
+
+        CHECK(std::count(face_indices.begin(), face_indices.end(), flat_tri) == 1);
+        CHECK(std::count(face_indices.begin(), face_indices.end(), smooth_tri) == 1);
+
+        unlink(fname.c_str());
+}
+
+/// ----------------------------------------------------------------------------
+/// first load writes the cache, second one reads it
+TEST_CASE("load_obj_file_cached(...) writes and reads the mesh cache")
+{
+        std::string fname       = platform_utils::fill_file_with_data(obj_data);
+        auto const cache_fname  = RT::obj_mesh_cache_file_name(fname);
+        size_t const threshold  = 1;
+
+        CHECK(RT::read_obj_mesh_cache(fname, threshold) == std::nullopt);
+
+        auto const first_load = RT::load_obj_file_cached(fname, threshold);
+        CHECK(access(cache_fname.c_str(), R_OK) == 0);
+
+        auto const maybe_cached = RT::read_obj_mesh_cache(fname, threshold);
+        CHECK(maybe_cached.has_value());
+
+        auto const& cached = maybe_cached.value();
+        CHECK(cached.vertex_list_cref() == first_load.vertex_list_cref());
+        CHECK(cached.vertex_normal_list_cref() == first_load.vertex_normal_list_cref());
+        CHECK(cached.group_list_cref().size() == 1);
+        CHECK(sorted_face_indices(cached) == sorted_face_indices(first_load));
+        CHECK(count_triangles(cached.default_group_cref()) == 3);
+        CHECK(count_triangles(cached.group_list_cref()[0]) == 3);
+
+        /// --------------------------------------------------------------------
+        /// the hierarchy is preserved i.e. groups were divided
+        CHECK(cached.group_list_cref()[0]->child_shapes_cref().size() ==
+              first_load.group_list_cref()[0]->child_shapes_cref().size());
+
+        /// --------------------------------------------------------------------
+        /// smooth triangles keep their normals
+        bool found_smooth = false;
+        for (auto const& cs : cached.group_list_cref()[0]->child_shapes_cref()) {
+                auto t = std::dynamic_pointer_cast<RT::triangle const>(cs);
+                if ((t != nullptr) && (t->n1() == RT::create_vector(0.0, 0.0, 1.0))) {
+                        found_smooth = (t->n2() == RT::create_vector(0.0, 1.0, 0.0));
+                }
+        }
+        CHECK(found_smooth);
+
+        /// --------------------------------------------------------------------
+        /// cache created with a different threshold is stale
+        CHECK(RT::read_obj_mesh_cache(fname, 0) == std::nullopt);
+
+        unlink(cache_fname.c_str());
+        unlink(fname.c_str());
+}
+
+/// ----------------------------------------------------------------------------
+/// modifying the source file invalidates the cache
+TEST_CASE("read_obj_mesh_cache(...) with a modified source file")
+{
+        std::string fname      = platform_utils::fill_file_with_data(obj_data);
+        auto const cache_fname = RT::obj_mesh_cache_file_name(fname);
+
+        RT::load_obj_file_cached(fname);
+        CHECK(RT::read_obj_mesh_cache(fname, 0).has_value());
+
+        /// --------------------------------------------------------------------
+        /// same size, different contents
+        FILE* f = fopen(fname.c_str(), "r+");
+        fputs("v -2", f);
+        fclose(f);
+
+        CHECK(RT::read_obj_mesh_cache(fname, 0) == std::nullopt);
+
+        /// --------------------------------------------------------------------
+        /// reloading refreshes the cache
+        auto const reloaded = RT::load_obj_file_cached(fname);
+        CHECK(reloaded.vertex(1) == RT::create_point(-2.0, 1.0, 0.0));
+        CHECK(RT::read_obj_mesh_cache(fname, 0).has_value());
+
+        unlink(cache_fname.c_str());
+        unlink(fname.c_str());
+}
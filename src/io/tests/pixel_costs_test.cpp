@@ -0,0 +1,153 @@
+/// c++ includes
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/canvas.hpp"
+#include "io/pixel_costs.hpp"
+#include "io/render_params.hpp"
+#include "io/world.hpp"
+#include "primitives/color.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/tuple.hpp"
+#include "utils/constants.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// convenience
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// camera looking at the default world
+static RT::camera create_camera(uint32_t hsize, uint32_t vsize)
+{
+        auto c_01       = RT::camera(hsize, vsize, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        return c_01;
+}
+
+/// ----------------------------------------------------------------------------
+/// creating pixel cost maps
+TEST_CASE("pixel_cost_map::pixel_cost_map(...) test")
+{
+        auto const m_01 = RT::pixel_cost_map();
+        CHECK(m_01.empty());
+
+        auto const m_02 = RT::pixel_cost_map(4, 3);
+        CHECK(!m_02.empty());
+        CHECK(m_02.width() == 4);
+        CHECK(m_02.height() == 3);
+
+        for (uint32_t y = 0; y < m_02.height(); y++) {
+                for (uint32_t x = 0; x < m_02.width(); x++) {
+                        CHECK(m_02.at(x, y).cycles == 0);
+                        CHECK(m_02.at(x, y).rays == 0);
+                        CHECK(m_02.at(x, y).primitive_tests == 0);
+                }
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// cheapest pixels are blue, and the costliest ones red
+TEST_CASE("pixel_cost_map::heatmap(...) test")
+{
+        auto m_01 = RT::pixel_cost_map(3, 1);
+
+        m_01.at(0, 0).rays = 1;
+        m_01.at(1, 0).rays = 10;
+        m_01.at(2, 0).rays = 100;
+
+        auto const rays_heatmap = m_01.heatmap(RT::pixel_cost_metric::PIXEL_COST_RAYS);
+
+        CHECK(rays_heatmap.width() == 3);
+        CHECK(rays_heatmap.height() == 1);
+        CHECK(rays_heatmap.read_pixel(0, 0) == RT::color(0.0, 0.0, 1.0));
+        CHECK(rays_heatmap.read_pixel(2, 0) == RT::color(1.0, 0.0, 0.0));
+
+        /// --------------------------------------------------------------------
+        /// scaled logarithmically, so the middle pixel is well past blue
+        auto const mid_color = rays_heatmap.read_pixel(1, 0);
+        CHECK(mid_color.G() > 0.5);
+
+        /// --------------------------------------------------------------------
+        /// when all pixels cost the same, the heatmap is all blue
+        auto const tests_heatmap = m_01.heatmap(RT::pixel_cost_metric::PIXEL_COST_PRIMITIVE_TESTS);
+        for (uint32_t x = 0; x < 3; x++) {
+                CHECK(tests_heatmap.read_pixel(x, 0) == RT::color(0.0, 0.0, 1.0));
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// heatmaps are written next to the image
+TEST_CASE("pixel_cost_map::write_heatmaps(...) test")
+{
+        char dir_name[] = "/tmp/rt-pixel-costs-test-XXXXXX";
+        CHECK(mkdtemp(dir_name) != nullptr);
+
+        auto m_01 = RT::pixel_cost_map(2, 2);
+        m_01.at(1, 1).cycles = 42;
+
+        auto const image_fname = std::string(dir_name) + "/image.png";
+        m_01.write_heatmaps(image_fname);
+
+        for (auto const* metric : {"cycles", "rays", "primitive-tests"}) {
+                auto const fname = std::string(dir_name) + "/image-" + metric + ".png";
+
+                struct stat st;
+                CHECK(stat(fname.c_str(), &st) == 0);
+                unlink(fname.c_str());
+        }
+
+        rmdir(dir_name);
+}
+
+/// ----------------------------------------------------------------------------
+/// per-pixel costs of a render add up to the statistics of the render
+TEST_CASE("camera::render(...) heatmap test")
+{
+        auto const w_01 = RT::world::create_default_world();
+        auto const c_01 = create_camera(11, 11);
+
+        c_01.render(w_01, RT::config_render_params().hw_threads(2));
+        CHECK(c_01.last_pixel_costs().empty());
+
+        c_01.render(w_01, RT::config_render_params().hw_threads(2).heatmap(true));
+
+        auto const& costs  = c_01.last_pixel_costs();
+        auto const& totals = c_01.last_render_stats().totals();
+
+        CHECK(costs.width() == 11);
+        CHECK(costs.height() == 11);
+
+        uint64_t total_rays  = 0;
+        uint64_t total_tests = 0;
+
+        for (uint32_t y = 0; y < costs.height(); y++) {
+                for (uint32_t x = 0; x < costs.width(); x++) {
+                        auto const& cost = costs.at(x, y);
+
+                        CHECK(cost.rays >= 1);
+                        CHECK(cost.primitive_tests >= 2);
+
+                        total_rays += cost.rays;
+                        total_tests += cost.primitive_tests;
+                }
+        }
+
+        CHECK(total_rays == totals.rays());
+        CHECK(total_tests == totals.primitive_tests);
+}
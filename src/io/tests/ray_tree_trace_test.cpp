@@ -0,0 +1,146 @@
+/// c++ includes
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/ray_tree_trace.hpp"
+#include "io/render_params.hpp"
+#include "io/world.hpp"
+#include "patterns/material.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/tuple.hpp"
+#include "shapes/plane.hpp"
+#include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// convenience
+namespace RT   = raytracer;
+using RT_XFORM = RT::matrix_transformations_t;
+
+/// ----------------------------------------------------------------------------
+/// default world, with a reflective floor beneath it
+static RT::world create_world()
+{
+        auto w_01     = RT::world::create_default_world();
+        auto xz_plane = std::make_shared<RT::plane>();
+
+        xz_plane->set_material(RT::material().set_reflective(0.5));
+        xz_plane->transform(RT_XFORM::create_3d_translation_matrix(0.0, -1.0, 0.0));
+
+        w_01.add(xz_plane);
+
+        return w_01;
+}
+
+/// ----------------------------------------------------------------------------
+/// camera looking down at the floor, in front of the spheres
+static RT::camera create_camera(uint32_t hsize, uint32_t vsize)
+{
+        auto c_01       = RT::camera(hsize, vsize, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 1.0, -6.0);
+        auto to_point   = RT::create_point(0.0, -1.0, -3.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT_XFORM::create_view_transform(from_point, to_point, up_vector));
+
+        return c_01;
+}
+
+/// ----------------------------------------------------------------------------
+/// pixels off the canvas cannot be traced
+TEST_CASE("camera::trace_pixel(...) off the canvas test")
+{
+        auto const w_01 = create_world();
+        auto const c_01 = create_camera(11, 11);
+
+        CHECK(!c_01.trace_pixel(w_01, 11, 5).has_value());
+        CHECK(!c_01.trace_pixel(w_01, 5, 11).has_value());
+        CHECK(c_01.trace_pixel(w_01, 10, 10).has_value());
+}
+
+/// ----------------------------------------------------------------------------
+/// ray-tree of a pixel looking at the reflective floor
+TEST_CASE("camera::trace_pixel(...) ray-tree test")
+{
+        auto const w_01 = create_world();
+        auto const c_01 = create_camera(11, 11);
+
+        auto const rays_before = RT::render_counters::this_thread().rays();
+        auto const trace       = c_01.trace_pixel(w_01, 5, 5);
+        auto const rays_after  = RT::render_counters::this_thread().rays();
+
+        CHECK(trace.has_value());
+        CHECK(trace->x() == 5);
+        CHECK(trace->y() == 5);
+
+        /// --------------------------------------------------------------------
+        /// every ray that was cast is in the tree
+        auto const& rays = trace->rays();
+        CHECK(rays.size() == (rays_after - rays_before));
+
+        /// --------------------------------------------------------------------
+        /// without antialiasing, a single primary ray hits the floor...
+        CHECK(trace->roots().size() == 1);
+
+        auto const& root = rays[trace->roots()[0]];
+        CHECK(root.kind == RT::traced_ray_kind::TRACED_RAY_PRIMARY);
+        CHECK(root.depth == 0);
+        CHECK(root.hit);
+        CHECK(root.objects_tested == w_01.shapes().size());
+        CHECK(root.primitive_tests >= w_01.shapes().size());
+        CHECK(root.ray_color == trace->pixel_color());
+        CHECK(root.total_ns >= root.self_ns);
+        CHECK(trace->total_ns() >= root.total_ns);
+
+        /// --------------------------------------------------------------------
+        /// ... and then casts a shadow ray towards the light, and a reflected
+        /// ray
+        CHECK(root.children.size() == 2);
+
+        auto const& shadow_ray = rays[root.children[0]];
+        CHECK(shadow_ray.kind == RT::traced_ray_kind::TRACED_RAY_SHADOW);
+        CHECK(shadow_ray.depth == 1);
+        CHECK(!shadow_ray.hit);
+
+        auto const& reflected_ray = rays[root.children[1]];
+        CHECK(reflected_ray.kind == RT::traced_ray_kind::TRACED_RAY_REFLECTED);
+        CHECK(reflected_ray.depth == 1);
+
+        /// --------------------------------------------------------------------
+        /// the pixel is colored the same as in a render
+        auto const canvas_01 = c_01.render(w_01, RT::config_render_params().hw_threads(1));
+        CHECK(canvas_01.read_pixel(5, 5) == trace->pixel_color());
+
+        /// --------------------------------------------------------------------
+        /// json has them all
+        auto const json = trace->to_json();
+        CHECK(json.find("\"pixel\": [5, 5]") != std::string::npos);
+        CHECK(json.find("\"kind\": \"primary\"") != std::string::npos);
+        CHECK(json.find("\"kind\": \"shadow\"") != std::string::npos);
+        CHECK(json.find("\"kind\": \"reflected\"") != std::string::npos);
+}
+
+/// ----------------------------------------------------------------------------
+/// antialiasing casts (at least) five primary rays per pixel
+TEST_CASE("camera::trace_pixel(...) antialiased test")
+{
+        auto const w_01  = create_world();
+        auto const c_01  = create_camera(11, 11);
+        auto const trace = c_01.trace_pixel(w_01, 5, 5, RT::config_render_params().antialias(true));
+
+        CHECK(trace.has_value());
+        CHECK(trace->roots().size() >= 5);
+
+        for (auto const i : trace->roots()) {
+                CHECK(trace->rays()[i].kind == RT::traced_ray_kind::TRACED_RAY_PRIMARY);
+        }
+}
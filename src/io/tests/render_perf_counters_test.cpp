@@ -0,0 +1,134 @@
+/// c++ includes
+#include <cstdint>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/render_params.hpp"
+#include "io/render_perf_counters.hpp"
+#include "io/world.hpp"
+#include "platform_utils/perf_counters.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/tuple.hpp"
+#include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
+#include "utils/utils.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// convenience
+namespace RT = raytracer;
+namespace PU = platform_utils;
+
+/// ----------------------------------------------------------------------------
+/// camera looking at the spheres of the default world
+static RT::camera create_camera(uint32_t hsize, uint32_t vsize)
+{
+        auto c_01       = RT::camera(hsize, vsize, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        return c_01;
+}
+
+/// ----------------------------------------------------------------------------
+/// stringified phases of rendering
+TEST_CASE("stringify_render_phase(...) test")
+{
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_WORK_GENERATION) == "work-generation");
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_TRAVERSAL) == "traversal");
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_SHADING) == "shading");
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_ANTIALIASING) == "antialiasing");
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_OUTPUT) == "output");
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_OTHER) == "other");
+        CHECK(RT::stringify_render_phase(RT::RENDER_PHASE_MAX) == "unknown");
+}
+
+/// ----------------------------------------------------------------------------
+/// ratios of the events of a phase
+TEST_CASE("summarize_render_phase(...) test")
+{
+        RT::render_phase_events events = {};
+
+        events[RT::RENDER_PHASE_TRAVERSAL][PU::PERF_EVENT_CYCLES]        = 3000;
+        events[RT::RENDER_PHASE_TRAVERSAL][PU::PERF_EVENT_INSTRUCTIONS]  = 6000;
+        events[RT::RENDER_PHASE_TRAVERSAL][PU::PERF_EVENT_L1D_MISSES]    = 120;
+        events[RT::RENDER_PHASE_TRAVERSAL][PU::PERF_EVENT_LLC_MISSES]    = 6;
+        events[RT::RENDER_PHASE_TRAVERSAL][PU::PERF_EVENT_BRANCH_MISSES] = 30;
+        events[RT::RENDER_PHASE_SHADING][PU::PERF_EVENT_CYCLES]          = 1000;
+
+        auto const s_01 = RT::summarize_render_phase(events, RT::RENDER_PHASE_TRAVERSAL);
+
+        CHECK(RT::epsilon_equal(s_01.ipc, 2.0));
+        CHECK(RT::epsilon_equal(s_01.l1d_mpki, 20.0));
+        CHECK(RT::epsilon_equal(s_01.llc_mpki, 1.0));
+        CHECK(RT::epsilon_equal(s_01.branch_mpki, 5.0));
+        CHECK(RT::epsilon_equal(s_01.cycles_share, 0.75));
+
+        /// --------------------------------------------------------------------
+        /// no instructions, no ratios of them
+        auto const s_02 = RT::summarize_render_phase(events, RT::RENDER_PHASE_SHADING);
+
+        CHECK(s_02.ipc == 0.0);
+        CHECK(s_02.l1d_mpki == 0.0);
+        CHECK(RT::epsilon_equal(s_02.cycles_share, 0.25));
+
+        /// --------------------------------------------------------------------
+        /// nothing at all
+        auto const s_03 = RT::summarize_render_phase(events, RT::RENDER_PHASE_OUTPUT);
+
+        CHECK(s_03.ipc == 0.0);
+        CHECK(s_03.cycles_share == 0.0);
+}
+
+/// ----------------------------------------------------------------------------
+/// counting events does not change the image, and when events can be counted,
+/// tracing rays is where they are
+TEST_CASE("camera::render_with_stats(...) perf counters test")
+{
+        auto w_01 = RT::world::create_default_world();
+        auto c_01 = create_camera(11, 11);
+
+        auto const img_01 = c_01.render(w_01, RT::config_render_params().hw_threads(1));
+
+        auto const params          = RT::config_render_params().hw_threads(2).perf_counters(true);
+        auto const [img_02, stats] = c_01.render_with_stats(w_01, params);
+
+        for (uint32_t y = 0; y < 11; y++) {
+                for (uint32_t x = 0; x < 11; x++) {
+                        CHECK(img_02.read_pixel(x, y) == img_01.read_pixel(x, y));
+                }
+        }
+
+        auto const& events = stats.totals().phase_events;
+
+        if (!RT::render_perf_counters::available()) {
+                CHECK(!stats.has_phase_events());
+                return;
+        }
+
+        CHECK(stats.has_phase_events());
+        CHECK(events[RT::RENDER_PHASE_TRAVERSAL][PU::PERF_EVENT_INSTRUCTIONS] > 0);
+        CHECK(events[RT::RENDER_PHASE_SHADING][PU::PERF_EVENT_INSTRUCTIONS] > 0);
+        CHECK(events[RT::RENDER_PHASE_OUTPUT][PU::PERF_EVENT_INSTRUCTIONS] > 0);
+}
+
+/// ----------------------------------------------------------------------------
+/// nothing is counted unless asked for
+TEST_CASE("camera::render_with_stats(...) no perf counters test")
+{
+        auto w_01 = RT::world::create_default_world();
+        auto c_01 = create_camera(5, 5);
+
+        auto const [img, stats] = c_01.render_with_stats(w_01, RT::config_render_params().hw_threads(1));
+
+        CHECK(!stats.has_phase_events());
+        CHECK(RT::render_perf_counters::this_thread() == nullptr);
+}
@@ -0,0 +1,135 @@
+/// c++ includes
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/camera.hpp"
+#include "io/render_params.hpp"
+#include "io/render_progress.hpp"
+#include "io/world.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/tuple.hpp"
+#include "utils/constants.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// convenience
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// camera looking at the default world
+static RT::camera create_camera(uint32_t hsize, uint32_t vsize)
+{
+        auto c_01       = RT::camera(hsize, vsize, RT::PI_BY_2F);
+        auto from_point = RT::create_point(0.0, 0.0, -5.0);
+        auto to_point   = RT::create_point(0.0, 0.0, 0.0);
+        auto up_vector  = RT::create_vector(0.0, 1.0, 0.0);
+
+        c_01.transform(RT::matrix_transformations_t::create_view_transform(from_point, to_point, up_vector));
+
+        return c_01;
+}
+
+/// ----------------------------------------------------------------------------
+/// contents of a file, if there is one
+static std::string read_file(std::string const& fname)
+{
+        std::ifstream src(fname);
+        std::stringstream ss("");
+
+        ss << src.rdbuf();
+
+        return ss.str();
+}
+
+/// ----------------------------------------------------------------------------
+/// percentage done, and time to finish
+TEST_CASE("render_progress_snapshot::percent(...) and eta_sec(...) test")
+{
+        RT::render_progress_snapshot s_01;
+        s_01.pixels_total = 200;
+
+        CHECK(s_01.percent() == 0.0);
+        CHECK(!s_01.eta_sec().has_value());
+
+        s_01.pixels_done = 50;
+        s_01.elapsed_sec = 2.0;
+
+        CHECK(s_01.percent() == 25.0);
+        CHECK(s_01.eta_sec().has_value());
+        CHECK(s_01.eta_sec().value() == 6.0);
+
+        s_01.pixels_done = 200;
+        CHECK(s_01.percent() == 100.0);
+        CHECK(s_01.eta_sec().value() == 0.0);
+}
+
+/// ----------------------------------------------------------------------------
+/// work items add up
+TEST_CASE("render_progress::work_item_done(...) test")
+{
+        RT::render_progress p_01(100, 4);
+
+        auto const s_01 = p_01.snapshot();
+        CHECK(s_01.pixels_done == 0);
+        CHECK(s_01.pixels_total == 100);
+        CHECK(s_01.work_items_done == 0);
+        CHECK(s_01.work_items_total == 4);
+        CHECK(s_01.rays_cast == 0);
+
+        p_01.work_item_done(25, 30);
+        p_01.work_item_done(25, 40);
+
+        auto const s_02 = p_01.snapshot();
+        CHECK(s_02.pixels_done == 50);
+        CHECK(s_02.work_items_done == 2);
+        CHECK(s_02.rays_cast == 70);
+        CHECK(s_02.percent() == 50.0);
+        CHECK(s_02.elapsed_sec >= s_01.elapsed_sec);
+}
+
+/// ----------------------------------------------------------------------------
+/// a render reports its progress to the status file, and is done by the time
+/// it returns
+TEST_CASE("camera::render(...) progress test")
+{
+        char dir_name[] = "/tmp/rt-render-progress-test-XXXXXX";
+        CHECK(mkdtemp(dir_name) != nullptr);
+
+        auto const status_fname = std::string(dir_name) + "/status.json";
+        auto const w_01         = RT::world::create_default_world();
+        auto const c_01         = create_camera(11, 11);
+
+        c_01.render(w_01, RT::config_render_params()
+                                  .hw_threads(2)
+                                  .progress_interval_ms(1)
+                                  .progress_status_file(status_fname));
+
+        auto const status = read_file(status_fname);
+        auto const rays   = std::to_string(c_01.last_render_stats().totals().rays());
+
+        CHECK(status.find("\"state\": \"done\"") != std::string::npos);
+        CHECK(status.find("\"pixels_done\": 121,") != std::string::npos);
+        CHECK(status.find("\"pixels_total\": 121,") != std::string::npos);
+        CHECK(status.find("\"rays\": " + rays + ",") != std::string::npos);
+        CHECK(status.find("\"eta_sec\": 0.000") != std::string::npos);
+
+        /// --------------------------------------------------------------------
+        /// temporary status file is gone
+        struct stat st;
+        CHECK(stat((status_fname + ".tmp").c_str(), &st) != 0);
+
+        unlink(status_fname.c_str());
+        rmdir(dir_name);
+}
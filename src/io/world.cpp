@@ -12,8 +12,11 @@
 
 /// our includes
 #include "io/phong_illumination.hpp"
+#include "io/ray_tree_trace.hpp"
+#include "io/render_perf_counters.hpp"
 #include "patterns/material.hpp"
 #include "patterns/solid_pattern.hpp"
+#include "patterns/texture_footprint.hpp"
 #include "primitives/color.hpp"
 #include "primitives/intersection_info.hpp"
 #include "primitives/intersection_record.hpp"
@@ -24,6 +27,7 @@
 #include "shapes/shape_interface.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/execution_profiler.hpp"
+#include "utils/render_counters.hpp"
 
 namespace raytracer
 {
@@ -82,9 +86,11 @@ namespace raytracer
         }
 
         /// --------------------------------------------------------------------
-        /// this function is called to add a light to the world
-        void world::add(std::shared_ptr<shape_interface const> const s)
+        /// this function is called to add a shape to the world. shapes are
+        /// complete by now, so their world-space transforms are baked here.
+        void world::add(std::shared_ptr<shape_interface> const s)
         {
+                s->freeze_world_transforms();
                 shape_list_.push_back(s);
                 return;
         }
@@ -108,7 +114,8 @@ namespace raytracer
         /// that a ray makes when it hits objects / shapes in this world
         intersection_records world::intersect(ray_t const& R) const
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
+                render_perf_counters::phase_scope const phase(RENDER_PHASE_TRAVERSAL);
 
                 intersection_records xs_result;
 
@@ -137,19 +144,16 @@ namespace raytracer
         /// compute the color when a ray hits the world
         color world::shade_hit(intersection_info_t const& xs_info, uint8_t remaining) const
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 color shade_color = color_black();
 
                 for (auto const& a_light : light_list_) {
                         auto point_in_shadow = is_shadowed(xs_info.over_position(), a_light);
 
-                        shade_color += phong_illumination(xs_info.what_object(),   /// object-material
-                                                          xs_info.over_position(), /// point of intersection
-                                                          a_light,                 /// the light
-                                                          xs_info.eye_vector(),    /// eye
-                                                          xs_info.normal_vector(), /// normal
-                                                          point_in_shadow);        /// shadowed ?
+                        shade_color += phong_illumination(xs_info,          /// the hit
+                                                          a_light,          /// the light
+                                                          point_in_shadow); /// shadowed ?
                 }
 
                 auto const reflect_color = reflected_color(xs_info, remaining);
@@ -173,20 +177,32 @@ namespace raytracer
         /// compute color due to ray(s) intersecting shape(s) in the world
         color world::color_at(ray_t const& R, uint8_t remaining) const
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 /// ----------------------------------------------------
                 /// compute the visible intersection
                 auto xs_list       = intersect(R);
                 auto vis_xs_record = visible_intersection(xs_list);
 
+                ray_tree_trace::note_intersections(shape_list_.size(), xs_list.size());
+
                 if (vis_xs_record) {
                         /// ----------------------------------------------------
                         /// OK, so there seems to be a visible
                         /// intersection. compute the color.
+                        render_perf_counters::phase_scope const phase(RENDER_PHASE_SHADING);
+
                         auto xs_record = vis_xs_record.value();
                         auto xs_info   = R.prepare_computations(xs_list, xs_record.index());
 
+                        ray_tree_trace::note_hit(xs_record);
+
+                        /// ----------------------------------------------------
+                        /// widen the ray by the distance it has travelled,
+                        /// for textures to filter over.
+                        texture_footprint::hit_scope const footprint(xs_info.point() *
+                                                                     magnitude(R.direction()));
+
                         return shade_hit(xs_info, remaining);
                 }
 
@@ -234,7 +250,16 @@ namespace raytracer
                 auto const dist_to_light = magnitude(pt_to_light);
                 auto const shadow_ray    = ray_t(pt, normalize(pt_to_light));
 
-                return shadow_ray.has_intersection_before(shapes(), dist_to_light);
+                render_counters::this_thread().shadow_rays += 1;
+                ray_tree_trace::scope const trace_ray(traced_ray_kind::TRACED_RAY_SHADOW, shadow_ray);
+                render_perf_counters::phase_scope const phase(RENDER_PHASE_TRAVERSAL);
+
+                auto const occluded = shadow_ray.has_intersection_before(shapes(), dist_to_light);
+
+                ray_tree_trace::note_intersections(shape_list_.size(), occluded ? 1 : 0);
+                ray_tree_trace::note_occluded(occluded);
+
+                return occluded;
         }
 
         /// --------------------------------------------------------------------
@@ -250,7 +275,13 @@ namespace raytracer
                 }
 
                 ray_t reflected_ray(xs_info.over_position(), xs_info.reflection_vector());
-                return color_at(reflected_ray, remaining - 1) * mat_reflective;
+                render_counters::this_thread().reflected_rays += 1;
+                ray_tree_trace::scope const trace_ray(traced_ray_kind::TRACED_RAY_REFLECTED, reflected_ray);
+
+                auto const reflect_color = color_at(reflected_ray, remaining - 1) * mat_reflective;
+                ray_tree_trace::note_color(reflect_color);
+
+                return reflect_color;
         }
 
         /// --------------------------------------------------------------------
@@ -287,7 +318,13 @@ namespace raytracer
                 /// refracted-ray originates at a point just-under the point of
                 /// intersection...
                 auto refracted_ray = ray_t(xs_info.under_position(), rr_direction);
-                return color_at(refracted_ray, remaining - 1) * mat_transparency;
+                render_counters::this_thread().refracted_rays += 1;
+                ray_tree_trace::scope const trace_ray(traced_ray_kind::TRACED_RAY_REFRACTED, refracted_ray);
+
+                auto const refract_color = color_at(refracted_ray, remaining - 1) * mat_transparency;
+                ray_tree_trace::note_color(refract_color);
+
+                return refract_color;
         }
 
         /*
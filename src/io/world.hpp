@@ -48,8 +48,10 @@ namespace raytracer
                 std::vector<point_light>& modify_lights();
 
                 /// ------------------------------------------------------------
-                /// shape operations
-                void add(std::shared_ptr<shape_interface const> const);
+                /// shape operations. world-space transforms of shapes are
+                /// frozen when they are added, see
+                /// 'shape_interface::freeze_world_transforms()'
+                void add(std::shared_ptr<shape_interface> const);
 
             public:
                 std::vector<point_light> const& lights() const;
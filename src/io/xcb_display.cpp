@@ -4,13 +4,25 @@
 
 #include "io/xcb_display.hpp"
 
+/// system includes
+#if defined(RT_HAVE_XCB_SHM)
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <xcb/shm.h>
+#endif
+
 /// c++ includes
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <memory>
 #include <stddef.h>
+#include <thread>
 #include <xcb/xproto.h>
 
 /// our inclues
 #include "common/include/assert_utils.h"
+#include "common/include/logging.h"
 
 namespace raytracer
 {
@@ -24,34 +36,38 @@ namespace raytracer
         }
 
         /// --------------------------------------------------------------------
-        /// destroy a xcb_display instance
+        /// destroy a xcb_display instance. pixels plotted since the last
+        /// refresh are painted before going away.
         xcb_display::~xcb_display()
         {
+                done_ = true;
+                refresher_.join();
+
+                refresh(false);
+
+#if defined(RT_HAVE_XCB_SHM)
+                if (front_buffer_ != nullptr) {
+                        xcb_shm_detach(connection_, shm_seg_);
+                        shmdt(front_buffer_);
+                }
+#endif
+
+                xcb_free_gc(connection_, gc_);
                 xcb_disconnect(connection_);
         }
 
         /// --------------------------------------------------------------------
-        /// plot a pixel
+        /// plot a pixel. the dirty flag is only written when it isn't set
+        /// already, to keep the cache line holding it shared between the
+        /// rendering threads.
         void xcb_display::plot_pixel(uint32_t x, uint32_t y, uint32_t color)
         {
-                xcb_gcontext_t const fg_graphics_ctxt = xcb_generate_id(connection_);
-                uint32_t const prop_names             = (XCB_GC_FOREGROUND | XCB_GC_GRAPHICS_EXPOSURES);
-                uint32_t const prop_values[2]         = {color, 0};
-
-                xcb_create_gc(connection_, fg_graphics_ctxt, win_id_, prop_names, prop_values);
-
-                /// ------------------------------------------------------------
-                /// plot, and show it
-                xcb_point_t tmp_pt = {
-                        .x = static_cast<int16_t>(x),
-                        .y = static_cast<int16_t>(y),
-                };
+                back_buffer_[x + y * win_x_dim_].store(color, std::memory_order_relaxed);
 
-                xcb_poly_point(connection_, XCB_COORD_MODE_ORIGIN, win_id_, fg_graphics_ctxt,
-                               1,        /// number-of-points
-                               &tmp_pt); /// point-itself
-
-                xcb_flush(connection_);
+                auto& dirty = dirty_tiles_[(x / TILE_SIZE) + (y / TILE_SIZE) * tiles_x_];
+                if (!dirty.load(std::memory_order_relaxed)) {
+                        dirty.store(true, std::memory_order_release);
+                }
         }
 
         /// --------------------------------------------------------------------
@@ -66,7 +82,23 @@ namespace raytracer
             , connection_(init_xcb_connection())
             , screen_(init_x11_screen())
             , win_id_(create_window())
+            , gc_(xcb_generate_id(connection_))
+            , tiles_x_((x_dim + TILE_SIZE - 1) / TILE_SIZE)
+            , tiles_y_((y_dim + TILE_SIZE - 1) / TILE_SIZE)
+            , back_buffer_(new std::atomic<uint32_t>[x_dim * y_dim]())
+            , dirty_tiles_(new std::atomic<bool>[tiles_x_ * tiles_y_]())
         {
+                uint32_t const prop_names     = XCB_GC_GRAPHICS_EXPOSURES;
+                uint32_t const prop_values[1] = {0};
+
+                xcb_create_gc(connection_, gc_, win_id_, prop_names, prop_values);
+
+                if (!init_shm()) {
+                        LOG_INFO("MIT-SHM not available, sending images over the x11 connection");
+                        tile_pixels_.resize(TILE_SIZE * TILE_SIZE);
+                }
+
+                refresher_ = std::thread(&xcb_display::refresh_loop, this);
         }
 
         /// --------------------------------------------------------------------
@@ -140,4 +172,158 @@ namespace raytracer
                 return win_id;
         }
 
+        /// --------------------------------------------------------------------
+        /// create a shared memory segment for the front buffer, and attach
+        /// the x server to it
+        bool xcb_display::init_shm()
+        {
+#if defined(RT_HAVE_XCB_SHM)
+                auto* version = xcb_shm_query_version_reply(connection_, xcb_shm_query_version(connection_),
+                                                            nullptr);
+                if (version == nullptr) {
+                        return false;
+                }
+
+                free(version);
+
+                int const shm_id = shmget(IPC_PRIVATE, win_x_dim_ * win_y_dim_ * sizeof(uint32_t),
+                                          IPC_CREAT | 0600);
+                if (shm_id == -1) {
+                        return false;
+                }
+
+                void* shm_addr = shmat(shm_id, nullptr, 0);
+                if (shm_addr == reinterpret_cast<void*>(-1)) {
+                        shmctl(shm_id, IPC_RMID, nullptr);
+                        return false;
+                }
+
+                shm_seg_ = xcb_generate_id(connection_);
+                auto* error = xcb_request_check(connection_,
+                                                xcb_shm_attach_checked(connection_, shm_seg_, shm_id, 0));
+
+                /// ------------------------------------------------------------
+                /// the segment goes away once both of us have detached from it
+                shmctl(shm_id, IPC_RMID, nullptr);
+
+                if (error != nullptr) {
+                        free(error);
+                        shmdt(shm_addr);
+                        return false;
+                }
+
+                front_buffer_ = static_cast<uint32_t*>(shm_addr);
+                return true;
+#else
+                return false;
+#endif
+        }
+
+        /// --------------------------------------------------------------------
+        /// the display thread
+        void xcb_display::refresh_loop()
+        {
+                while (!done_) {
+                        std::this_thread::sleep_for(REFRESH_INTERVAL);
+
+                        /// ----------------------------------------------------
+                        /// exposed windows (f.e. after being uncovered) need
+                        /// to be painted in full
+                        bool exposed = false;
+
+                        while (auto* event = xcb_poll_for_event(connection_)) {
+                                if ((event->response_type & ~0x80) == XCB_EXPOSE) {
+                                        exposed = true;
+                                }
+
+                                free(event);
+                        }
+
+                        refresh(exposed);
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// paint all dirty tiles (or everything)
+        void xcb_display::refresh(bool everything)
+        {
+                bool painted = false;
+
+                for (uint32_t ty = 0; ty < tiles_y_; ty++) {
+                        for (uint32_t tx = 0; tx < tiles_x_; tx++) {
+                                /// --------------------------------------------
+                                /// flag is cleared before the tile is copied,
+                                /// so pixels plotted during the copy are never
+                                /// lost, they just get painted again next time
+                                auto& dirty          = dirty_tiles_[tx + ty * tiles_x_];
+                                auto const was_dirty = dirty.exchange(false, std::memory_order_acquire);
+
+                                if (was_dirty || everything) {
+                                        paint_tile(tx, ty);
+                                        painted = true;
+                                }
+                        }
+                }
+
+                if (!painted) {
+                        return;
+                }
+
+                xcb_flush(connection_);
+
+                /// ------------------------------------------------------------
+                /// with MIT-SHM, the x server reads from the front buffer
+                /// asynchronously. wait for it to be done before the front
+                /// buffer is updated again.
+                if (front_buffer_ != nullptr) {
+                        auto const cookie = xcb_get_input_focus(connection_);
+                        free(xcb_get_input_focus_reply(connection_, cookie, nullptr));
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// copy a tile from the back buffer, and have the x server paint it
+        void xcb_display::paint_tile(uint32_t tile_x, uint32_t tile_y)
+        {
+                uint32_t const x_begin = tile_x * TILE_SIZE;
+                uint32_t const y_begin = tile_y * TILE_SIZE;
+                uint32_t const width   = std::min(TILE_SIZE, win_x_dim_ - x_begin);
+                uint32_t const height  = std::min(TILE_SIZE, win_y_dim_ - y_begin);
+
+                /// ------------------------------------------------------------
+                /// shared front buffer has the same layout as the back buffer,
+                /// while tiles sent over the connection are packed
+                uint32_t* dst        = (front_buffer_ != nullptr) ? front_buffer_ : tile_pixels_.data();
+                size_t const dst_row = (front_buffer_ != nullptr) ? win_x_dim_ : width;
+                size_t const dst_pos = (front_buffer_ != nullptr) ? x_begin + y_begin * win_x_dim_ : 0;
+
+                for (uint32_t y = 0; y < height; y++) {
+                        auto const* src = &back_buffer_[x_begin + (y_begin + y) * win_x_dim_];
+
+                        for (uint32_t x = 0; x < width; x++) {
+                                dst[dst_pos + y * dst_row + x] = src[x].load(std::memory_order_relaxed);
+                        }
+                }
+
+#if defined(RT_HAVE_XCB_SHM)
+                if (front_buffer_ != nullptr) {
+                        xcb_shm_put_image(connection_, win_id_, gc_,
+                                          win_x_dim_, win_y_dim_, /// total-size
+                                          x_begin, y_begin,       /// src-x, src-y
+                                          width, height,          /// src-size
+                                          x_begin, y_begin,       /// dst-x, dst-y
+                                          screen_->root_depth,    /// depth
+                                          XCB_IMAGE_FORMAT_Z_PIXMAP,
+                                          0,        /// send-event
+                                          shm_seg_, /// segment
+                                          0);       /// offset
+                        return;
+                }
+#endif
+
+                xcb_put_image(connection_, XCB_IMAGE_FORMAT_Z_PIXMAP, win_id_, gc_, width, height, x_begin,
+                              y_begin, 0, screen_->root_depth, width * height * sizeof(uint32_t),
+                              reinterpret_cast<uint8_t const*>(tile_pixels_.data()));
+        }
+
 } // namespace raytracer
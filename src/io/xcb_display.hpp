@@ -5,8 +5,12 @@
  **/
 
 /// c++ includes
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <stdint.h>
+#include <thread>
+#include <vector>
 #include <xcb/xcb.h>
 #include <xcb/xproto.h>
 
@@ -17,8 +21,14 @@ namespace raytracer
          * use raw x11/xcb primitives for online rendering of images. this is
          * 'completely raw' i.e. use x11/xcb directly.
          *
-         * hopefully should offer better performance when used from multiple
-         * threads for 'online' rendering of images.
+         * rendering threads never talk to the x server. plotting a pixel only
+         * updates a (back) buffer, and marks the tile containing the pixel as
+         * dirty. a single display thread periodically copies the dirty tiles
+         * to a (front) buffer, which is shared with the x server via the
+         * MIT-SHM extension, and has the server paint them.
+         *
+         * when MIT-SHM is not available (f.e. remote displays, or when built
+         * without it) dirty tiles are sent over the connection instead.
          *
          * for more information about xcb/x11 see
          *   https://xcb.freedesktop.org/
@@ -38,6 +48,13 @@ namespace raytracer
                  **/
                 static constexpr uint32_t win_border_width_ = 5;
 
+                /*
+                 * dirty tracking is done for tiles of this size (in pixels),
+                 * and dirty tiles are painted at this interval
+                 **/
+                static constexpr uint32_t TILE_SIZE = 32;
+                static constexpr std::chrono::milliseconds REFRESH_INTERVAL{33};
+
                 /*
                  * xcb primitives
                  **/
@@ -57,6 +74,34 @@ namespace raytracer
                  **/
                 xcb_window_t win_id_ = {};
 
+                /*
+                 * graphics context used for all painting
+                 **/
+                xcb_gcontext_t gc_ = {};
+
+                /*
+                 * pixels plotted by rendering threads, and the dirty flag of
+                 * each tile
+                 **/
+                uint32_t tiles_x_ = 0;
+                uint32_t tiles_y_ = 0;
+                std::unique_ptr<std::atomic<uint32_t>[]> back_buffer_;
+                std::unique_ptr<std::atomic<bool>[]> dirty_tiles_;
+
+                /*
+                 * pixels shared with the x server (when MIT-SHM is in use),
+                 * otherwise a tile worth of pixels sent to it
+                 **/
+                uint32_t* front_buffer_ = nullptr;
+                uint32_t shm_seg_       = 0;
+                std::vector<uint32_t> tile_pixels_;
+
+                /*
+                 * the display thread
+                 **/
+                std::atomic<bool> done_{false};
+                std::thread refresher_;
+
             public:
                 /// ------------------------------------------------------------
                 /// create an instance of xcb-display
@@ -67,7 +112,9 @@ namespace raytracer
                 ~xcb_display();
 
                 /*
-                 * plot a point || pixel
+                 * plot a point || pixel. this is cheap, and safe to be called
+                 * concurrently from multiple threads. the pixel shows up on
+                 * the next refresh.
                  **/
                 void plot_pixel(uint32_t x, uint32_t y, uint32_t c);
 
@@ -91,6 +138,20 @@ namespace raytracer
                  * create a window
                  **/
                 xcb_window_t create_window() const;
+
+                /*
+                 * share the front buffer with the x server. returns 'false'
+                 * when MIT-SHM cannot be used.
+                 **/
+                bool init_shm();
+
+                /*
+                 * the display thread: paint dirty tiles at a fixed rate, and
+                 * everything when the window is exposed.
+                 **/
+                void refresh_loop();
+                void refresh(bool everything);
+                void paint_tile(uint32_t tile_x, uint32_t tile_y);
         };
 
 } // namespace raytracer
@@ -34,31 +34,27 @@ namespace raytracer
         /// return the color at a specific point on the pattern
         color cube_texture::color_at_point(tuple const& pt) const
         {
-                switch (face_from_point(pt)) {
-                case CUBE_FACE_LEFT:
-                        return pattern_left_face_->uv_pattern_color_at(uv_map_left(pt));
-
-                case CUBE_FACE_FRONT:
-                        return pattern_front_face_->uv_pattern_color_at(uv_map_front(pt));
-
-                case CUBE_FACE_RIGHT:
-                        return pattern_right_face_->uv_pattern_color_at(uv_map_right(pt));
-
-                case CUBE_FACE_BACK:
-                        return pattern_back_face_->uv_pattern_color_at(uv_map_back(pt));
-
-                case CUBE_FACE_UP:
-                        return pattern_up_face_->uv_pattern_color_at(uv_map_up(pt));
+                auto const face = face_from_point(pt);
+                return face_pattern(face).uv_pattern_color_at(face_uv_map(face, pt));
+        }
 
-                case CUBE_FACE_DOWN:
-                        return pattern_down_face_->uv_pattern_color_at(uv_map_down(pt));
+        /// ------------------------------------------------------------
+        /// return the filtered color at a specific point on the pattern
+        color cube_texture::filtered_color_at_point(tuple const& pt, double footprint) const
+        {
+                auto const face = face_from_point(pt);
+                auto const uv   = face_uv_map(face, pt);
 
-                default:
-                        break;
-                };
+                return face_pattern(face).uv_pattern_filtered_color_at(uv, footprint / 2.0);
+        }
 
-                ASSERT_FAIL("invalid face");
-                return color_black(); /// not-reached
+        /// ------------------------------------------------------------
+        /// filtering is worthwhile when any of the faces can filter
+        bool cube_texture::uses_footprint() const
+        {
+                return pattern_left_face_->uses_footprint() || pattern_front_face_->uses_footprint() ||
+                       pattern_right_face_->uses_footprint() || pattern_back_face_->uses_footprint() ||
+                       pattern_up_face_->uses_footprint() || pattern_down_face_->uses_footprint();
         }
 
         /*
@@ -97,6 +93,68 @@ namespace raytracer
                 return CUBE_FACE_BACK;
         }
 
+        /// --------------------------------------------------------------------
+        /// texture of a specific face
+        uv_pattern_interface const& cube_texture::face_pattern(cube_face face) const
+        {
+                switch (face) {
+                case CUBE_FACE_LEFT:
+                        return *pattern_left_face_;
+
+                case CUBE_FACE_FRONT:
+                        return *pattern_front_face_;
+
+                case CUBE_FACE_RIGHT:
+                        return *pattern_right_face_;
+
+                case CUBE_FACE_BACK:
+                        return *pattern_back_face_;
+
+                case CUBE_FACE_UP:
+                        return *pattern_up_face_;
+
+                case CUBE_FACE_DOWN:
+                        return *pattern_down_face_;
+
+                default:
+                        break;
+                };
+
+                ASSERT_FAIL("invalid face");
+                return *pattern_front_face_; /// not-reached
+        }
+
+        /// --------------------------------------------------------------------
+        /// map a point on a specific face to the corresponding uv point
+        uv_point cube_texture::face_uv_map(cube_face face, tuple const& pt) const
+        {
+                switch (face) {
+                case CUBE_FACE_LEFT:
+                        return uv_map_left(pt);
+
+                case CUBE_FACE_FRONT:
+                        return uv_map_front(pt);
+
+                case CUBE_FACE_RIGHT:
+                        return uv_map_right(pt);
+
+                case CUBE_FACE_BACK:
+                        return uv_map_back(pt);
+
+                case CUBE_FACE_UP:
+                        return uv_map_up(pt);
+
+                case CUBE_FACE_DOWN:
+                        return uv_map_down(pt);
+
+                default:
+                        break;
+                };
+
+                ASSERT_FAIL("invalid face");
+                return uv_point(0.0, 0.0); /// not-reached
+        }
+
         /// --------------------------------------------------------------------
         /// map a point on the cube to a corresponding uv-point.
 
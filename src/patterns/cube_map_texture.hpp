@@ -143,11 +143,24 @@ namespace raytracer
                 /// return the color at a specific point on the pattern
                 color color_at_point(tuple const& pt) const override;
 
+                /// ------------------------------------------------------------
+                /// return the filtered color at a specific point on the
+                /// pattern. faces span 2 units, so the uv-footprint is half of
+                /// 'footprint'.
+                color filtered_color_at_point(tuple const& pt, double footprint) const override;
+
+                bool uses_footprint() const override;
+
             private:
                 /// --------------------------------------------------------------------
                 /// this function is called to find the face upon which the point lies
                 cube_face face_from_point(tuple const&) const;
 
+                /// --------------------------------------------------------------------
+                /// texture of a face, and the uv point of 'pt' on that face
+                uv_pattern_interface const& face_pattern(cube_face) const;
+                uv_point face_uv_map(cube_face, tuple const&) const;
+
                 /// --------------------------------------------------------------------
                 /// map a point on the cube to a corresponding uv point. one
                 /// function for each face
@@ -11,6 +11,7 @@
 /// our includes
 #include "patterns/pattern_interface.hpp"
 #include "patterns/solid_pattern.hpp"
+#include "primitives/intersection_info.hpp"
 #include "primitives/tuple.hpp"
 
 namespace raytracer
@@ -76,6 +77,11 @@ namespace raytracer
                 return this->pattern_->color_at_shape(a_shape, pt);
         }
 
+        color material::get_color(intersection_info_t const& xs_info) const
+        {
+                return this->pattern_->color_at_hit(xs_info);
+        }
+
         std::shared_ptr<pattern_interface> material::get_pattern() const
         {
                 return this->pattern_;
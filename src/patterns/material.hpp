@@ -12,6 +12,7 @@ namespace raytracer
 {
         /// --------------------------------------------------------------------
         /// forward declarations
+        class intersection_info_t;
         class pattern_interface;
         class shape_interface;
         class tuple;
@@ -55,6 +56,7 @@ namespace raytracer
 
             public:
                 color get_color(std::shared_ptr<shape_interface const>, tuple const&) const;
+                color get_color(intersection_info_t const&) const;
                 std::shared_ptr<pattern_interface> get_pattern() const;
 
                 /// getters
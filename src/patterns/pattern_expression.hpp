@@ -0,0 +1,450 @@
+#pragma once
+
+/*
+ * this file implements pattern expressions i.e. patterns that are composed at
+ * compile time, rather than at runtime.
+ *
+ * a pattern (see 'patterns/binary_pattern.hpp') holds its sub-patterns through
+ * a 'std::shared_ptr<pattern_interface>'. so, each level of a nested pattern
+ * costs a virtual call, and the transform of the sub-pattern, whether it has
+ * one or not.
+ *
+ * a pattern expression instead holds its sub-expressions by value, and the
+ * type of the whole expression spells out how it is composed. so, the whole
+ * expression is inlined into a single function, and only the sub-expressions
+ * that have a transform are transformed. transforms of directly nested
+ * expressions are combined into one, and the transform at the top of an
+ * expression becomes the transform of the pattern that it creates.
+ *
+ * a pattern is created from an expression with 'create_pattern(...)', which
+ * plugs into 'material::set_pattern(...)' like any other pattern f.e.
+ *
+ *     auto stripes = create_transformed_expr(create_striped_expr(c_01, c_02), M);
+ *     auto floor   = create_blended_expr(stripes, create_striped_expr(c_03, c_04));
+ *
+ *     material().set_pattern(create_pattern(floor));
+ *
+ * colors, and (shared pointers to) patterns, can be used wherever an
+ * expression is expected. the latter are evaluated as they always are.
+ **/
+
+/// c++ includes
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// our includes
+#include "patterns/pattern_interface.hpp"
+#include "patterns/perlin_noise.hpp"
+#include "primitives/color.hpp"
+#include "primitives/matrix.hpp"
+#include "primitives/tuple.hpp"
+#include "utils/utils.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// color is a constant throughout
+        class solid_expr final
+        {
+            private:
+                color c_;
+
+            public:
+                solid_expr(color c)
+                    : c_(c)
+                {
+                }
+
+                color operator()(tuple const&) const
+                {
+                        return c_;
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// color of a (runtime) pattern, in its own pattern-space
+        class shared_pattern_expr final
+        {
+            private:
+                std::shared_ptr<pattern_interface const> pattern_;
+
+            public:
+                template <class P>
+                shared_pattern_expr(std::shared_ptr<P> pattern)
+                    : pattern_(std::move(pattern))
+                {
+                }
+
+                color operator()(tuple const& pt) const
+                {
+                        return pattern_->color_at_point(pattern_->inv_transform() * pt);
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// type of the expression that 'E' stands for
+        template <class E>
+        struct pattern_expr_of {
+                using type = E;
+        };
+
+        template <>
+        struct pattern_expr_of<color> {
+                using type = solid_expr;
+        };
+
+        template <class P>
+        struct pattern_expr_of<std::shared_ptr<P>> {
+                using type = shared_pattern_expr;
+        };
+
+        template <class E>
+        using pattern_expr_of_t = typename pattern_expr_of<std::decay_t<E>>::type;
+
+        /// --------------------------------------------------------------------
+        /// expression 'E', in a pattern-space of its own
+        template <class E>
+        class transformed_expr final
+        {
+            private:
+                E expr_;
+                fsize_dense2d_matrix_t xform_;
+                fsize_dense2d_matrix_t inv_xform_;
+
+            public:
+                transformed_expr(E expr, fsize_dense2d_matrix_t const& M)
+                    : expr_(std::move(expr))
+                    , xform_(M)
+                    , inv_xform_(inverse(M))
+                {
+                }
+
+                color operator()(tuple const& pt) const
+                {
+                        return expr_(inv_xform_ * pt);
+                }
+
+                E const& expr() const
+                {
+                        return expr_;
+                }
+
+                fsize_dense2d_matrix_t const& transform() const
+                {
+                        return xform_;
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// expressions made up of two sub-expressions, the counterpart of
+        /// 'binary_pattern'
+        template <class A, class B>
+        class binary_expr
+        {
+            private:
+                A a_;
+                B b_;
+
+            public:
+                binary_expr(A a, B b)
+                    : a_(std::move(a))
+                    , b_(std::move(b))
+                {
+                }
+
+            protected:
+                color color_a(tuple const& pt) const
+                {
+                        return a_(pt);
+                }
+
+                color color_b(tuple const& pt) const
+                {
+                        return b_(pt);
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// alternating stripes, see 'striped_pattern'
+        template <class A, class B>
+        class striped_expr final : public binary_expr<A, B>
+        {
+            public:
+                using binary_expr<A, B>::binary_expr;
+
+                color operator()(tuple const& pt) const
+                {
+                        if (fast_floor(pt.x()) % 2 == 0) {
+                                return this->color_a(pt);
+                        }
+
+                        return this->color_b(pt);
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// chessboard, see 'checkers_pattern'
+        template <class A, class B>
+        class checkers_expr final : public binary_expr<A, B>
+        {
+            public:
+                using binary_expr<A, B>::binary_expr;
+
+                color operator()(tuple const& pt) const
+                {
+                        auto const pt_x_floor   = fast_floor(pt.x());
+                        auto const pt_y_floor   = fast_floor(pt.y());
+                        auto const pt_z_floor   = fast_floor(pt.z());
+                        auto const pt_xyz_floor = pt_x_floor + pt_y_floor + pt_z_floor;
+
+                        if ((pt_xyz_floor % 2) == 0) {
+                                return this->color_a(pt);
+                        }
+
+                        return this->color_b(pt);
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// smooth change along x, see 'gradient_pattern'
+        template <class A, class B>
+        class gradient_expr final : public binary_expr<A, B>
+        {
+            public:
+                using binary_expr<A, B>::binary_expr;
+
+                color operator()(tuple const& pt) const
+                {
+                        auto const fraction    = pt.x() - fast_floor(pt.x());
+                        auto const color_a_val = this->color_a(pt);
+                        auto const color_b_val = this->color_b(pt);
+
+                        return color_a_val + (color_b_val - color_a_val) * fraction;
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// alternating rings, see 'ring_pattern'
+        template <class A, class B>
+        class ring_expr final : public binary_expr<A, B>
+        {
+            public:
+                using binary_expr<A, B>::binary_expr;
+
+                color operator()(tuple const& pt) const
+                {
+                        auto const magnitude = std::sqrt(pt.x() * pt.x() + pt.z() * pt.z());
+
+                        if (fast_floor(magnitude) % 2 == 0) {
+                                return this->color_a(pt);
+                        }
+
+                        return this->color_b(pt);
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// smooth change along a ring, see 'gradient_ring_pattern'
+        template <class A, class B>
+        class gradient_ring_expr final : public binary_expr<A, B>
+        {
+            public:
+                using binary_expr<A, B>::binary_expr;
+
+                color operator()(tuple const& pt) const
+                {
+                        auto const magnitude   = std::sqrt(pt.x() * pt.x() + pt.z() * pt.z());
+                        auto const color_a_val = this->color_a(pt);
+                        auto const color_b_val = this->color_b(pt);
+
+                        return color_a_val + (color_b_val - color_a_val) * magnitude;
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// half the sum of both, see 'blended_pattern'
+        template <class A, class B>
+        class blended_expr final : public binary_expr<A, B>
+        {
+            public:
+                using binary_expr<A, B>::binary_expr;
+
+                color operator()(tuple const& pt) const
+                {
+                        return (this->color_a(pt) + this->color_b(pt)) * 0.5;
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// noise-perturbed change from one to the other, see
+        /// 'gradient_perlin_noise_pattern'
+        template <class A, class B>
+        class gradient_perlin_noise_expr final : public binary_expr<A, B>
+        {
+            private:
+                perlin_noise pn_;
+                uint8_t octaves_;
+
+            public:
+                gradient_perlin_noise_expr(A a, B b, uint32_t seed, uint8_t octaves)
+                    : binary_expr<A, B>(std::move(a), std::move(b))
+                    , pn_(seed)
+                    , octaves_(octaves)
+                {
+                }
+
+                color operator()(tuple const& pt) const
+                {
+                        double const noise = pn_.octave_noise_3d_clamped_01(pt.x(), pt.y(), pt.z(), octaves_);
+
+                        return this->color_a(pt) * (1.0 - noise) + this->color_b(pt) * noise;
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// noise-perturbed expression, see 'perlin_noise_pattern'
+        template <class E>
+        class perlin_noise_expr final
+        {
+            private:
+                E expr_;
+                perlin_noise pn_;
+                uint8_t octaves_;
+
+            public:
+                perlin_noise_expr(E expr, uint32_t seed, uint8_t octaves)
+                    : expr_(std::move(expr))
+                    , pn_(seed)
+                    , octaves_(octaves)
+                {
+                }
+
+                color operator()(tuple const& pt) const
+                {
+                        double const noise = pn_.octave_noise_3d_clamped_01(pt.x(), pt.y(), pt.z(), octaves_);
+
+                        return expr_(pt) * (1.0 - noise);
+                }
+        };
+
+        /*
+         * functions to compose expressions
+         **/
+
+        /// --------------------------------------------------------------------
+        /// 'expr' transformed by 'M'. transforming a transformed expression
+        /// combines both transforms into one.
+        template <class E>
+        transformed_expr<pattern_expr_of_t<E>> create_transformed_expr(E expr,
+                                                                       fsize_dense2d_matrix_t const& M)
+        {
+                return transformed_expr<pattern_expr_of_t<E>>(std::move(expr), M);
+        }
+
+        template <class E>
+        transformed_expr<E> create_transformed_expr(transformed_expr<E> const& expr,
+                                                    fsize_dense2d_matrix_t const& M)
+        {
+                return transformed_expr<E>(expr.expr(), M * expr.transform());
+        }
+
+        template <class A, class B>
+        striped_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>> create_striped_expr(A a, B b)
+        {
+                return {std::move(a), std::move(b)};
+        }
+
+        template <class A, class B>
+        checkers_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>> create_checkers_expr(A a, B b)
+        {
+                return {std::move(a), std::move(b)};
+        }
+
+        template <class A, class B>
+        gradient_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>> create_gradient_expr(A a, B b)
+        {
+                return {std::move(a), std::move(b)};
+        }
+
+        template <class A, class B>
+        ring_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>> create_ring_expr(A a, B b)
+        {
+                return {std::move(a), std::move(b)};
+        }
+
+        template <class A, class B>
+        gradient_ring_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>> create_gradient_ring_expr(A a, B b)
+        {
+                return {std::move(a), std::move(b)};
+        }
+
+        template <class A, class B>
+        blended_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>> create_blended_expr(A a, B b)
+        {
+                return {std::move(a), std::move(b)};
+        }
+
+        template <class A, class B>
+        gradient_perlin_noise_expr<pattern_expr_of_t<A>, pattern_expr_of_t<B>>
+        create_gradient_perlin_noise_expr(A a, B b,
+                                          uint32_t seed   = 0,  /// gradient-lattice
+                                          uint8_t octaves = 16) /// perlin-noise
+        {
+                return {std::move(a), std::move(b), seed, octaves};
+        }
+
+        template <class E>
+        perlin_noise_expr<pattern_expr_of_t<E>>
+        create_perlin_noise_expr(E expr,
+                                 uint32_t seed   = 0,  /// perlin-noise-seed
+                                 uint8_t octaves = 16) /// octaves
+        {
+                return {std::move(expr), seed, octaves};
+        }
+
+        /*
+         * pattern made out of an expression
+         **/
+        template <class E>
+        class pattern_expression final : public pattern_interface
+        {
+            private:
+                E const expr_;
+
+            public:
+                explicit pattern_expression(E expr)
+                    : expr_(std::move(expr))
+                {
+                }
+
+            public:
+                /// ------------------------------------------------------------
+                /// return the color at a specific point on the shape.
+                color color_at_point(tuple const& pt) const override
+                {
+                        return expr_(pt);
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// create a pattern out of 'expr'. the transform at the top of it, if
+        /// any, is the transform of the pattern.
+        template <class E>
+        std::shared_ptr<pattern_interface> create_pattern(E expr)
+        {
+                return std::make_shared<pattern_expression<pattern_expr_of_t<E>>>(std::move(expr));
+        }
+
+        template <class E>
+        std::shared_ptr<pattern_interface> create_pattern(transformed_expr<E> const& expr)
+        {
+                auto the_pattern = std::make_shared<pattern_expression<E>>(expr.expr());
+                the_pattern->transform(expr.transform());
+
+                return the_pattern;
+        }
+
+} // namespace raytracer
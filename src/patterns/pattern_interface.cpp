@@ -1,6 +1,12 @@
 #include "patterns/pattern_interface.hpp"
 
+/// c++ includes
+#include <algorithm>
+
 /// our includes
+#include "patterns/texture_footprint.hpp"
+#include "primitives/intersection_info.hpp"
+#include "primitives/tuple.hpp"
 #include "shapes/shape_interface.hpp"
 
 namespace raytracer
@@ -49,6 +55,59 @@ namespace raytracer
         {
                 auto const object_pt = shape->world_to_local(where);
                 auto pattern_pt      = inv_transform() * object_pt;
+
+                auto const width = texture_footprint::width();
+                if ((width > 0.0) && uses_footprint()) {
+                        return filtered_color_at_point(pattern_pt,
+                                                       pattern_footprint(shape, where, pattern_pt, width));
+                }
+
                 return color_at_point(pattern_pt);
         }
+
+        /// --------------------------------------------------------------------
+        /// return the pattern-color at the over-position of a hit
+        color pattern_interface::color_at_hit(intersection_info_t const& hit) const
+        {
+                auto const pattern_pt = inv_xform_ * hit.object_over_position();
+
+                auto const width = texture_footprint::width();
+                if ((width > 0.0) && uses_footprint()) {
+                        auto const footprint =
+                                pattern_footprint(hit.what_object(), hit.over_position(), pattern_pt, width);
+
+                        return filtered_color_at_hit_point(hit, pattern_pt, footprint);
+                }
+
+                return color_at_hit_point(hit, pattern_pt);
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// the footprint is transformed into pattern-space by moving 'where'
+        /// by 'width' along each of the axes, and taking the largest resulting
+        /// distance. this accounts for (possibly non-uniform) scaling by both
+        /// shape and pattern transforms.
+        double pattern_interface::pattern_footprint(std::shared_ptr<shape_interface const> const& shape,
+                                                    tuple const& where, tuple const& pattern_pt,
+                                                    double width) const
+        {
+                tuple const offsets[] = {
+                        create_vector(width, 0.0, 0.0),
+                        create_vector(0.0, width, 0.0),
+                        create_vector(0.0, 0.0, width),
+                };
+
+                double footprint = 0.0;
+
+                for (auto const& offset : offsets) {
+                        auto const moved_pt = inv_transform() * shape->world_to_local(where + offset);
+                        footprint           = std::max(footprint, magnitude(moved_pt - pattern_pt));
+                }
+
+                return footprint;
+        }
 } // namespace raytracer
@@ -11,6 +11,7 @@ namespace raytracer
 {
         /// --------------------------------------------------------------------
         /// forward declarations
+        class intersection_info_t;
         class shape_interface;
         class tuple;
 
@@ -43,11 +44,35 @@ namespace raytracer
                 /// return the pattern-color at a specific point on the shape
                 virtual color color_at_point(tuple const&) const = 0;
 
+                /// ------------------------------------------------------------
+                /// return the pattern-color at a specific point on the shape,
+                /// filtered over 'footprint' i.e. the (pattern-space) width of
+                /// the ray at that point.
+                ///
+                /// only patterns which can filter (f.e. image textures) need
+                /// to override this, and 'uses_footprint()'
+                virtual color filtered_color_at_point(tuple const& pt, double /* footprint */) const
+                {
+                        return color_at_point(pt);
+                }
+
+                virtual bool uses_footprint() const
+                {
+                        return false;
+                }
+
             public:
                 /// ------------------------------------------------------------
                 /// return the pattern-color at a specific point on a shape
                 color color_at_shape(std::shared_ptr<shape_interface const>, tuple const&) const;
 
+                /// ------------------------------------------------------------
+                /// return the pattern-color at the over-position of a hit. the
+                /// object-space point (and uv-coordinates) are those that the
+                /// hit carries, so they are computed once per hit rather than
+                /// once per light.
+                virtual color color_at_hit(intersection_info_t const& hit) const;
+
                 /// ------------------------------------------------------------
                 /// return the transform matrix for the pattern
                 fsize_dense2d_matrix_t transform() const;
@@ -55,5 +80,28 @@ namespace raytracer
                 /// ------------------------------------------------------------
                 /// return the inverse-transform matrix for the pattern
                 fsize_dense2d_matrix_t inv_transform() const;
+
+            protected:
+                /// ------------------------------------------------------------
+                /// return the (filtered) pattern-color at 'pattern_pt' of a
+                /// hit. patterns that can reuse what the hit carries (f.e.
+                /// uv-coordinates) override these.
+                virtual color color_at_hit_point(intersection_info_t const&, tuple const& pattern_pt) const
+                {
+                        return color_at_point(pattern_pt);
+                }
+
+                virtual color filtered_color_at_hit_point(intersection_info_t const&, tuple const& pattern_pt,
+                                                          double footprint) const
+                {
+                        return filtered_color_at_point(pattern_pt, footprint);
+                }
+
+            private:
+                /// ------------------------------------------------------------
+                /// pattern-space footprint of a ray of (world-space) 'width',
+                /// hitting 'shape' at 'where'
+                double pattern_footprint(std::shared_ptr<shape_interface const> const& shape,
+                                         tuple const& where, tuple const& pattern_pt, double width) const;
         };
 } // namespace raytracer
@@ -32,6 +32,14 @@ namespace raytracer
                 {
                         return this->c_;
                 }
+
+                /// ------------------------------------------------------------
+                /// the color is the same everywhere, so there is no point in
+                /// looking up where the hit is
+                color color_at_hit(intersection_info_t const&) const override
+                {
+                        return this->c_;
+                }
         };
 
 } // namespace raytracer
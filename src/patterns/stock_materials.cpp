@@ -8,7 +8,6 @@
 #include <limits>
 #include <memory>
 #include <random>
-#include <time.h>
 #include <utility>
 
 /// our includes
@@ -56,9 +55,9 @@ namespace raytracer
         /// --------------------------------------------------------------------
         /// create a canvas (of specific size) of a noisy texture
         canvas generate_noisy_texture(size_t canvas_xpixels, size_t canvas_ypixels, color const& start_color,
-                                      color const& end_color)
+                                      color const& end_color, uint32_t seed)
         {
-                std::mt19937 rnd_gen(time(nullptr));
+                std::mt19937 rnd_gen(seed);
                 std::uniform_int_distribution<unsigned> distrib(std::numeric_limits<unsigned>::min(),
                                                                 std::numeric_limits<unsigned>::max());
 
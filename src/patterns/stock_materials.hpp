@@ -1,6 +1,7 @@
 #pragma once
 
 /// c++ includes
+#include <cstdint>
 #include <stddef.h>
 
 /// our includes
@@ -29,9 +30,11 @@ namespace raytracer
         material create_material_matte(color const&);
 
         /// --------------------------------------------------------------------
-        /// generate a noisy texture of a specific size.
+        /// generate a noisy texture of a specific size. the same 'seed' always
+        /// generates the same texture.
         canvas generate_noisy_texture(size_t canvas_xpixels,    /// x-dim
                                       size_t canvas_ypixels,    /// y-dim
                                       color const& start_color, /// start-color
-                                      color const& end_color);  /// end-color
+                                      color const& end_color,   /// end-color
+                                      uint32_t seed = 0);       /// noise
 } // namespace raytracer
@@ -0,0 +1,195 @@
+/// c++ includes
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "patterns/blended_pattern.hpp"
+#include "patterns/checkers_pattern.hpp"
+#include "patterns/gradient_pattern.hpp"
+#include "patterns/gradient_perlin_noise_pattern.hpp"
+#include "patterns/gradient_ring_pattern.hpp"
+#include "patterns/material.hpp"
+#include "patterns/pattern_expression.hpp"
+#include "patterns/pattern_interface.hpp"
+#include "patterns/perlin_noise_pattern.hpp"
+#include "patterns/ring_pattern.hpp"
+#include "patterns/solid_pattern.hpp"
+#include "patterns/striped_pattern.hpp"
+#include "primitives/color.hpp"
+#include "primitives/matrix.hpp"
+#include "primitives/matrix_transformations.hpp"
+#include "primitives/tuple.hpp"
+#include "shapes/sphere.hpp"
+#include "utils/constants.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// convenience
+namespace RT   = raytracer;
+using RT_XFORM = RT::matrix_transformations_t;
+
+/// ----------------------------------------------------------------------------
+/// points, in and around the unit cube, at which patterns are compared
+static std::vector<RT::tuple> sample_points()
+{
+        std::vector<RT::tuple> points;
+
+        for (auto x = -2.25; x < 2.5; x += 0.5) {
+                for (auto y = -1.1; y < 1.5; y += 0.7) {
+                        for (auto z = -2.4; z < 2.5; z += 0.6) {
+                                points.push_back(RT::create_point(x, y, z));
+                        }
+                }
+        }
+
+        return points;
+}
+
+/// ----------------------------------------------------------------------------
+/// an expression has the same colors as the pattern it stands for
+TEST_CASE("pattern_expression::color_at_point(...) test")
+{
+        auto const c_01 = RT::color(0.9, 0.9, 0.9);
+        auto const c_02 = RT::color(0.8, 0.2, 0.1);
+        auto const c_03 = RT::color(0.1, 0.3, 0.7);
+        auto const c_04 = RT::color(0.0, 0.6, 0.2);
+
+        struct {
+                std::shared_ptr<RT::pattern_interface> pattern;
+                std::shared_ptr<RT::pattern_interface> expression;
+        } const tc_list[] = {
+                {std::make_shared<RT::striped_pattern>(c_01, c_02),
+                 RT::create_pattern(RT::create_striped_expr(c_01, c_02))},
+                {std::make_shared<RT::checkers_pattern>(c_01, c_02),
+                 RT::create_pattern(RT::create_checkers_expr(c_01, c_02))},
+                {std::make_shared<RT::gradient_pattern>(c_01, c_02),
+                 RT::create_pattern(RT::create_gradient_expr(c_01, c_02))},
+                {std::make_shared<RT::ring_pattern>(c_01, c_02),
+                 RT::create_pattern(RT::create_ring_expr(c_01, c_02))},
+                {std::make_shared<RT::gradient_ring_pattern>(c_01, c_02),
+                 RT::create_pattern(RT::create_gradient_ring_expr(c_01, c_02))},
+                {std::make_shared<RT::blended_pattern>(c_01, c_02),
+                 RT::create_pattern(RT::create_blended_expr(c_01, c_02))},
+                {std::make_shared<RT::gradient_perlin_noise_pattern>(c_01, c_02, 7, 4),
+                 RT::create_pattern(RT::create_gradient_perlin_noise_expr(c_01, c_02, 7, 4))},
+                {std::make_shared<RT::perlin_noise_pattern>(c_03, 5, 8),
+                 RT::create_pattern(RT::create_perlin_noise_expr(c_03, 5, 8))},
+
+                /// ------------------------------------------------------------
+                /// nested, without transforms
+                {std::make_shared<RT::checkers_pattern>(std::make_shared<RT::gradient_pattern>(c_01, c_02),
+                                                        std::make_shared<RT::ring_pattern>(c_03, c_04)),
+                 RT::create_pattern(RT::create_checkers_expr(RT::create_gradient_expr(c_01, c_02),
+                                                             RT::create_ring_expr(c_03, c_04)))},
+        };
+
+        for (auto const& tc : tc_list) {
+                for (auto const& pt : sample_points()) {
+                        CHECK(tc.expression->color_at_point(pt) == tc.pattern->color_at_point(pt));
+                }
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// nested patterns, with transforms at each level
+TEST_CASE("pattern_expression::color_at_shape(...) test")
+{
+        auto const c_01 = RT::color(0.9, 0.9, 0.9);
+        auto const c_02 = RT::color(0.8, 0.8, 0.8);
+        auto const c_03 = RT::color(0.7, 0.7, 0.7);
+
+        auto const xform_01 = RT_XFORM::create_roty_matrix(RT::PI_BY_2F) *
+                              RT_XFORM::create_3d_scaling_matrix(0.5, 0.5, 5.5);
+        auto const xform_02 = RT_XFORM::create_3d_translation_matrix(0.25, 0.0, -0.5);
+        auto const xform_03 = RT_XFORM::create_roty_matrix(-RT::PI_BY_2F) *
+                              RT_XFORM::create_3d_scaling_matrix(0.6, 1.0, 1.0);
+
+        /// --------------------------------------------------------------------
+        /// as patterns
+        auto fp_01 = std::make_shared<RT::striped_pattern>(c_01, c_02);
+        fp_01->transform(xform_01);
+
+        auto fp_02 = std::make_shared<RT::striped_pattern>(c_02, c_03);
+        auto fp_03 = std::make_shared<RT::perlin_noise_pattern>(fp_02, 3, 4);
+        fp_03->transform(xform_02);
+
+        auto pattern_01 = std::make_shared<RT::blended_pattern>(fp_01, fp_03);
+        pattern_01->transform(xform_03);
+
+        /// --------------------------------------------------------------------
+        /// as an expression
+        auto const fe_01 = RT::create_transformed_expr(RT::create_striped_expr(c_01, c_02), xform_01);
+        auto const fe_03 = RT::create_transformed_expr(
+                RT::create_perlin_noise_expr(RT::create_striped_expr(c_02, c_03), 3, 4), xform_02);
+
+        auto const fe_04      = RT::create_transformed_expr(RT::create_blended_expr(fe_01, fe_03), xform_03);
+        auto const pattern_02 = RT::create_pattern(fe_04);
+
+        /// --------------------------------------------------------------------
+        /// the transform at the top is the one of the pattern
+        CHECK(pattern_02->transform() == xform_03);
+
+        auto s_01 = std::make_shared<RT::sphere>();
+        s_01->transform(RT_XFORM::create_3d_scaling_matrix(2.0, 2.0, 2.0));
+
+        for (auto const& pt : sample_points()) {
+                CHECK(pattern_02->color_at_shape(s_01, pt) == pattern_01->color_at_shape(s_01, pt));
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// directly nested transforms are combined into one
+TEST_CASE("create_transformed_expr(...) test")
+{
+        auto const xform_01 = RT_XFORM::create_3d_scaling_matrix(0.5, 2.0, 0.5);
+        auto const xform_02 = RT_XFORM::create_3d_translation_matrix(1.0, 0.0, 0.5);
+
+        auto const expr_01 = RT::create_striped_expr(RT::color_white(), RT::color_black());
+        auto const expr_02 = RT::create_transformed_expr(expr_01, xform_01);
+        auto const expr_03 = RT::create_transformed_expr(expr_02, xform_02);
+
+        /// --------------------------------------------------------------------
+        /// a transformed stripe, and not a transformed transformed one
+        using stripe_expr = RT::striped_expr<RT::solid_expr, RT::solid_expr>;
+        static_assert(std::is_same_v<decltype(expr_03), RT::transformed_expr<stripe_expr> const>);
+
+        CHECK(expr_03.transform() == xform_02 * xform_01);
+
+        auto const pattern_01 = RT::create_pattern(expr_03);
+        CHECK(pattern_01->transform() == xform_02 * xform_01);
+
+        for (auto const& pt : sample_points()) {
+                auto const exp_color = expr_01(RT::inverse(xform_01) * (RT::inverse(xform_02) * pt));
+                CHECK(expr_03(pt) == exp_color);
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// patterns in an expression are evaluated in their own pattern-space
+TEST_CASE("shared_pattern_expr(...) test")
+{
+        auto stripes = std::make_shared<RT::striped_pattern>(RT::color_white(), RT::color_black());
+        stripes->transform(RT_XFORM::create_3d_scaling_matrix(0.25, 1.0, 1.0));
+
+        auto const blue       = std::make_shared<RT::solid_pattern>(RT::color_blue());
+        auto const pattern_01 = std::make_shared<RT::checkers_pattern>(stripes, blue);
+        auto const pattern_02 = RT::create_pattern(RT::create_checkers_expr(stripes, RT::color_blue()));
+
+        for (auto const& pt : sample_points()) {
+                CHECK(pattern_02->color_at_point(pt) == pattern_01->color_at_point(pt));
+        }
+
+        /// --------------------------------------------------------------------
+        /// and an expression plugs into a material
+        auto const m_01 = RT::material().set_pattern(pattern_02);
+        auto s_01       = std::make_shared<RT::sphere>();
+
+        CHECK(m_01.get_color(s_01, RT::create_point(0.3, 0.0, 0.0)) ==
+              pattern_01->color_at_point(RT::create_point(0.3, 0.0, 0.0)));
+}
@@ -13,10 +13,16 @@
 #include "patterns/ring_pattern.hpp"
 #include "patterns/solid_pattern.hpp"
 #include "patterns/striped_pattern.hpp"
+#include "patterns/texture_2d_pattern.hpp"
+#include "patterns/uv_checkers.hpp"
 #include "primitives/color.hpp"
+#include "primitives/intersection_info.hpp"
+#include "primitives/intersection_record.hpp"
 #include "primitives/matrix.hpp"
 #include "primitives/matrix_transformations.hpp"
+#include "primitives/ray.hpp"
 #include "primitives/tuple.hpp"
+#include "primitives/uv_point.hpp"
 #include "shapes/sphere.hpp"
 #include "utils/constants.hpp"
 
@@ -231,3 +237,60 @@ TEST_CASE("checkers_pattern::color_at_point(...) test")
         auto got_zcolor_03 = cp->color_at_point(RT::create_point(0.0, 0.0, 1.01));
         CHECK(got_zcolor_03 == RT::color_black());
 }
+
+/// ----------------------------------------------------------------------------
+/// color of a pattern at a hit is its color at the over-point of the hit
+TEST_CASE("pattern::color_at_hit(...) test")
+{
+        auto s_01 = std::make_shared<RT::sphere>();
+        s_01->transform(RT_XFORM::create_3d_scaling_matrix(2.0, 2.0, 2.0));
+
+        auto pattern_01 = std::make_shared<test_pattern>();
+        pattern_01->transform(RT_XFORM::create_3d_translation_matrix(0.5, 1.0, 1.5));
+
+        auto const m_01 = RT::material().set_pattern(pattern_01);
+        s_01->set_material(m_01);
+
+        auto const r_01    = RT::ray_t(RT::create_point(0.5, 0.5, -5.0), RT::create_vector(0.0, 0.0, 1.0));
+        auto const xs_list = r_01.intersect(s_01);
+        CHECK(xs_list.has_value());
+
+        auto const xs_info = r_01.prepare_computations(xs_list.value());
+        auto const exp_col = pattern_01->color_at_shape(s_01, xs_info.over_position());
+
+        CHECK(pattern_01->color_at_hit(xs_info) == exp_col);
+        CHECK(m_01.get_color(xs_info) == exp_col);
+}
+
+/// ----------------------------------------------------------------------------
+/// a hit is mapped to uv-coordinates once per texture
+TEST_CASE("texture_2d_pattern::color_at_hit(...) test")
+{
+        auto num_mapped = 0;
+        auto uv_mapper  = [&num_mapped](RT::tuple const&) {
+                num_mapped++;
+                return RT::uv_point(0.25, 0.75);
+        };
+
+        auto checkers   = std::make_shared<RT::uv_checkers>(2, RT::color_black(), 2, RT::color_white());
+        auto texture_01 = std::make_shared<RT::texture_2d_pattern>(checkers, uv_mapper);
+        auto texture_02 = std::make_shared<RT::texture_2d_pattern>(checkers, uv_mapper);
+
+        auto s_01 = std::make_shared<RT::sphere>();
+        s_01->set_material(RT::material().set_pattern(texture_01));
+
+        auto const r_01    = RT::ray_t(RT::create_point(0.0, 0.0, -5.0), RT::create_vector(0.0, 0.0, 1.0));
+        auto const xs_list = r_01.intersect(s_01);
+        CHECK(xs_list.has_value());
+
+        auto const xs_info = r_01.prepare_computations(xs_list.value());
+        auto const exp_col = texture_01->color_at_point(RT::create_point(0.0, 0.0, 0.0));
+
+        num_mapped = 0;
+        CHECK(texture_01->color_at_hit(xs_info) == exp_col);
+        CHECK(texture_01->color_at_hit(xs_info) == exp_col);
+        CHECK(num_mapped == 1);
+
+        CHECK(texture_02->color_at_hit(xs_info) == exp_col);
+        CHECK(num_mapped == 2);
+}
@@ -0,0 +1,243 @@
+/// c++ includes
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/// 3rd-party includes
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+#include "patterns/texture_image.hpp"
+#include "patterns/uv_image_pattern.hpp"
+#include "platform_utils/mmapped_file_reader.hpp"
+#include "primitives/color.hpp"
+#include "primitives/uv_point.hpp"
+
+log_level_t GLOBAL_LOG_LEVEL_NOW = LOG_LEVEL_FATAL;
+
+/// a convenience alias
+namespace RT = raytracer;
+
+/// ----------------------------------------------------------------------------
+/// a small canvas with a few interesting colors
+static RT::canvas create_test_canvas()
+{
+        auto c = RT::canvas::create_binary(4, 2);
+
+        c.write_pixel(0, 0, RT::color::RGB(0, 0, 0));
+        c.write_pixel(1, 0, RT::color::RGB(255, 255, 255));
+        c.write_pixel(2, 0, RT::color::RGB(12, 128, 250));
+        c.write_pixel(3, 0, RT::color(0.1, 0.2, 0.3));
+        c.write_pixel(0, 1, RT::color(0.5, 0.25, 0.125));
+
+        return c;
+}
+
+/// ----------------------------------------------------------------------------
+/// texels in all formats
+TEST_CASE("texture_image::texel(...)")
+{
+        auto const c = create_test_canvas();
+
+        struct {
+                RT::texel_format fmt;
+                size_t texel_size;
+                float max_error;
+        } const tc_list[] = {
+                {RT::TEXEL_FORMAT_RGB8, 3, 0.51f / 255.0f},
+                {RT::TEXEL_FORMAT_RGBA8, 4, 0.51f / 255.0f},
+                {RT::TEXEL_FORMAT_RGB16F, 6, 1.0f / 2048.0f},
+                {RT::TEXEL_FORMAT_RGB32F, 12, 0.0f},
+        };
+
+        for (auto const& tc : tc_list) {
+                RT::texture_image const tex(c, tc.fmt);
+
+                CHECK(tex.width() == c.width());
+                CHECK(tex.height() == c.height());
+                CHECK(tex.format() == tc.fmt);
+                CHECK(tex.texel_memory_size() == c.width() * c.height() * tc.texel_size);
+
+                for (size_t y = 0; y < c.height(); y++) {
+                        for (size_t x = 0; x < c.width(); x++) {
+                                auto const expected = c.read_pixel(x, y);
+                                auto const got      = tex.texel(x, y);
+
+                                CHECK(std::abs(got.R() - expected.R()) <= tc.max_error);
+                                CHECK(std::abs(got.G() - expected.G()) <= tc.max_error);
+                                CHECK(std::abs(got.B() - expected.B()) <= tc.max_error);
+                        }
+                }
+
+                /// 8-bit colors are stored exactly, except as half-floats
+                if (tc.fmt != RT::TEXEL_FORMAT_RGB16F) {
+                        CHECK(tex.texel(2, 0) == RT::color::RGB(12, 128, 250));
+                }
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// textures loaded from the same file are shared
+TEST_CASE("texture_image::load(...)")
+{
+        std::string_view ppm_data = R"""(P3
+2 1
+255
+255 0 0  0 0 255
+)""";
+
+        std::string ppm_fname = platform_utils::fill_file_with_data(ppm_data);
+
+        auto tex_01 = RT::texture_image::load(ppm_fname);
+        auto tex_02 = RT::texture_image::load(ppm_fname);
+        auto tex_03 = RT::texture_image::load(ppm_fname, RT::TEXEL_FORMAT_RGB16F);
+
+        unlink(ppm_fname.c_str());
+
+        CHECK(tex_01 != nullptr);
+        CHECK(tex_01 == tex_02);
+        CHECK(tex_01 != tex_03);
+
+        if (tex_01 != nullptr) {
+                CHECK(tex_01->texel(0, 0) == RT::color(1.0, 0.0, 0.0));
+                CHECK(tex_01->texel(1, 0) == RT::color(0.0, 0.0, 1.0));
+
+                /// uv_image samples the shared texture
+                RT::uv_image const img_01(tex_01);
+                CHECK(img_01.uv_pattern_color_at(RT::uv_point(0.0, 0.0)) == RT::color(1.0, 0.0, 0.0));
+                CHECK(img_01.uv_pattern_color_at(RT::uv_point(1.0, 1.0)) == RT::color(0.0, 0.0, 1.0));
+        }
+}
+
+/// ----------------------------------------------------------------------------
+/// threads loading the same texture at the same time share a single instance
+TEST_CASE("texture_image::load(...) concurrently")
+{
+        auto c = RT::canvas::create_binary(256, 256);
+        for (size_t y = 0; y < c.height(); y++) {
+                for (size_t x = 0; x < c.width(); x++) {
+                        c.write_pixel(x, y, RT::color::RGB(x, y, (x + y) % 256));
+                }
+        }
+
+        auto const ppm_fname = std::string("/tmp/rt-test-texture-concurrent-load.ppm");
+        c.write(ppm_fname);
+
+        constexpr size_t num_threads = 8;
+        std::vector<std::shared_ptr<RT::texture_image const>> textures(num_threads);
+        std::vector<std::thread> workers;
+
+        for (size_t i = 0; i < num_threads; i++) {
+                workers.emplace_back([&textures, &ppm_fname, i]() {
+                        textures[i] = RT::texture_image::load(ppm_fname);
+                });
+        }
+
+        for (auto& w : workers) {
+                w.join();
+        }
+
+        CHECK(textures[0] != nullptr);
+        for (auto const& t : textures) {
+                CHECK(t == textures[0]);
+        }
+
+        unlink(ppm_fname.c_str());
+}
+
+/// ----------------------------------------------------------------------------
+/// mip chain is built by halving, and averaging texels
+TEST_CASE("texture_image mip chain")
+{
+        auto c = RT::canvas::create_binary(4, 2);
+
+        for (size_t x = 0; x < 4; x++) {
+                c.write_pixel(x, 0, RT::color(1.0, 0.0, 0.0));
+                c.write_pixel(x, 1, RT::color(0.0, 0.0, 1.0));
+        }
+
+        RT::texture_image const tex(c, RT::TEXEL_FORMAT_RGB32F);
+
+        /// 4x2 -> 2x1 -> 1x1
+        CHECK(tex.num_levels() == 3);
+        CHECK(tex.level_width(1) == 2);
+        CHECK(tex.level_height(1) == 1);
+        CHECK(tex.level_width(2) == 1);
+        CHECK(tex.level_height(2) == 1);
+        CHECK(tex.mip_memory_size() == (8 + 2 + 1) * 12);
+
+        CHECK(tex.texel(1, 0, 0) == RT::color(0.5, 0.0, 0.5));
+        CHECK(tex.texel(2, 0, 0) == RT::color(0.5, 0.0, 0.5));
+}
+
+/// ----------------------------------------------------------------------------
+/// bilinear, and trilinear sampling
+TEST_CASE("texture_image::sample(...)")
+{
+        auto c = RT::canvas::create_binary(2, 2);
+
+        c.write_pixel(0, 0, RT::color(0.0, 0.0, 0.0));
+        c.write_pixel(1, 0, RT::color(1.0, 0.0, 0.0));
+        c.write_pixel(0, 1, RT::color(0.0, 1.0, 0.0));
+        c.write_pixel(1, 1, RT::color(1.0, 1.0, 0.0));
+
+        RT::texture_image const tex(c, RT::TEXEL_FORMAT_RGB32F);
+
+        /// texel centers, and the point in between them
+        CHECK(tex.sample_bilinear(0.25, 0.25, 0) == RT::color(0.0, 0.0, 0.0));
+        CHECK(tex.sample_bilinear(0.75, 0.75, 0) == RT::color(1.0, 1.0, 0.0));
+        CHECK(tex.sample_bilinear(0.5, 0.25, 0) == RT::color(0.5, 0.0, 0.0));
+        CHECK(tex.sample_bilinear(0.5, 0.5, 0) == RT::color(0.5, 0.5, 0.0));
+
+        /// edges are clamped
+        CHECK(tex.sample_bilinear(0.0, 0.0, 0) == RT::color(0.0, 0.0, 0.0));
+        CHECK(tex.sample_bilinear(1.0, 0.0, 0) == RT::color(1.0, 0.0, 0.0));
+
+        /// small footprints sample full resolution, and large ones the
+        /// coarsest level, with blending in between
+        CHECK(tex.sample(0.25, 0.25, 0.0) == RT::color(0.0, 0.0, 0.0));
+        CHECK(tex.sample(0.25, 0.25, 0.25) == RT::color(0.0, 0.0, 0.0));
+        CHECK(tex.sample(0.25, 0.25, 1.0) == RT::color(0.5, 0.5, 0.0));
+        CHECK(tex.sample(0.25, 0.25, 100.0) == RT::color(0.5, 0.5, 0.0));
+        CHECK(tex.sample(0.25, 0.25, 0.75) == RT::color(0.5 * std::log2(1.5), 0.5 * std::log2(1.5), 0.0));
+
+        /// uv_image samples filtered colors with 'v' flipped
+        RT::uv_image const img(c);
+        CHECK(img.uses_footprint());
+        CHECK(img.uv_pattern_filtered_color_at(RT::uv_point(0.25, 0.75), 0.0) == RT::color(0.0, 0.0, 0.0));
+        CHECK(img.uv_pattern_filtered_color_at(RT::uv_point(0.25, 0.75), 1.0) == RT::color(0.5, 0.5, 0.0));
+}
+
+/// ----------------------------------------------------------------------------
+/// texels are stored in tiles, which must be transparent for sizes which are
+/// not a multiple of the tile size as well
+TEST_CASE("texture_image tiled texels")
+{
+        size_t const sizes[][2] = {{1, 1}, {8, 8}, {13, 10}, {17, 3}, {3, 29}};
+
+        for (auto const& [width, height] : sizes) {
+                auto c = RT::canvas::create_binary(width, height);
+
+                for (size_t y = 0; y < height; y++) {
+                        for (size_t x = 0; x < width; x++) {
+                                c.write_pixel(x, y, RT::color::RGB(x, y, (x * 7 + y * 13) & 0xff));
+                        }
+                }
+
+                RT::texture_image const tex(c, RT::TEXEL_FORMAT_RGB8);
+                CHECK(tex.texel_memory_size() == width * height * 3);
+
+                for (size_t y = 0; y < height; y++) {
+                        for (size_t x = 0; x < width; x++) {
+                                CHECK(tex.texel(x, y) == c.read_pixel(x, y));
+                        }
+                }
+        }
+}
@@ -1,12 +1,16 @@
 #pragma once
 
 /// c++ includes
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <memory>
 
 /// our includes
 #include "patterns/pattern_interface.hpp"
 #include "patterns/uv_pattern_interface.hpp"
+#include "primitives/intersection_info.hpp"
+#include "primitives/tuple.hpp"
 
 namespace raytracer
 {
@@ -43,6 +47,71 @@ namespace raytracer
                         auto const uv_pt = uv_mapper_(pt);
                         return pattern_->uv_pattern_color_at(uv_pt);
                 }
+
+                /// ------------------------------------------------------------
+                /// return the filtered color at a specific point on the
+                /// pattern.
+                ///
+                /// the uv-footprint is estimated by mapping points which are
+                /// 'footprint' away from 'pt' along each axis, and taking the
+                /// largest change in either 'u' or 'v'. since uv-maps wrap
+                /// around, a change of more than half is really the other way
+                /// round.
+                color filtered_color_at_point(tuple const& pt, double footprint) const override
+                {
+                        return filtered_color_at_uv(pt, uv_mapper_(pt), footprint);
+                }
+
+                bool uses_footprint() const override
+                {
+                        return pattern_->uses_footprint();
+                }
+
+            protected:
+                /// ------------------------------------------------------------
+                /// a hit is mapped to uv-coordinates just once, no matter how
+                /// many lights illuminate it
+                color color_at_hit_point(intersection_info_t const& hit, tuple const& pt) const override
+                {
+                        auto const uv_pt = hit.uv(this, [&]() { return uv_mapper_(pt); });
+                        return pattern_->uv_pattern_color_at(uv_pt);
+                }
+
+                color filtered_color_at_hit_point(intersection_info_t const& hit, tuple const& pt,
+                                                  double footprint) const override
+                {
+                        auto const uv_pt = hit.uv(this, [&]() { return uv_mapper_(pt); });
+                        return filtered_color_at_uv(pt, uv_pt, footprint);
+                }
+
+            private:
+                /// ------------------------------------------------------------
+                /// color at 'uv_pt' i.e. the uv-coordinates of 'pt', filtered
+                /// over the uv-footprint of 'footprint'
+                color filtered_color_at_uv(tuple const& pt, uv_point const& uv_pt, double footprint) const
+                {
+                        tuple const offsets[] = {
+                                create_vector(footprint, 0.0, 0.0),
+                                create_vector(0.0, footprint, 0.0),
+                                create_vector(0.0, 0.0, footprint),
+                        };
+
+                        auto const wrapped_delta = [](double a, double b) {
+                                auto const d = std::fabs(a - b);
+                                return std::min(d, 1.0 - d);
+                        };
+
+                        double uv_footprint = 0.0;
+
+                        for (auto const& offset : offsets) {
+                                auto const moved_uv = uv_mapper_(pt + offset);
+
+                                uv_footprint = std::max(uv_footprint, wrapped_delta(moved_uv.u(), uv_pt.u()));
+                                uv_footprint = std::max(uv_footprint, wrapped_delta(moved_uv.v(), uv_pt.v()));
+                        }
+
+                        return pattern_->uv_pattern_filtered_color_at(uv_pt, uv_footprint);
+                }
         };
 
 } // namespace raytracer
\ No newline at end of file
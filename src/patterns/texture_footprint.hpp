@@ -0,0 +1,76 @@
+#pragma once
+
+/*
+ * this file implements tracking of the (world-space) footprint of the ray that
+ * is being shaded. textures use it to pick a mip level to sample from.
+ *
+ * a ray is treated as a cone whose width grows with the distance it travels,
+ * the rate of that growth being the 'pixel spread' i.e. the angle subtended by
+ * a single pixel. camera sets the pixel spread for each rendering thread, and
+ * the world updates the width at each hit. secondary (reflected / refracted)
+ * rays start out with the width at the hit they originate from.
+ *
+ * state is per-thread, so that concurrently rendering threads don't interfere
+ * with each other. when no pixel spread is set (f.e. in tests) the footprint
+ * is always 0, and textures are sampled without any filtering.
+ **/
+
+namespace raytracer
+{
+        class texture_footprint final
+        {
+            private:
+                static inline thread_local double pixel_spread_ = 0.0;
+                static inline thread_local double ray_width_     = 0.0;
+
+            public:
+                /// ------------------------------------------------------------
+                /// set the pixel spread for the current thread. this resets
+                /// the width of the current ray as well.
+                static void pixel_spread(double spread)
+                {
+                        pixel_spread_ = spread;
+                        ray_width_    = 0.0;
+                }
+
+                static double pixel_spread()
+                {
+                        return pixel_spread_;
+                }
+
+                /// ------------------------------------------------------------
+                /// world-space width of the ray at the hit being shaded
+                static double width()
+                {
+                        return ray_width_;
+                }
+
+            public:
+                /*
+                 * this is used for the duration of shading a hit at 'distance'
+                 * along the current ray. it widens the ray accordingly, and
+                 * restores the previous width once the hit has been shaded.
+                 **/
+                class hit_scope final
+                {
+                    private:
+                        double const saved_width_;
+
+                    public:
+                        explicit hit_scope(double distance)
+                            : saved_width_(ray_width_)
+                        {
+                                ray_width_ += pixel_spread_ * distance;
+                        }
+
+                        ~hit_scope()
+                        {
+                                ray_width_ = saved_width_;
+                        }
+
+                        hit_scope(hit_scope const&)            = delete;
+                        hit_scope& operator=(hit_scope const&) = delete;
+                };
+        };
+
+} // namespace raytracer
@@ -0,0 +1,479 @@
+/*
+ * implement compact image textures
+ **/
+
+#include "patterns/texture_image.hpp"
+
+/// c++ includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+/// our includes
+#include "common/include/logging.h"
+#include "io/canvas.hpp"
+#include "primitives/color.hpp"
+#include "utils/utils.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// convert a float into an ieee-754 half-float (round-to-nearest-even)
+        static uint16_t float_to_half(float f)
+        {
+                uint32_t bits;
+                memcpy(&bits, &f, sizeof(bits));
+
+                uint32_t const sign = (bits >> 16) & 0x8000;
+                int32_t const exp   = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+                uint32_t mant       = bits & 0x007fffff;
+
+                /// inf / nan
+                if (((bits >> 23) & 0xff) == 0xff) {
+                        return sign | 0x7c00 | (mant ? 0x200 : 0);
+                }
+
+                /// overflow
+                if (exp >= 31) {
+                        return sign | 0x7c00;
+                }
+
+                /// subnormal || zero
+                if (exp <= 0) {
+                        if (exp < -10) {
+                                return sign;
+                        }
+
+                        mant |= 0x00800000;
+
+                        uint32_t const shift = 14 - exp;
+                        uint32_t half_mant   = mant >> shift;
+                        uint32_t const rem   = mant & ((1u << shift) - 1);
+                        uint32_t const mid   = 1u << (shift - 1);
+
+                        if ((rem > mid) || ((rem == mid) && (half_mant & 1))) {
+                                half_mant += 1;
+                        }
+
+                        return sign | half_mant;
+                }
+
+                uint32_t half      = sign | (exp << 10) | (mant >> 13);
+                uint32_t const rem = mant & 0x1fff;
+                if ((rem > 0x1000) || ((rem == 0x1000) && (half & 1))) {
+                        half += 1; /// may carry into the exponent, which is fine
+                }
+
+                return static_cast<uint16_t>(half);
+        }
+
+        /// --------------------------------------------------------------------
+        /// convert an ieee-754 half-float into a float
+        static float half_to_float(uint16_t h)
+        {
+                uint32_t const sign = (h & 0x8000) << 16;
+                uint32_t exp        = (h >> 10) & 0x1f;
+                uint32_t mant       = h & 0x03ff;
+                uint32_t bits       = 0;
+
+                if (exp == 0x1f) {
+                        bits = sign | 0x7f800000 | (mant << 13);
+                } else if (exp != 0) {
+                        bits = sign | ((exp - 15 + 127) << 23) | (mant << 13);
+                } else if (mant != 0) {
+                        /// subnormal: normalize it
+                        exp = 127 - 15 + 1;
+                        while ((mant & 0x0400) == 0) {
+                                mant <<= 1;
+                                exp -= 1;
+                        }
+
+                        bits = sign | (exp << 23) | ((mant & 0x03ff) << 13);
+                } else {
+                        bits = sign;
+                }
+
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+
+                return f;
+        }
+
+        /// --------------------------------------------------------------------
+        /// quantize a [0.0 .. 1.0] value to 8 bits
+        static uint8_t float_to_u8(float f)
+        {
+                return static_cast<uint8_t>(std::round(clamp_in_range(f, 0.0f, 1.0f) * 255.0f));
+        }
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the texel format
+        std::string stringify_texel_format(texel_format fmt)
+        {
+                switch (fmt) {
+                case TEXEL_FORMAT_RGB8:
+                        return "TEXEL_FORMAT_RGB8";
+
+                case TEXEL_FORMAT_RGBA8:
+                        return "TEXEL_FORMAT_RGBA8";
+
+                case TEXEL_FORMAT_RGB16F:
+                        return "TEXEL_FORMAT_RGB16F";
+
+                case TEXEL_FORMAT_RGB32F:
+                        return "TEXEL_FORMAT_RGB32F";
+                }
+
+                return "TEXEL_FORMAT_INVALID";
+        }
+
+        /// --------------------------------------------------------------------
+        /// size (in bytes) of a single texel
+        size_t texel_format_size(texel_format fmt)
+        {
+                switch (fmt) {
+                case TEXEL_FORMAT_RGB8:
+                        return 3;
+
+                case TEXEL_FORMAT_RGBA8:
+                        return 4;
+
+                case TEXEL_FORMAT_RGB16F:
+                        return 3 * sizeof(uint16_t);
+
+                case TEXEL_FORMAT_RGB32F:
+                        return 3 * sizeof(float);
+                }
+
+                return 0;
+        }
+
+        /// --------------------------------------------------------------------
+        /// create a texture from a canvas
+        texture_image::texture_image(canvas const& img, texel_format fmt)
+            : width_(img.width())
+            , height_(img.height())
+            , format_(fmt)
+            , levels_(1)
+        {
+                size_t const texel_size = texel_format_size(fmt);
+
+                auto& base  = levels_[0];
+                base.width  = width_;
+                base.height = height_;
+                base.texels.resize(width_ * height_ * texel_size);
+
+                for (size_t y = 0; y < height_; y++) {
+                        for (size_t x = 0; x < width_; x++) {
+                                store_texel(base.texels.data() + texel_index(base, x, y) * texel_size,
+                                            img.read_pixel(x, y));
+                        }
+                }
+
+                build_mip_chain();
+        }
+
+        /// --------------------------------------------------------------------
+        /// load a (shared) texture from a ppm file.
+        ///
+        /// the cache is locked just long enough to either find the texture,
+        /// or to leave a placeholder for it. decoding the file and building
+        /// the mip chain happen outside the lock, so different textures load
+        /// concurrently, while threads after a texture that is being loaded
+        /// wait on its placeholder.
+        std::shared_ptr<texture_image const> texture_image::load(std::string const& fname, texel_format fmt)
+        {
+                using cache_key_t  = std::pair<std::string, texel_format>;
+                using texture_ptr  = std::shared_ptr<texture_image const>;
+                using pending_load = std::shared_future<texture_ptr>;
+
+                struct cache_entry final {
+                        std::weak_ptr<texture_image const> texture;
+                        pending_load loading;
+                };
+
+                static std::mutex cache_lock;
+                static std::map<cache_key_t, cache_entry> cache;
+
+                std::unique_lock<std::mutex> guard(cache_lock);
+                auto& entry = cache[cache_key_t(fname, fmt)];
+
+                if (auto cached = entry.texture.lock(); cached != nullptr) {
+                        LOG_DEBUG("texture '%s' (%s) shared", fname.c_str(),
+                                  stringify_texel_format(fmt).c_str());
+                        return cached;
+                }
+
+                /// ------------------------------------------------------------
+                /// some other thread is loading it
+                if (entry.loading.valid()) {
+                        auto const loading = entry.loading;
+                        guard.unlock();
+
+                        return loading.get();
+                }
+
+                std::promise<texture_ptr> loaded;
+                entry.loading = loaded.get_future().share();
+                guard.unlock();
+
+                /// ------------------------------------------------------------
+                /// load it, without holding the lock
+                texture_ptr texture = nullptr;
+
+                if (auto maybe_canvas = canvas::load_from_file(fname); maybe_canvas.has_value()) {
+                        texture = std::make_shared<texture_image const>(maybe_canvas.value(), fmt);
+                        LOG_INFO("texture '%s' loaded, details: '%s'", fname.c_str(),
+                                 texture->stringify().c_str());
+                } else {
+                        LOG_ERROR("failed to load texture '%s'", fname.c_str());
+                }
+
+                /// ------------------------------------------------------------
+                /// replace the placeholder. failures are not cached, so they
+                /// are retried on the next load.
+                guard.lock();
+                entry.texture = texture;
+                entry.loading = pending_load();
+                guard.unlock();
+
+                loaded.set_value(texture);
+
+                return texture;
+        }
+
+        /// --------------------------------------------------------------------
+        /// memory used by the complete mip chain
+        size_t texture_image::mip_memory_size() const
+        {
+                size_t total = 0;
+
+                for (auto const& l : levels_) {
+                        total += l.texels.size();
+                }
+
+                return total;
+        }
+
+        /// --------------------------------------------------------------------
+        /// color of the texel at (x, y) of a specific level
+        color texture_image::texel(size_t level, size_t x, size_t y) const
+        {
+                auto const& l = levels_[level];
+                return load_texel(l.texels.data() + texel_index(l, x, y) * texel_format_size(format_));
+        }
+
+        /// --------------------------------------------------------------------
+        /// bilinearly filtered color at (s, t) of a specific level. texel
+        /// centers are at half-texel offsets, and coordinates beyond the edges
+        /// are clamped.
+        color texture_image::sample_bilinear(double s, double t, size_t level) const
+        {
+                auto const& l = levels_[level];
+
+                double const x = clamp_in_range(s, 0.0, 1.0) * l.width - 0.5;
+                double const y = clamp_in_range(t, 0.0, 1.0) * l.height - 0.5;
+
+                double const x_floor = std::floor(x);
+                double const y_floor = std::floor(y);
+                double const fx      = x - x_floor;
+                double const fy      = y - y_floor;
+
+                auto const clamp_index = [](double i, size_t n) -> size_t {
+                        return static_cast<size_t>(clamp_in_range(i, 0.0, static_cast<double>(n - 1)));
+                };
+
+                size_t const x0 = clamp_index(x_floor, l.width);
+                size_t const x1 = clamp_index(x_floor + 1.0, l.width);
+                size_t const y0 = clamp_index(y_floor, l.height);
+                size_t const y1 = clamp_index(y_floor + 1.0, l.height);
+
+                auto const top    = texel(level, x0, y0) * (1.0 - fx) + texel(level, x1, y0) * fx;
+                auto const bottom = texel(level, x0, y1) * (1.0 - fx) + texel(level, x1, y1) * fx;
+
+                return top * (1.0 - fy) + bottom * fy;
+        }
+
+        /// --------------------------------------------------------------------
+        /// trilinearly filtered color at (s, t)
+        color texture_image::sample(double s, double t, double footprint) const
+        {
+                /// ------------------------------------------------------------
+                /// level-of-detail: 0 when the footprint is a single texel of
+                /// the full resolution image, 1 when it is 2 texels and so on.
+                double const texels_covered = footprint * std::max(width_, height_);
+                if (!(texels_covered > 1.0)) {
+                        return sample_bilinear(s, t, 0);
+                }
+
+                size_t const last_level = levels_.size() - 1;
+                double const lod        = std::log2(texels_covered);
+                double const lod_floor  = std::floor(lod);
+
+                if (lod_floor >= last_level) {
+                        return sample_bilinear(s, t, last_level);
+                }
+
+                size_t const fine   = static_cast<size_t>(lod_floor);
+                double const weight = lod - lod_floor;
+
+                return (sample_bilinear(s, t, fine) * (1.0 - weight) + /// finer level
+                        sample_bilinear(s, t, fine + 1) * weight);      /// coarser level
+        }
+
+        /// --------------------------------------------------------------------
+        /// meta information about the texture
+        std::string texture_image::stringify() const
+        {
+                std::stringstream ss("");
+
+                // clang-format off
+                ss << "{"
+                   << "width: "  << width_  << ", "
+                   << "height: " << height_ << ", "
+                   << "format: " << stringify_texel_format(format_) << ", "
+                   << "texel-memory (bytes): " << texel_memory_size() << ", "
+                   << "mip-levels: " << num_levels() << ", "
+                   << "mip-memory (bytes): " << mip_memory_size()
+                   << "}";
+                // clang-format on
+
+                return ss.str();
+        }
+
+        /*
+         * only private functions from this point onwards
+         **/
+
+        /// --------------------------------------------------------------------
+        /// index of the texel at (x, y) in a tiled level.
+        ///
+        /// a level is a sequence of rows of tiles, and each row of tiles is a
+        /// sequence of tiles, with texels of a tile being stored row-major.
+        /// tiles along the right and bottom edges are narrower / shorter when
+        /// the size of the level isn't a multiple of the tile size, so there
+        /// is no padding:
+        ///
+        ///     +-------+-------+---+
+        ///     |   0   |   1   | 2 |    tile-row 0: full height tiles
+        ///     +-------+-------+---+
+        ///     |   3   |   4   | 5 |    tile-row 1: shorter tiles
+        ///     +-------+-------+---+
+        size_t texture_image::texel_index(mip_level const& l, size_t x, size_t y)
+        {
+                size_t const tile_x      = x >> TILE_SIZE_LOG2;
+                size_t const tile_y      = y >> TILE_SIZE_LOG2;
+                size_t const tile_width  = std::min(TILE_SIZE, l.width - (tile_x << TILE_SIZE_LOG2));
+                size_t const tile_height = std::min(TILE_SIZE, l.height - (tile_y << TILE_SIZE_LOG2));
+
+                size_t const tile_row_start = (tile_y << TILE_SIZE_LOG2) * l.width;
+                size_t const tile_start     = (tile_x << TILE_SIZE_LOG2) * tile_height;
+
+                return (tile_row_start + tile_start +        /// start of the tile
+                        (y & (TILE_SIZE - 1)) * tile_width + /// row within the tile
+                        (x & (TILE_SIZE - 1)));              /// column within the row
+        }
+
+        /// --------------------------------------------------------------------
+        /// encode a color into a texel
+        void texture_image::store_texel(uint8_t* dst, color const& c) const
+        {
+                switch (format_) {
+                case TEXEL_FORMAT_RGBA8:
+                        dst[3] = 0xff;
+                        [[fallthrough]];
+
+                case TEXEL_FORMAT_RGB8:
+                        dst[0] = float_to_u8(c.R());
+                        dst[1] = float_to_u8(c.G());
+                        dst[2] = float_to_u8(c.B());
+                        break;
+
+                case TEXEL_FORMAT_RGB16F: {
+                        uint16_t const rgb[3] = {float_to_half(c.R()), float_to_half(c.G()),
+                                                 float_to_half(c.B())};
+                        memcpy(dst, rgb, sizeof(rgb));
+                        break;
+                }
+
+                case TEXEL_FORMAT_RGB32F: {
+                        float const rgb[3] = {c.R(), c.G(), c.B()};
+                        memcpy(dst, rgb, sizeof(rgb));
+                        break;
+                }
+                }
+        }
+
+        /// --------------------------------------------------------------------
+        /// decode a texel into a color
+        color texture_image::load_texel(uint8_t const* src) const
+        {
+                switch (format_) {
+                case TEXEL_FORMAT_RGB8:
+                case TEXEL_FORMAT_RGBA8:
+                        return color::RGB(src[0], src[1], src[2]);
+
+                case TEXEL_FORMAT_RGB16F: {
+                        uint16_t rgb[3];
+                        memcpy(rgb, src, sizeof(rgb));
+                        return color(half_to_float(rgb[0]), half_to_float(rgb[1]), half_to_float(rgb[2]));
+                }
+
+                case TEXEL_FORMAT_RGB32F: {
+                        float rgb[3];
+                        memcpy(rgb, src, sizeof(rgb));
+                        return color(rgb[0], rgb[1], rgb[2]);
+                }
+                }
+
+                return color(0.0, 0.0, 0.0);
+        }
+
+        /// --------------------------------------------------------------------
+        /// each level is half the size (rounded down, but at least 1) of the
+        /// previous one, with every texel being the average of the (upto) 2x2
+        /// texels that it covers. the last level is a single texel.
+        void texture_image::build_mip_chain()
+        {
+                size_t const texel_size = texel_format_size(format_);
+
+                while ((levels_.back().width > 1) || (levels_.back().height > 1)) {
+                        mip_level next;
+
+                        auto const& prev = levels_.back();
+                        next.width       = std::max<size_t>(1, prev.width / 2);
+                        next.height      = std::max<size_t>(1, prev.height / 2);
+                        next.texels.resize(next.width * next.height * texel_size);
+
+                        size_t const prev_level = levels_.size() - 1;
+                        auto const prev_texel   = [&](size_t x, size_t y) { return texel(prev_level, x, y); };
+
+                        for (size_t y = 0; y < next.height; y++) {
+                                size_t const y0 = std::min(2 * y, prev.height - 1);
+                                size_t const y1 = std::min(2 * y + 1, prev.height - 1);
+
+                                for (size_t x = 0; x < next.width; x++) {
+                                        size_t const x0 = std::min(2 * x, prev.width - 1);
+                                        size_t const x1 = std::min(2 * x + 1, prev.width - 1);
+
+                                        auto const sum = prev_texel(x0, y0) + prev_texel(x1, y0) +
+                                                         prev_texel(x0, y1) + prev_texel(x1, y1);
+
+                                        auto* dst = next.texels.data() + texel_index(next, x, y) * texel_size;
+                                        store_texel(dst, sum * 0.25);
+                                }
+                        }
+
+                        levels_.push_back(std::move(next));
+                }
+        }
+
+} // namespace raytracer
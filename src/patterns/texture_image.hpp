@@ -0,0 +1,183 @@
+#pragma once
+
+/*
+ * this file implements compact storage for image textures.
+ *
+ * a canvas holds a 'color' per pixel which is way too much for image textures,
+ * which are mostly 8-bit rgb to begin with. a texture_image instead holds its
+ * texels in one of the compact formats below, and converts them to a color
+ * when it is sampled.
+ *
+ * textures loaded from a file are shared i.e. all materials referencing the
+ * same file (and format) refer to the same texels.
+ *
+ * each texture also carries a mip chain i.e. successively halved (box
+ * filtered) copies of the image, down to a single texel. textures covering a
+ * small part of the image are sampled from a coarser level, which both avoids
+ * aliasing, and keeps accesses to the texels cache friendly.
+ *
+ * texels of each level are stored in small square tiles instead of rows, so
+ * that texels which are close by in both 'x' and 'y' (f.e. the 2x2 texels of a
+ * bilinear lookup, or texels along the curves traced by spherical and
+ * cylindrical maps) are close by in memory as well. the layout is private to
+ * this class, texels are only accessed via texel(...) and sample(...).
+ **/
+
+/// c++ includes
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// our includes
+#include "primitives/color.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// forward declarations
+        class canvas;
+
+        /// --------------------------------------------------------------------
+        /// how are texels stored ?
+        enum texel_format {
+                TEXEL_FORMAT_RGB8   = 0, /// 3 bytes / texel
+                TEXEL_FORMAT_RGBA8  = 1, /// 4 bytes / texel (alpha is unused)
+                TEXEL_FORMAT_RGB16F = 2, /// 6 bytes / texel (half-float)
+                TEXEL_FORMAT_RGB32F = 3, /// 12 bytes / texel (lossless)
+        };
+
+        /// --------------------------------------------------------------------
+        /// stringified representation of the texel format
+        std::string stringify_texel_format(texel_format fmt);
+
+        /// --------------------------------------------------------------------
+        /// size (in bytes) of a single texel
+        size_t texel_format_size(texel_format fmt);
+
+        class texture_image final
+        {
+            private:
+                /// ------------------------------------------------------------
+                /// a single level of the mip chain, with level-0 being the
+                /// full resolution image
+                struct mip_level {
+                        size_t width  = 0;
+                        size_t height = 0;
+                        std::vector<uint8_t> texels;
+                };
+
+                size_t width_        = 0;
+                size_t height_       = 0;
+                texel_format format_ = TEXEL_FORMAT_RGB8;
+                std::vector<mip_level> levels_;
+
+                /// ------------------------------------------------------------
+                /// texels are stored in tiles of 8x8 texels
+                static constexpr size_t TILE_SIZE_LOG2 = 3;
+                static constexpr size_t TILE_SIZE      = 1 << TILE_SIZE_LOG2;
+
+            public:
+                /// ------------------------------------------------------------
+                /// create a texture from a canvas, converting all of its
+                /// pixels into 'fmt' texels
+                texture_image(canvas const& img, texel_format fmt);
+
+                /// ------------------------------------------------------------
+                /// load a texture from a ppm file. textures are cached, so
+                /// loading the same file (with the same format) again returns
+                /// the same instance as long as someone holds on to it.
+                ///
+                /// returns nullptr if the file cannot be loaded.
+                static std::shared_ptr<texture_image const> load(std::string const& fname,
+                                                                 texel_format fmt = TEXEL_FORMAT_RGB8);
+
+            public:
+                size_t width() const
+                {
+                        return width_;
+                }
+
+                size_t height() const
+                {
+                        return height_;
+                }
+
+                texel_format format() const
+                {
+                        return format_;
+                }
+
+                size_t num_levels() const
+                {
+                        return levels_.size();
+                }
+
+                size_t level_width(size_t level) const
+                {
+                        return levels_[level].width;
+                }
+
+                size_t level_height(size_t level) const
+                {
+                        return levels_[level].height;
+                }
+
+                /// ------------------------------------------------------------
+                /// memory used by the (full resolution) texels
+                size_t texel_memory_size() const
+                {
+                        return levels_[0].texels.size();
+                }
+
+                /// ------------------------------------------------------------
+                /// memory used by the complete mip chain
+                size_t mip_memory_size() const;
+
+                /// ------------------------------------------------------------
+                /// color of the texel at (x, y) at full resolution, or at a
+                /// specific level of the mip chain
+                color texel(size_t x, size_t y) const
+                {
+                        return texel(0, x, y);
+                }
+
+                color texel(size_t level, size_t x, size_t y) const;
+
+                /// ------------------------------------------------------------
+                /// bilinearly filtered color at (s, t) of a specific level.
+                /// (s, t) are in range [0.0 .. 1.0], with (0.0, 0.0) being
+                /// the top-left corner of the image.
+                color sample_bilinear(double s, double t, size_t level) const;
+
+                /// ------------------------------------------------------------
+                /// trilinearly filtered color at (s, t), where 'footprint' is
+                /// the size of the sampled area as a fraction of the image
+                /// i.e. in the same units as (s, t).
+                ///
+                /// the mip level is chosen such that a texel is about the size
+                /// of the footprint, and the colors of the two nearest levels
+                /// are blended.
+                color sample(double s, double t, double footprint) const;
+
+                /// ------------------------------------------------------------
+                /// meta information about the texture
+                std::string stringify() const;
+
+            private:
+                /// ------------------------------------------------------------
+                /// index of the texel at (x, y) within a level
+                static size_t texel_index(mip_level const& l, size_t x, size_t y);
+
+                /// ------------------------------------------------------------
+                /// encode a color into a texel, and decode it back
+                void store_texel(uint8_t* dst, color const& c) const;
+                color load_texel(uint8_t const* src) const;
+
+                /// ------------------------------------------------------------
+                /// build all levels of the mip chain from level-0
+                void build_mip_chain();
+        };
+
+} // namespace raytracer
@@ -2,9 +2,11 @@
 
 /// c++ includes
 #include <cstdint>
+#include <memory>
 
 /// our includes
 #include "io/canvas.hpp"
+#include "patterns/texture_image.hpp"
 #include "patterns/uv_pattern_interface.hpp"
 #include "utils/utils.hpp"
 
@@ -13,11 +15,21 @@ namespace raytracer
         class uv_image final : public uv_pattern_interface
         {
             private:
-                canvas ppm_img;
+                std::shared_ptr<texture_image const> img_;
 
             public:
-                uv_image(canvas decoded_ppm_image)
-                    : ppm_img(std::move(decoded_ppm_image))
+                /// ------------------------------------------------------------
+                /// the canvas is converted into a (lossless) float texture
+                uv_image(canvas const& decoded_ppm_image)
+                    : img_(std::make_shared<texture_image const>(decoded_ppm_image, TEXEL_FORMAT_RGB32F))
+                {
+                }
+
+                /// ------------------------------------------------------------
+                /// use a (possibly shared) texture f.e. from
+                /// texture_image::load(...)
+                uv_image(std::shared_ptr<texture_image const> img)
+                    : img_(std::move(img))
                 {
                 }
 
@@ -39,10 +51,23 @@ namespace raytracer
                         ///
                         /// this is to avoid overflowing the canvas when 'u' and
                         /// 'v' are both 1.
-                        uint32_t x = std::round(uv.u() * (ppm_img.width() - 1));
-                        uint32_t y = std::round(flipped_v * (ppm_img.height() - 1));
+                        uint32_t x = std::round(uv.u() * (img_->width() - 1));
+                        uint32_t y = std::round(flipped_v * (img_->height() - 1));
+
+                        return img_->texel(x, y);
+                }
+
+                /// ------------------------------------------------------------
+                /// compute the color at a specific point on the pattern,
+                /// filtered over 'uv_footprint' from the mip chain
+                color uv_pattern_filtered_color_at(uv_point const& uv, double uv_footprint) const override
+                {
+                        return img_->sample(uv.u(), 1.0 - uv.v(), uv_footprint);
+                }
 
-                        return ppm_img.read_pixel(x, y);
+                bool uses_footprint() const override
+                {
+                        return true;
                 }
         };
 } // namespace raytracer
\ No newline at end of file
@@ -26,6 +26,23 @@ namespace raytracer
 
             public:
                 virtual color uv_pattern_color_at(uv_point const& uv) const = 0;
+
+                /// ------------------------------------------------------------
+                /// color at 'uv' filtered over 'uv_footprint' i.e. the width
+                /// of the ray in uv-space.
+                ///
+                /// only patterns which can filter (f.e. images) need to
+                /// override this, and 'uses_footprint()'
+                virtual color uv_pattern_filtered_color_at(uv_point const& uv,
+                                                           double /* uv_footprint */) const
+                {
+                        return uv_pattern_color_at(uv);
+                }
+
+                virtual bool uses_footprint() const
+                {
+                        return false;
+                }
         };
 
 } // namespace raytracer
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <sys/stat.h>
@@ -44,6 +45,11 @@ namespace platform_utils
                 /// get size (in bytes) of mapped file
                 size_t size() const;
 
+                /// --------------------------------------------------------------------
+                /// get last modification time (in nanoseconds since epoch) of
+                /// mapped file
+                uint64_t mtime_ns() const;
+
             private:
                 /// ------------------------------------------------------------
                 /// return fd associated with opening 'file_name' for read-only
@@ -52,6 +52,12 @@ namespace platform_utils
                 return this->file_info_.st_size;
         }
 
+        uint64_t mmapped_file_reader::mtime_ns() const
+        {
+                auto const& mtime = this->file_info_.st_mtim;
+                return (static_cast<uint64_t>(mtime.tv_sec) * 1000000000ULL) + mtime.tv_nsec;
+        }
+
         /*
          * only private functions from this point onward
          **/
@@ -0,0 +1,83 @@
+#pragma once
+
+/// c++ includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace platform_utils
+{
+        /// --------------------------------------------------------------------
+        /// hardware events that are counted
+        enum perf_event_kind : uint8_t {
+                PERF_EVENT_CYCLES        = 0,
+                PERF_EVENT_INSTRUCTIONS  = 1,
+                PERF_EVENT_L1D_MISSES    = 2,
+                PERF_EVENT_LLC_MISSES    = 3,
+                PERF_EVENT_BRANCH_MISSES = 4,
+
+                PERF_EVENT_MAX,
+        };
+
+        /// --------------------------------------------------------------------
+        /// counts of each of the events
+        using perf_event_counts = std::array<uint64_t, PERF_EVENT_MAX>;
+
+        /*
+         * this class implements the interface for counting hardware events
+         * (cycles, instructions, cache and branch misses) of the calling
+         * thread, in user space.
+         *
+         * counting needs support from the platform, and the permission to use
+         * it (f.e. on linux, 'perf_event_open' with 'perf_event_paranoid' ≤
+         * 2). neither is a given, virtual machines and containers in
+         * particular often have no hardware counters at all.
+         **/
+        class perf_counters final
+        {
+            private:
+                /// ------------------------------------------------------------
+                /// platform specific state
+                struct impl;
+                std::unique_ptr<impl> impl_;
+
+            public:
+                /*
+                 * @brief
+                 *    this function is called to start counting events of the
+                 *    calling thread. events that the platform does not
+                 *    support are not counted, and read as '0'.
+                 *
+                 * @return
+                 *    'nullptr' when no event can be counted.
+                 **/
+                static std::unique_ptr<perf_counters> open_for_this_thread();
+
+                ~perf_counters();
+
+                perf_counters(perf_counters const&)            = delete;
+                perf_counters& operator=(perf_counters const&) = delete;
+
+                /*
+                 * @brief
+                 *    this function is called to read the counts of events
+                 *    since counting started. counts are scaled up when the
+                 *    platform had to share its counters with others.
+                 *
+                 * @return
+                 *    'false' when the counters cannot be read.
+                 **/
+                bool read(perf_event_counts& counts) const;
+
+                /*
+                 * @brief
+                 *    is an event being counted ?
+                 **/
+                bool counting(perf_event_kind event) const;
+
+            private:
+                explicit perf_counters(std::unique_ptr<impl> the_impl);
+        };
+
+} // namespace platform_utils
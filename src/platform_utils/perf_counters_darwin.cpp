@@ -0,0 +1,41 @@
+/*
+ * implementation of platform specific hardware event counters. this is the
+ * implementation for the darwin platform.
+ **/
+
+#include "perf_counters.hpp"
+
+/// c++ includes
+#include <memory>
+#include <utility>
+
+namespace platform_utils
+{
+        /// --------------------------------------------------------------------
+        /// hardware counters are not available to user space on darwin
+        struct perf_counters::impl final {
+        };
+
+        std::unique_ptr<perf_counters> perf_counters::open_for_this_thread()
+        {
+                return nullptr;
+        }
+
+        perf_counters::perf_counters(std::unique_ptr<impl> the_impl)
+            : impl_(std::move(the_impl))
+        {
+        }
+
+        perf_counters::~perf_counters() = default;
+
+        bool perf_counters::read(perf_event_counts&) const
+        {
+                return false;
+        }
+
+        bool perf_counters::counting(perf_event_kind) const
+        {
+                return false;
+        }
+
+} // namespace platform_utils
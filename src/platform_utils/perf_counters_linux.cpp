@@ -0,0 +1,170 @@
+/*
+ * implementation of platform specific hardware event counters. this is the
+ * implementation for the linux platform, using 'perf_event_open(2)'.
+ *
+ * events are opened as a single group, so that they are all read with a
+ * single system call, and are always counted over the same stretch of time.
+ **/
+
+#include "perf_counters.hpp"
+
+/// system includes
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// c++ includes
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/// our includes
+#include "common/include/logging.h"
+
+namespace platform_utils
+{
+        /// --------------------------------------------------------------------
+        /// there is no glibc wrapper for it
+        static int perf_event_open(struct perf_event_attr* attr, pid_t pid, int cpu, int group_fd,
+                                   unsigned long flags)
+        {
+                return syscall(SYS_perf_event_open, attr, pid, cpu, group_fd, flags);
+        }
+
+        /// --------------------------------------------------------------------
+        /// type and config of each of the events
+        struct perf_event_config final {
+                uint32_t type;
+                uint64_t config;
+        };
+
+        static constexpr std::array<perf_event_config, PERF_EVENT_MAX> PERF_EVENT_CONFIGS = {{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+
+        /// --------------------------------------------------------------------
+        /// file descriptors of the events, the first one opened leads the
+        /// group. 'slot' is the position of an event in what is read from the
+        /// group, -1 for events that are not counted.
+        struct perf_counters::impl final {
+                int leader_fd = -1;
+                std::array<int, PERF_EVENT_MAX> fds;
+                std::array<int, PERF_EVENT_MAX> slot;
+                size_t num_counting = 0;
+
+                impl()
+                {
+                        fds.fill(-1);
+                        slot.fill(-1);
+                }
+
+                ~impl()
+                {
+                        for (auto const fd : fds) {
+                                if (fd != -1) {
+                                        close(fd);
+                                }
+                        }
+                }
+        };
+
+        /// --------------------------------------------------------------------
+        /// open the events of the calling thread, on whichever cpu it runs
+        std::unique_ptr<perf_counters> perf_counters::open_for_this_thread()
+        {
+                auto the_impl = std::make_unique<impl>();
+
+                for (size_t i = 0; i < PERF_EVENT_MAX; i++) {
+                        struct perf_event_attr attr;
+                        memset(&attr, 0, sizeof(attr));
+
+                        attr.size           = sizeof(attr);
+                        attr.type           = PERF_EVENT_CONFIGS[i].type;
+                        attr.config         = PERF_EVENT_CONFIGS[i].config;
+                        attr.disabled       = (the_impl->leader_fd == -1) ? 1 : 0;
+                        attr.exclude_kernel = 1;
+                        attr.exclude_hv     = 1;
+                        attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                        auto const fd = perf_event_open(&attr, 0, -1, the_impl->leader_fd, 0);
+                        if (fd == -1) {
+                                LOG_DEBUG("perf event: %zu cannot be counted, reason: '%s'", i,
+                                          strerror(errno));
+                                continue;
+                        }
+
+                        if (the_impl->leader_fd == -1) {
+                                the_impl->leader_fd = fd;
+                        }
+
+                        the_impl->fds[i]  = fd;
+                        the_impl->slot[i] = the_impl->num_counting++;
+                }
+
+                if (the_impl->leader_fd == -1) {
+                        return nullptr;
+                }
+
+                ioctl(the_impl->leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(the_impl->leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+                return std::unique_ptr<perf_counters>(new perf_counters(std::move(the_impl)));
+        }
+
+        perf_counters::perf_counters(std::unique_ptr<impl> the_impl)
+            : impl_(std::move(the_impl))
+        {
+        }
+
+        perf_counters::~perf_counters() = default;
+
+        /// --------------------------------------------------------------------
+        /// group is read as: events-in-group, time-enabled, time-running, and
+        /// then the count of each event in the order in which they were opened
+        bool perf_counters::read(perf_event_counts& counts) const
+        {
+                std::array<uint64_t, 3 + PERF_EVENT_MAX> buf = {};
+
+                auto const bytes_read = ::read(impl_->leader_fd, buf.data(), sizeof(buf));
+                if (bytes_read < ssize_t((3 + impl_->num_counting) * sizeof(uint64_t))) {
+                        return false;
+                }
+
+                auto const time_enabled = buf[1];
+                auto const time_running = buf[2];
+
+                for (size_t i = 0; i < PERF_EVENT_MAX; i++) {
+                        auto const slot = impl_->slot[i];
+
+                        if ((slot == -1) || (time_running == 0)) {
+                                counts[i] = 0;
+                                continue;
+                        }
+
+                        counts[i] = buf[3 + slot];
+
+                        if (time_running < time_enabled) {
+                                counts[i] = uint64_t(double(counts[i]) * time_enabled / time_running);
+                        }
+                }
+
+                return true;
+        }
+
+        bool perf_counters::counting(perf_event_kind event) const
+        {
+                return (event < PERF_EVENT_MAX) && (impl_->slot[event] != -1);
+        }
+
+} // namespace platform_utils
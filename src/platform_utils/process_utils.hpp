@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace platform_utils
+{
+        /*
+         * this class implements the interface for querying platform specific
+         * properties of the running process.
+         **/
+        class process_utils final
+        {
+            private:
+                /*
+                 * nothing here :-)
+                 **/
+            public:
+                /*
+                 * @brief
+                 *    this function is called to get the peak resident set
+                 *    size (in bytes) of the process, since it started || since
+                 *    the last call to 'reset_peak_rss()'.
+                 *
+                 * @return
+                 *    '0' when it cannot be determined.
+                 **/
+                static uint64_t peak_rss_bytes();
+
+                /*
+                 * @brief
+                 *    this function is called to reset the peak resident set
+                 *    size of the process to its current resident set size.
+                 *
+                 * @return
+                 *    '0' on success.
+                 **/
+                static int reset_peak_rss();
+        };
+
+} // namespace platform_utils
@@ -0,0 +1,36 @@
+/*
+ * implementation of platform specific process utils. this is the
+ * implementation for the darwin platform.
+ **/
+
+#include "process_utils.hpp"
+
+/// system includes
+#include <sys/resource.h>
+
+/// c++ includes
+#include <cstdint>
+
+namespace platform_utils
+{
+        /// --------------------------------------------------------------------
+        /// on darwin, 'ru_maxrss' is in bytes
+        uint64_t process_utils::peak_rss_bytes()
+        {
+                struct rusage usage;
+
+                if (getrusage(RUSAGE_SELF, &usage) != 0) {
+                        return 0;
+                }
+
+                return usage.ru_maxrss;
+        }
+
+        /// --------------------------------------------------------------------
+        /// the peak cannot be reset on darwin
+        int process_utils::reset_peak_rss()
+        {
+                return -1;
+        }
+
+} // namespace platform_utils
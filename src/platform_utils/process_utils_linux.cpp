@@ -0,0 +1,59 @@
+/*
+ * implementation of platform specific process utils. this is the
+ * implementation for the linux platform.
+ **/
+
+#include "process_utils.hpp"
+
+/// system includes
+#include <stdio.h>
+#include <string.h>
+
+/// c++ includes
+#include <cstdint>
+
+namespace platform_utils
+{
+        /// --------------------------------------------------------------------
+        /// the 'VmHWM' (high water mark) field of '/proc/self/status' is the
+        /// peak resident set size in kB.
+        uint64_t process_utils::peak_rss_bytes()
+        {
+                FILE* status_file = fopen("/proc/self/status", "r");
+                if (status_file == nullptr) {
+                        return 0;
+                }
+
+                char line[256];
+                uint64_t peak_kb = 0;
+
+                while (fgets(line, sizeof(line), status_file) != nullptr) {
+                        unsigned long long kb = 0;
+
+                        if (sscanf(line, "VmHWM: %llu kB", &kb) == 1) {
+                                peak_kb = kb;
+                                break;
+                        }
+                }
+
+                fclose(status_file);
+
+                return peak_kb * 1024;
+        }
+
+        /// --------------------------------------------------------------------
+        /// writing '5' to '/proc/self/clear_refs' resets the high water mark
+        int process_utils::reset_peak_rss()
+        {
+                FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+                if (clear_refs == nullptr) {
+                        return -1;
+                }
+
+                auto const retval = (fputs("5", clear_refs) < 0) ? -1 : 0;
+                fclose(clear_refs);
+
+                return retval;
+        }
+
+} // namespace platform_utils
@@ -21,6 +21,12 @@ namespace raytracer
             , normal_vec_(create_vector(0.0, 0.0, 0.0))
             , reflect_vec_(create_vector(0.0, 0.0, 0.0))
             , object_(nullptr)
+            , object_position_(create_point(0.0, 0.0, 0.0))
+            , object_normal_(create_vector(0.0, 0.0, 0.0))
+            , object_over_position_(create_point(0.0, 0.0, 0.0))
+            , uv_u_(0.0)
+            , uv_v_(0.0)
+            , uv_texture_(nullptr)
         {
         }
 
@@ -57,6 +63,7 @@ namespace raytracer
         intersection_info_t& intersection_info_t::over_position(tuple val)
         {
                 over_position_ = val;
+                uv_texture_    = nullptr;
                 return *this;
         }
 
@@ -86,7 +93,27 @@ namespace raytracer
 
         intersection_info_t& intersection_info_t::what_object(std::shared_ptr<shape_interface const> val)
         {
-                object_ = val;
+                object_     = val;
+                uv_texture_ = nullptr;
+                return *this;
+        }
+
+        intersection_info_t& intersection_info_t::object_position(tuple val)
+        {
+                object_position_ = val;
+                return *this;
+        }
+
+        intersection_info_t& intersection_info_t::object_normal(tuple val)
+        {
+                object_normal_ = val;
+                return *this;
+        }
+
+        intersection_info_t& intersection_info_t::object_over_position(tuple val)
+        {
+                object_over_position_ = val;
+                uv_texture_           = nullptr;
                 return *this;
         }
 
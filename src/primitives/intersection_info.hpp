@@ -4,10 +4,12 @@
 
 /// our includes
 #include "primitives/tuple.hpp"
+#include "primitives/uv_point.hpp"
 
 namespace raytracer
 {
         /// forward declaration
+        class pattern_interface;
         class shape_interface;
 
         /// --------------------------------------------------------------------
@@ -57,6 +59,25 @@ namespace raytracer
                 /// the shape that was intersected
                 std::shared_ptr<shape_interface const> object_;
 
+                /// ------------------------------------------------------------
+                /// where the intersection happens, and the (outward) normal
+                /// there, in object-space
+                tuple object_position_;
+                tuple object_normal_;
+
+                /// ------------------------------------------------------------
+                /// the over-position in object-space, which is where patterns
+                /// are looked up. this is 'object_position_' moved epsilon
+                /// along the object-space normal.
+                tuple object_over_position_;
+
+                /// ------------------------------------------------------------
+                /// uv-coordinates of the hit on the texture that asked for
+                /// them first, none when 'uv_texture_' is nullptr
+                mutable double uv_u_;
+                mutable double uv_v_;
+                mutable pattern_interface const* uv_texture_;
+
             public:
                 intersection_info_t();
 
@@ -71,6 +92,9 @@ namespace raytracer
                 intersection_info_t& normal_vector(tuple val);
                 intersection_info_t& reflection_vector(tuple val);
                 intersection_info_t& what_object(std::shared_ptr<shape_interface const> val);
+                intersection_info_t& object_position(tuple val);
+                intersection_info_t& object_normal(tuple val);
+                intersection_info_t& object_over_position(tuple val);
 
             public:
                 float schlick_approx() const;
@@ -130,5 +154,37 @@ namespace raytracer
                 {
                         return object_;
                 }
+
+                tuple object_position() const
+                {
+                        return object_position_;
+                }
+
+                tuple object_normal() const
+                {
+                        return object_normal_;
+                }
+
+                tuple const& object_over_position() const
+                {
+                        return object_over_position_;
+                }
+
+                /// ------------------------------------------------------------
+                /// uv-coordinates of the hit on 'texture', mapped by
+                /// 'map_uv()' only when they are not known already
+                template <typename MAP_UV>
+                uv_point uv(pattern_interface const* texture, MAP_UV const& map_uv) const
+                {
+                        if (uv_texture_ != texture) {
+                                auto const uv_pt = map_uv();
+
+                                uv_u_       = uv_pt.u();
+                                uv_v_       = uv_pt.v();
+                                uv_texture_ = texture;
+                        }
+
+                        return uv_point(uv_u_, uv_v_);
+                }
         };
 } // namespace raytracer
@@ -62,7 +62,7 @@ namespace raytracer
         /// intersection-record from the list of _sorted_ intersection records
         std::optional<intersection_record> visible_intersection(intersection_records const& ixns_list)
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 uint32_t idx = 0;
 
@@ -173,7 +173,7 @@ namespace raytracer
         /// another.
         fsize_dense2d_matrix_t& fsize_dense2d_matrix_t::operator*=(fsize_dense2d_matrix_t const& rhs)
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 fsize_dense2d_matrix_t lhs(this->num_rows(), rhs.num_cols());
 
@@ -257,7 +257,7 @@ namespace raytracer
         /// this function is called to multiply a matrix by a tuple.
         tuple operator*(fsize_dense2d_matrix_t const& M, tuple const& N)
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 /// ------------------------------------------------------------
                 /// an 'unrolled' specialization can be used i.e. no
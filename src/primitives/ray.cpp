@@ -75,7 +75,7 @@ namespace raytracer
         std::optional<intersection_records>
         ray_t::intersect(std::shared_ptr<shape_interface const> const& S) const
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 return S->intersect({}, this->transform(S->inv_transform()));
         }
@@ -86,7 +86,7 @@ namespace raytracer
         intersection_info_t ray_t::prepare_computations(intersection_records const& xs_data,
                                                         size_t index) const
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 intersection_info_t retval;
                 auto const& current_xs = xs_data[index];
@@ -98,8 +98,15 @@ namespace raytracer
                         .eye_vector(-direction());
 
                 /// ------------------------------------------------------------
-                /// compute normal at intersection
-                auto normal_at_xs = current_xs.what_object()->normal_at(retval.position(), current_xs);
+                /// compute normal at intersection, in object-space first. both
+                /// go along with the rest, so that patterns don't have to
+                /// map the hit to object-space again.
+                auto const xs_obj     = current_xs.what_object();
+                auto const obj_pt     = xs_obj->world_to_local(retval.position());
+                auto const obj_normal = xs_obj->normal_at_local(obj_pt, current_xs);
+                auto normal_at_xs     = xs_obj->normal_at_world(obj_normal);
+
+                retval.object_position(obj_pt).object_normal(obj_normal);
 
                 /// intersection is inside or outside ?
                 if (raytracer::dot(normal_at_xs, retval.eye_vector()) < 0) {
@@ -115,6 +122,12 @@ namespace raytracer
                 auto under_point = retval.position() - retval.normal_vector() * EPSILON;
                 retval.over_position(std::move(over_point)).under_position(std::move(under_point));
 
+                /// ------------------------------------------------------------
+                /// and the over-point in object-space, along the object-space
+                /// normal, for patterns
+                auto const obj_over_dir = normalize(retval.inside() ? -obj_normal : obj_normal);
+                retval.object_over_position(obj_pt + obj_over_dir * EPSILON);
+
                 /// ------------------------------------------------------------
                 /// compute reflection vector
                 auto refl_vec = reflect(this->direction(), retval.normal_vector());
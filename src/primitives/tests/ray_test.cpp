@@ -133,3 +133,25 @@ TEST_CASE("ray::prepare_computations(...) test")
         CHECK(comps.over_position().z() < -RT::EPSILON / 2.0);
         CHECK(comps.position().z() > comps.over_position().z());
 }
+
+/// ----------------------------------------------------------------------------
+/// object-space point and normal of the hit are kept, alongside their world
+/// space counterparts
+TEST_CASE("ray::prepare_computations(...) object space test")
+{
+        auto const r = RT::ray_t(RT::create_point(1.0, 0.0, -5.0), RT::create_vector(0.0, 0.0, 1.0));
+
+        auto the_sphere = std::make_shared<RT::sphere>();
+        the_sphere->transform(RT::matrix_transformations_t::create_3d_translation_matrix(1.0, 0.0, 0.0));
+
+        auto const xs_01   = RT::intersection_record(4.0, the_sphere);
+        auto const xs_list = RT::intersection_records{xs_01};
+
+        auto const comps = r.prepare_computations(xs_list);
+
+        CHECK(comps.position() == RT::create_point(1.0, 0.0, -1.0));
+        CHECK(comps.object_position() == RT::create_point(0.0, 0.0, -1.0));
+        CHECK(comps.object_normal() == RT::create_vector(0.0, 0.0, -1.0));
+        CHECK(comps.normal_vector() == RT::create_vector(0.0, 0.0, -1.0));
+        CHECK(comps.object_over_position() == RT::create_point(0.0, 0.0, -1.0 - RT::EPSILON));
+}
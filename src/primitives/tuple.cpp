@@ -111,7 +111,7 @@ namespace raytracer
         /// around the normal vector 'N'
         tuple reflect(tuple in, tuple N)
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 ASSERT(in.is_vector() && N.is_vector());
                 return in - N * 2 * dot(in, N);
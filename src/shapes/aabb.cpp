@@ -11,6 +11,7 @@
 /// our includes
 #include "primitives/matrix.hpp"
 #include "primitives/ray.hpp"
+#include "utils/render_counters.hpp"
 
 namespace raytracer
 {
@@ -120,6 +121,8 @@ namespace raytracer
         /// a predicate to compute if a ray intersects a bounding box
         bool aabb::intersects(ray_t const& R) const
         {
+                render_counters::this_thread().box_tests += 1;
+
                 auto const [x_tmin, x_tmax] =
                         check_axes_(R.origin().x(), R.direction().x(), min_.x(), max_.x());
 
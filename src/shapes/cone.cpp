@@ -18,6 +18,7 @@
 #include "shapes/aabb.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
 #include "utils/utils.hpp"
 
 namespace raytracer
@@ -178,6 +179,8 @@ namespace raytracer
         /// actual workhorse for computing ray-cone intersections
         std::optional<intersection_records> cone::compute_intersections_(ray_t const& R) const
         {
+                render_counters::this_thread().primitive_tests += 1;
+
                 intersection_records retval;
 
                 /// ------------------------------------------------------------
@@ -184,6 +184,25 @@ namespace raytracer
                 r_shape->divide(threshold);
         }
 
+        /// --------------------------------------------------------------------
+        /// both shapes are frozen after the csg_shape, so that they can use its
+        /// baked transforms
+        void csg_shape::freeze_world_transforms()
+        {
+                shape_interface::freeze_world_transforms();
+
+                l_shape->freeze_world_transforms();
+                r_shape->freeze_world_transforms();
+        }
+
+        void csg_shape::thaw_world_transforms()
+        {
+                shape_interface::thaw_world_transforms();
+
+                l_shape->thaw_world_transforms();
+                r_shape->thaw_world_transforms();
+        }
+
         /// --------------------------------------------------------------------
         /// does this shape include the other ? returns 'true' if it does,
         /// 'false' otherwise.
@@ -194,6 +194,12 @@ namespace raytracer
                 /// divide a 'csg' shape
                 void divide(size_t threshold) override;
 
+                /// ------------------------------------------------------------
+                /// bake || forget world-space transforms of the csg_shape, and
+                /// both of its shapes
+                void freeze_world_transforms() override;
+                void thaw_world_transforms() override;
+
                 /// ------------------------------------------------------------
                 /// does this shape include the other shape ? for instances of
                 /// this class, we want this redefined method to be invoked.
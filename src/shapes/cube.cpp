@@ -16,6 +16,7 @@
 #include "shapes/aabb.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
 
 namespace raytracer
 {
@@ -107,6 +108,8 @@ namespace raytracer
         /// actual workhorse for computing ray-cube intersections
         std::optional<intersection_records> cube::compute_intersections_(ray_t const& R) const
         {
+                render_counters::this_thread().primitive_tests += 1;
+
                 auto const [x_tmin, x_tmax] = check_axes_(R.origin().x(), R.direction().x());
                 auto const [y_tmin, y_tmax] = check_axes_(R.origin().y(), R.direction().y());
                 auto const [z_tmin, z_tmax] = check_axes_(R.origin().z(), R.direction().z());
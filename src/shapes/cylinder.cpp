@@ -17,6 +17,7 @@
 #include "shapes/aabb.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
 #include "utils/utils.hpp"
 
 namespace raytracer
@@ -121,6 +122,8 @@ namespace raytracer
         /// compute intersection of a ray with the cylinder
         std::optional<intersection_records> cylinder::compute_intersections_(ray_t const& R) const
         {
+                render_counters::this_thread().primitive_tests += 1;
+
                 intersection_records retval;
 
                 /// ------------------------------------------------------------
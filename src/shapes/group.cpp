@@ -24,6 +24,7 @@
 #include "shapes/shape_interface.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/execution_profiler.hpp"
 #include <utility>
 
 namespace raytracer
@@ -211,6 +212,8 @@ namespace raytracer
         /// group is 'chopped' up.
         void group::divide(size_t threshold)
         {
+                PROFILE_SCOPE;
+
                 if (child_shapes_.size() > threshold) {
                         auto [left, right] = partition_children();
 
@@ -230,6 +233,27 @@ namespace raytracer
                 }
         }
 
+        /// --------------------------------------------------------------------
+        /// children are frozen after the group, so that they can use its baked
+        /// transforms
+        void group::freeze_world_transforms()
+        {
+                shape_interface::freeze_world_transforms();
+
+                for (auto const& cs_i : child_shapes_) {
+                        cs_i->freeze_world_transforms();
+                }
+        }
+
+        void group::thaw_world_transforms()
+        {
+                shape_interface::thaw_world_transforms();
+
+                for (auto const& cs_i : child_shapes_) {
+                        cs_i->thaw_world_transforms();
+                }
+        }
+
         /// --------------------------------------------------------------------
         /// create a sub-group from a list of children.
         void group::make_subgroup(std::vector<std::shared_ptr<shape_interface>> shape_list)
@@ -73,6 +73,12 @@ namespace raytracer
                 /// 'divide' a group
                 void divide(size_t threshold) override;
 
+                /// ------------------------------------------------------------
+                /// bake || forget world-space transforms of the group, and
+                /// all of its children
+                void freeze_world_transforms() override;
+                void thaw_world_transforms() override;
+
                 /// is the group empty ? i.e contains no child shapes
                 bool is_empty() const;
 
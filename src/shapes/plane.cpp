@@ -16,6 +16,7 @@
 #include "shapes/aabb.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
 
 namespace raytracer
 {
@@ -94,6 +95,8 @@ namespace raytracer
         /// actual workhorse for computing ray-plane intersections
         std::optional<intersection_records> plane::compute_intersections_(ray_t const& R) const
         {
+                render_counters::this_thread().primitive_tests += 1;
+
                 auto const ray_y_dir = R.direction().y();
 
                 if (std::abs(ray_y_dir) < EPSILON) {
@@ -1,5 +1,9 @@
 #include "shapes/shape_interface.hpp"
 
+/// c++ includes
+#include <memory>
+#include <utility>
+
 /// our includes
 #include "primitives/tuple.hpp"
 #include "shapes/aabb.hpp"
@@ -13,6 +17,7 @@ namespace raytracer
             , inv_xform_transpose_(fsize_dense2d_matrix_t::create_identity_matrix(4))
             , material_()
             , parent_({})
+            , world_xforms_(nullptr)
         {
         }
 
@@ -37,9 +42,59 @@ namespace raytracer
                 this->inv_xform_           = inverse(M);
                 this->inv_xform_transpose_ = this->inv_xform_.transpose();
 
+                thaw_world_transforms();
+
                 return;
         }
 
+        /// --------------------------------------------------------------------
+        /// this function is called to bake the transform from world-space to
+        /// object-space. it is the product of inverse transforms of the shape,
+        /// and each of its ancestors, up to the first one that is already
+        /// frozen.
+        void shape_interface::freeze_world_transforms()
+        {
+                static auto const IDENTITY = fsize_dense2d_matrix_t::create_identity_matrix(4);
+
+                auto const parent_sp = this->parent_.lock();
+
+                if ((parent_sp != nullptr) && (parent_sp->world_xforms_ != nullptr) &&
+                    (this->inv_xform_ == IDENTITY)) {
+                        this->world_xforms_ = parent_sp->world_xforms_;
+                        return;
+                }
+
+                auto inv_xform = this->inv_xform_;
+
+                for (auto ancestor = parent_sp; ancestor != nullptr; ancestor = ancestor->parent_.lock()) {
+                        if (ancestor->world_xforms_ != nullptr) {
+                                inv_xform *= ancestor->world_xforms_->inv_xform;
+                                break;
+                        }
+
+                        inv_xform *= ancestor->inv_xform_;
+                }
+
+                auto inv_xform_transpose = inv_xform.transpose();
+                this->world_xforms_      = std::make_shared<world_transforms const>(
+                        world_transforms{std::move(inv_xform), std::move(inv_xform_transpose)});
+        }
+
+        /// --------------------------------------------------------------------
+        /// this function is called to forget the baked transforms, when they
+        /// are stale
+        void shape_interface::thaw_world_transforms()
+        {
+                this->world_xforms_ = nullptr;
+        }
+
+        /// --------------------------------------------------------------------
+        /// are the world-space transforms of this shape baked ?
+        bool shape_interface::world_transforms_frozen() const
+        {
+                return this->world_xforms_ != nullptr;
+        }
+
         /// --------------------------------------------------------------------
         /// this function is called to find the normal on a child object of a
         /// group.
@@ -55,6 +110,10 @@ namespace raytracer
         /// specific point on the shape.
         tuple shape_interface::world_to_local(tuple const& world_pt) const
         {
+                if (this->world_xforms_ != nullptr) {
+                        return this->world_xforms_->inv_xform * world_pt;
+                }
+
                 auto local_pt = world_pt;
 
                 if (auto parent_sp = this->parent_.lock()) {
@@ -70,6 +129,15 @@ namespace raytracer
         /// the shape. 'point' is in world-space coordinates
         tuple shape_interface::normal_at_world(tuple const& world_pt) const
         {
+                /// ------------------------------------------------------------
+                /// baked transforms go all the way to world-space in one step
+                if (this->world_xforms_ != nullptr) {
+                        auto world_normal = this->world_xforms_->inv_xform_transpose * world_pt;
+                        world_normal.vectorify();
+
+                        return normalize(world_normal);
+                }
+
                 /// first convert the world-point to object space, and determine
                 /// the normal there
                 auto obj_space_normal = this->inv_transform_transpose() * world_pt;
@@ -111,6 +179,7 @@ namespace raytracer
         void shape_interface::set_parent(std::shared_ptr<shape_interface> new_parent)
         {
                 parent_ = new_parent;
+                thaw_world_transforms();
         }
 
         /// --------------------------------------------------------------------
@@ -50,6 +50,18 @@ namespace raytracer
                 /// the parent of this shape.
                 std::weak_ptr<shape_interface const> parent_;
 
+                /// ------------------------------------------------------------
+                /// transforms from world-space to object-space, through all the
+                /// ancestors of the shape. these are baked by
+                /// 'freeze_world_transforms()', and shared with children that
+                /// have no transform of their own f.e. triangles of a mesh.
+                struct world_transforms final {
+                        fsize_dense2d_matrix_t inv_xform;
+                        fsize_dense2d_matrix_t inv_xform_transpose;
+                };
+
+                std::shared_ptr<world_transforms const> world_xforms_;
+
             protected:
                 /// ------------------------------------------------------------
                 /// don't allow deletion through a base
@@ -94,6 +106,18 @@ namespace raytracer
                 /// the shape.
                 virtual aabb bounds_of() const = 0;
 
+                /// ------------------------------------------------------------
+                /// bake the transforms from world-space to the space of this
+                /// shape, and of the shapes that it contains, so that
+                /// 'world_to_local' and 'normal_at_world' don't walk the chain
+                /// of parents at every call.
+                ///
+                /// changing the transform || the parent of a shape thaws it,
+                /// and the shapes that it contains, which then walk the chain
+                /// again till frozen once more.
+                virtual void freeze_world_transforms();
+                virtual void thaw_world_transforms();
+
                 /// ------------------------------------------------------------
                 /// divide (child shapes in) a composite shape based on the
                 /// 'threshold'.
@@ -140,6 +164,10 @@ namespace raytracer
                 /// convert world-space coordinates into local
                 tuple world_to_local(tuple const&) const;
 
+                /// ------------------------------------------------------------
+                /// are the world-space transforms of this shape baked ?
+                bool world_transforms_frozen() const;
+
                 /// ------------------------------------------------------------
                 /// adjust material properties of a shape
                 material get_material() const;
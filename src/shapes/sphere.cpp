@@ -19,6 +19,7 @@
 #include "shapes/aabb.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
 #include "utils/utils.hpp"
 
 namespace raytracer
@@ -117,6 +118,8 @@ namespace raytracer
         /// intersection points.
         std::optional<intersection_records> sphere::compute_intersections_(ray_t const& R) const
         {
+                render_counters::this_thread().primitive_tests += 1;
+
                 /// vector from sphere's center to the ray-origin
                 auto const sphere_to_ray = R.origin() - this->center();
                 auto const ray_dir       = R.direction();
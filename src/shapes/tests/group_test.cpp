@@ -307,3 +307,76 @@ TEST_CASE("Subdividing a group partitions its children")
         CHECK(sg_sg_2_child_shapes.size() == 1);
         CHECK(g_1_sg_sg_2->includes(s_2) == true);
 }
+
+TEST_CASE("frozen world transforms agree with walking the chain of parents")
+{
+        auto g_1 = std::make_shared<RT::group>();
+        g_1->transform(RT::matrix_transformations_t::create_roty_matrix(RT::PI_BY_2F));
+
+        auto g_2 = std::make_shared<RT::group>();
+        g_2->transform(RT::matrix_transformations_t::create_3d_scaling_matrix(1.0, 2.0, 3.0));
+
+        g_1->add_child(g_2);
+
+        auto g_2_s_1 = std::make_shared<RT::sphere>();
+        g_2_s_1->transform(RT::matrix_transformations_t::create_3d_translation_matrix(5.0, 0.0, 0.0));
+        g_2->add_child(g_2_s_1);
+
+        auto g_2_s_2 = std::make_shared<RT::sphere>();
+        g_2->add_child(g_2_s_2);
+
+        auto const pt_xyz     = RT::SQRT_3_BY_3F;
+        auto const world_pt   = RT::create_point(1.7320, 1.1547, -5.5774);
+        auto const obj_normal = RT::create_vector(pt_xyz, pt_xyz, pt_xyz);
+
+        auto const exp_pt_1     = g_2_s_1->world_to_local(world_pt);
+        auto const exp_normal_1 = g_2_s_1->normal_at_world(obj_normal);
+        auto const exp_pt_2     = g_2_s_2->world_to_local(world_pt);
+        auto const exp_normal_2 = g_2_s_2->normal_at_world(obj_normal);
+
+        CHECK(g_2_s_1->world_transforms_frozen() == false);
+
+        g_1->freeze_world_transforms();
+
+        CHECK(g_1->world_transforms_frozen() == true);
+        CHECK(g_2->world_transforms_frozen() == true);
+        CHECK(g_2_s_1->world_transforms_frozen() == true);
+        CHECK(g_2_s_2->world_transforms_frozen() == true);
+
+        CHECK(g_2_s_1->world_to_local(world_pt) == exp_pt_1);
+        CHECK(g_2_s_1->normal_at_world(obj_normal) == exp_normal_1);
+        CHECK(g_2_s_2->world_to_local(world_pt) == exp_pt_2);
+        CHECK(g_2_s_2->normal_at_world(obj_normal) == exp_normal_2);
+
+        CHECK(g_2_s_1->normal_at_world(obj_normal) == RT::create_vector(0.285714, 0.428571, -0.857143));
+}
+
+TEST_CASE("changing the transform of a group thaws its children")
+{
+        auto g_1 = std::make_shared<RT::group>();
+
+        auto g_1_s_1 = std::make_shared<RT::sphere>();
+        g_1_s_1->transform(RT::matrix_transformations_t::create_3d_translation_matrix(5.0, 0.0, 0.0));
+        g_1->add_child(g_1_s_1);
+
+        g_1->freeze_world_transforms();
+        CHECK(g_1_s_1->world_to_local(RT::create_point(5.0, 0.0, 0.0)) == RT::create_point(0.0, 0.0, 0.0));
+
+        /// --------------------------------------------------------------------
+        /// stale transforms are not used
+        g_1->transform(RT::matrix_transformations_t::create_3d_translation_matrix(0.0, 2.0, 0.0));
+
+        CHECK(g_1->world_transforms_frozen() == false);
+        CHECK(g_1_s_1->world_transforms_frozen() == false);
+        CHECK(g_1_s_1->world_to_local(RT::create_point(5.0, 2.0, 0.0)) == RT::create_point(0.0, 0.0, 0.0));
+
+        /// --------------------------------------------------------------------
+        /// ... and neither are those of a child that moves to another group
+        g_1->freeze_world_transforms();
+
+        auto g_2 = std::make_shared<RT::group>();
+        g_2->add_child(g_1_s_1);
+
+        CHECK(g_1_s_1->world_transforms_frozen() == false);
+        CHECK(g_1_s_1->world_to_local(RT::create_point(5.0, 0.0, 0.0)) == RT::create_point(0.0, 0.0, 0.0));
+}
@@ -19,6 +19,7 @@
 #include "shapes/aabb.hpp"
 #include "utils/badge.hpp"
 #include "utils/constants.hpp"
+#include "utils/render_counters.hpp"
 
 namespace raytracer
 {
@@ -189,6 +190,8 @@ namespace raytracer
         /// is coming from. for now we just provide trivial comments.
         std::optional<intersection_records> triangle::compute_intersections_(ray_t const& R) const
         {
+                render_counters::this_thread().primitive_tests += 1;
+
                 /// get a vector orthogonal to both 'R' and edge e2
                 auto const ray_dir_cross_e2 = cross(R.direction(), e2());
 
@@ -0,0 +1,40 @@
+#pragma once
+
+/*
+ * this file implements a cheap, fine grained, monotonic counter for measuring
+ * short stretches of work, f.e. rendering a single pixel.
+ *
+ * on x86 this is the time-stamp counter, and on aarch64 the virtual counter
+ * of the generic timer. neither counts actual core cycles, they tick at a
+ * constant rate, which is just what is needed for comparing costs of pixels
+ * rendered by different threads. everywhere else, nanoseconds of a steady
+ * clock are used.
+ **/
+
+/// c++ includes
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// current value of the counter
+        inline uint64_t read_cycle_counter()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+                return __rdtsc();
+#elif defined(__aarch64__)
+                uint64_t ticks = 0;
+                asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+                return ticks;
+#else
+                auto const now = std::chrono::steady_clock::now().time_since_epoch();
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+#endif
+        }
+
+} // namespace raytracer
@@ -3,16 +3,53 @@
 /*
  * just defines trivial wrappers for commonly used tracy profiler annoation
  * macros.
+ *
+ * 'TRACY_ENABLE' is defined for targets augmented with the profiler (see
+ * 'augment_execution_profiling' in the top-level CMakeLists.txt), everywhere
+ * else these expand to nothing.
  **/
 
-#ifdef ENABLE_EXECUTION_PROFILING
+#ifdef TRACY_ENABLE
 
-#include "3rd-party/tracy/Tracy.hpp"
+/// c++ includes
+#include <cstdint>
 
+#include "tracy/Tracy.hpp"
+
+/// ----------------------------------------------------------------------------
+/// zone of the enclosing function || of an explicitly named scope
 #define PROFILE_SCOPE ZoneScopedN(__PRETTY_FUNCTION__)
+#define PROFILE_SCOPE_NAMED(name) ZoneScopedN(name)
+
+/// ----------------------------------------------------------------------------
+/// functions called once || more per ray are far too frequent for a zone per
+/// call. only one of every 'PROFILE_SAMPLE_PERIOD' calls (per thread) gets a
+/// zone instead.
+#define PROFILE_SAMPLE_PERIOD 1024
+
+#define PROFILE_SCOPE_SAMPLED                                                                                \
+        static thread_local uint32_t rt_profile_calls_ = 0;                                                  \
+        ZoneNamedN(rt_profile_zone_, __PRETTY_FUNCTION__, (rt_profile_calls_++ % PROFILE_SAMPLE_PERIOD) == 0)
+
+/// ----------------------------------------------------------------------------
+/// frames i.e. renders. 'name' must be a string literal, the same one for the
+/// start and the end of a frame.
+#define PROFILE_FRAME_START(name) FrameMarkStart(name)
+#define PROFILE_FRAME_END(name) FrameMarkEnd(name)
+
+/// ----------------------------------------------------------------------------
+/// plot a value over time, and name the calling thread
+#define PROFILE_PLOT(name, value) TracyPlot(name, static_cast<int64_t>(value))
+#define PROFILE_THREAD_NAME(name) tracy::SetThreadName(name)
 
 #else
 
 #define PROFILE_SCOPE
+#define PROFILE_SCOPE_NAMED(name)
+#define PROFILE_SCOPE_SAMPLED
+#define PROFILE_FRAME_START(name)
+#define PROFILE_FRAME_END(name)
+#define PROFILE_PLOT(name, value)
+#define PROFILE_THREAD_NAME(name)
 
 #endif
@@ -0,0 +1,109 @@
+#pragma once
+
+/*
+ * this file implements counters of the work done while rendering i.e. rays
+ * cast, intersection tests performed etc.
+ *
+ * counters are per-thread, so that updating them is just an increment, and
+ * they live here, rather than with the rest of the rendering statistics (see
+ * 'io/render_stats.hpp'), so that shapes can update them as well. rendering
+ * threads reset their counters when they start, and hand them over to the
+ * camera when they are done.
+ **/
+
+/// c++ includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// our includes
+#include "platform_utils/perf_counters.hpp"
+
+namespace raytracer
+{
+        /// --------------------------------------------------------------------
+        /// phases of rendering that hardware events are attributed to, see
+        /// 'io/render_perf_counters.hpp' for details.
+        enum render_phase : uint8_t {
+                RENDER_PHASE_WORK_GENERATION = 0,
+                RENDER_PHASE_TRAVERSAL       = 1,
+                RENDER_PHASE_SHADING         = 2,
+                RENDER_PHASE_ANTIALIASING    = 3,
+                RENDER_PHASE_OUTPUT          = 4,
+                RENDER_PHASE_OTHER           = 5,
+
+                RENDER_PHASE_MAX,
+        };
+
+        struct render_counters final {
+                /// ------------------------------------------------------------
+                /// depths of antialiasing subdivision which are tracked. deeper
+                /// subdivisions are counted at the deepest tracked depth.
+                static constexpr size_t MAX_AA_DEPTH = 8;
+
+                /// ------------------------------------------------------------
+                /// rays cast into the world, by kind
+                uint64_t primary_rays   = 0;
+                uint64_t shadow_rays    = 0;
+                uint64_t reflected_rays = 0;
+                uint64_t refracted_rays = 0;
+
+                /// ------------------------------------------------------------
+                /// intersection tests, by kind. box tests are against bounding
+                /// boxes of groups and csg-shapes, and primitive tests against
+                /// spheres, planes, cubes, cylinders, cones and triangles.
+                uint64_t box_tests       = 0;
+                uint64_t primitive_tests = 0;
+
+                /// ------------------------------------------------------------
+                /// number of (sub-)pixels sampled by adaptive antialiasing, at
+                /// each depth of subdivision. depth 0 is the whole pixel. each
+                /// sample is 5 rays, except at the deepest subdivision, where
+                /// it is a single ray.
+                std::array<uint64_t, MAX_AA_DEPTH> aa_samples = {};
+
+                /// ------------------------------------------------------------
+                /// hardware events (cycles, instructions, cache and branch
+                /// misses) of each phase of rendering. these are only counted
+                /// when asked for, and when the platform can count them.
+                std::array<platform_utils::perf_event_counts, RENDER_PHASE_MAX> phase_events = {};
+
+                /// ------------------------------------------------------------
+                /// rays of all kinds
+                uint64_t rays() const
+                {
+                        return primary_rays + shadow_rays + reflected_rays + refracted_rays;
+                }
+
+                render_counters& operator+=(render_counters const& other)
+                {
+                        primary_rays += other.primary_rays;
+                        shadow_rays += other.shadow_rays;
+                        reflected_rays += other.reflected_rays;
+                        refracted_rays += other.refracted_rays;
+                        box_tests += other.box_tests;
+                        primitive_tests += other.primitive_tests;
+
+                        for (size_t i = 0; i < MAX_AA_DEPTH; i++) {
+                                aa_samples[i] += other.aa_samples[i];
+                        }
+
+                        for (size_t p = 0; p < RENDER_PHASE_MAX; p++) {
+                                for (size_t e = 0; e < platform_utils::PERF_EVENT_MAX; e++) {
+                                        phase_events[p][e] += other.phase_events[p][e];
+                                }
+                        }
+
+                        return *this;
+                }
+
+                /// ------------------------------------------------------------
+                /// counters of the calling thread
+                static render_counters& this_thread()
+                {
+                        static thread_local render_counters counters;
+                        return counters;
+                }
+        };
+
+} // namespace raytracer
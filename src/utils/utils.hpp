@@ -130,7 +130,7 @@ namespace raytracer
         inline std::optional<std::pair<double const, double const>> const
         quadratic_real_roots(double A, double B, double C)
         {
-                PROFILE_SCOPE;
+                PROFILE_SCOPE_SAMPLED;
 
                 auto const discriminant = B * B - 4.0 * A * C;
 